@@ -19,9 +19,15 @@
  *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
  *  SOFTWARE.
  */
+#include <string>
+#include <vector>
+
 #include "benchmark/benchmark.h"
 
 #include "common/statistics/AtomicStatistics.hpp"
+#include "common/statistics/HdrHistogram.hpp"
+#include "common/statistics/LatencyStatistics.hpp"
+#include "common/statistics/TopKSketch.hpp"
 
 enum AtimicStatType : int {
     ATIMIC_STAT_TEST,
@@ -38,4 +44,78 @@ static void BM_atomic_stat(benchmark::State &state) {
 }
 BENCHMARK(BM_atomic_stat)->Threads(1)->Threads(2)->Threads(4)->Threads(8)->Threads(16);
 
+// Latencies spread over 1us..64ms, so every call lands in a different bucket
+static uint64_t nextLatency(uint64_t &seed) {
+    seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    return (seed >> 33) & ((1ULL << 26) - 1);
+}
+
+static void BM_latency_metric_record(benchmark::State &state) {
+    tair::common::LatencyMetric metric;
+    uint64_t seed = 1;
+    for (auto _ : state) {
+        metric.addSample(nextLatency(seed));
+        benchmark::DoNotOptimize(metric);
+    }
+}
+BENCHMARK(BM_latency_metric_record);
+
+static void BM_hdr_single_writer_record(benchmark::State &state) {
+    tair::common::HdrHistogram histogram;
+    uint64_t seed = 1;
+    for (auto _ : state) {
+        histogram.recordSingleWriter(nextLatency(seed));
+        benchmark::DoNotOptimize(histogram);
+    }
+}
+BENCHMARK(BM_hdr_single_writer_record);
+
+static tair::common::HdrHistogram shared_histogram;
+
+static void BM_hdr_shared_record(benchmark::State &state) {
+    uint64_t seed = state.thread_index() + 1;
+    for (auto _ : state) {
+        shared_histogram.record(nextLatency(seed));
+    }
+}
+BENCHMARK(BM_hdr_shared_record)->Threads(1)->Threads(2)->Threads(4)->Threads(8)->Threads(16);
+
+static tair::common::ThreadLocalHdrHistogram thread_local_histogram;
+
+static void BM_hdr_thread_local_record(benchmark::State &state) {
+    uint64_t seed = state.thread_index() + 1;
+    for (auto _ : state) {
+        thread_local_histogram.record(nextLatency(seed));
+    }
+}
+BENCHMARK(BM_hdr_thread_local_record)->Threads(1)->Threads(2)->Threads(4)->Threads(8)->Threads(16);
+
+static void BM_hdr_percentile(benchmark::State &state) {
+    tair::common::HdrHistogram histogram;
+    uint64_t seed = 1;
+    for (int i = 0; i < 1000000; ++i) {
+        histogram.recordSingleWriter(nextLatency(seed));
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(histogram.getValueAtPercentile(99.9));
+    }
+}
+BENCHMARK(BM_hdr_percentile);
+
+static void BM_top_k_sketch_add(benchmark::State &state) {
+    tair::common::TopKSketch sketch(16);
+    std::vector<std::string> keys;
+    uint64_t seed = 1;
+    for (int i = 0; i < 4096; ++i) {
+        // Skewed towards the low ids like real traffic
+        uint64_t id = nextLatency(seed) % 1000;
+        keys.push_back("key:" + std::to_string(id * id / 1000));
+    }
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sketch.add(keys[i++ & 4095]));
+    }
+}
+BENCHMARK(BM_top_k_sketch_add);
+
 BENCHMARK_MAIN();
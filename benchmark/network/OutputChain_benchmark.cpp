@@ -0,0 +1,135 @@
+/*
+ *  Copyright (c) 2023 Tair
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#include "benchmark/benchmark.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "network/Buffer.hpp"
+#include "network/OutputChain.hpp"
+
+using tair::network::Buffer;
+using tair::network::OutputChain;
+
+// A loopback tcp pair whose read side is drained by a background thread
+class LoopbackPair {
+public:
+    LoopbackPair() {
+        int listen_fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        struct sockaddr_in addr = {};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socklen_t len = sizeof(addr);
+        ::bind(listen_fd, (struct sockaddr *)&addr, len);
+        ::listen(listen_fd, 1);
+        ::getsockname(listen_fd, (struct sockaddr *)&addr, &len);
+        write_fd_ = ::socket(AF_INET, SOCK_STREAM, 0);
+        ::connect(write_fd_, (struct sockaddr *)&addr, len);
+        read_fd_ = ::accept(listen_fd, nullptr, nullptr);
+        ::close(listen_fd);
+        drainer_ = std::thread([fd = read_fd_] {
+            std::unique_ptr<char[]> buf(new char[256 * 1024]);
+            while (::read(fd, buf.get(), 256 * 1024) > 0) {
+            }
+        });
+    }
+
+    ~LoopbackPair() {
+        ::shutdown(write_fd_, SHUT_WR);
+        drainer_.join();
+        ::close(write_fd_);
+        ::close(read_fd_);
+    }
+
+    int writeFd() const {
+        return write_fd_;
+    }
+
+private:
+    int write_fd_ = -1;
+    int read_fd_ = -1;
+    std::thread drainer_;
+};
+
+static void writeAll(int fd, const char *data, size_t len) {
+    while (len > 0) {
+        ssize_t n = ::write(fd, data, len);
+        if (n <= 0) {
+            return;
+        }
+        data += n;
+        len -= n;
+    }
+}
+
+// SET key <value>, encoded contiguously: the value is copied into the command buffer
+static void BM_send_copy(benchmark::State &state) {
+    LoopbackPair pair;
+    auto value = std::make_shared<std::string>(state.range(0), 'v');
+    for (auto _ : state) {
+        Buffer buf;
+        buf.append("*3\r\n$3\r\nset\r\n$3\r\nkey\r\n$");
+        buf.appendNumberToStr(value->size());
+        buf.appendCRLF();
+        buf.append(*value);
+        buf.appendCRLF();
+        writeAll(pair.writeFd(), buf.data(), buf.length());
+    }
+    state.SetBytesProcessed(state.iterations() * value->size());
+}
+BENCHMARK(BM_send_copy)->Arg(1024)->Arg(64 * 1024)->Arg(4 * 1024 * 1024);
+
+// The same command as an output chain: headers copied, the value referenced and sent with writev
+static void BM_send_chain(benchmark::State &state) {
+    LoopbackPair pair;
+    auto value = std::make_shared<std::string>(state.range(0), 'v');
+    for (auto _ : state) {
+        OutputChain chain;
+        Buffer header;
+        header.append("*3\r\n$3\r\nset\r\n$3\r\nkey\r\n$");
+        header.appendNumberToStr(value->size());
+        header.appendCRLF();
+        chain.append(header.data(), header.length());
+        chain.appendRef(value->data(), value->size(), value);
+        chain.append("\r\n", 2);
+        struct iovec iov[OutputChain::kMaxIovecCount];
+        while (!chain.empty()) {
+            int count = chain.fillIovec(iov, OutputChain::kMaxIovecCount);
+            ssize_t n = ::writev(pair.writeFd(), iov, count);
+            if (n <= 0) {
+                break;
+            }
+            chain.skip(n);
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * value->size());
+}
+BENCHMARK(BM_send_chain)->Arg(1024)->Arg(64 * 1024)->Arg(4 * 1024 * 1024);
+
+BENCHMARK_MAIN();
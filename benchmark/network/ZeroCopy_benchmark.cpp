@@ -0,0 +1,146 @@
+/*
+ *  Copyright (c) 2023 Tair
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+
+#include "benchmark/benchmark.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "network/Sockets.hpp"
+
+namespace sockets = tair::network::sockets;
+
+// A loopback tcp pair whose read side is drained by a background thread
+class LoopbackPair {
+public:
+    LoopbackPair() {
+        int listen_fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        struct sockaddr_in addr = {};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socklen_t len = sizeof(addr);
+        ::bind(listen_fd, (struct sockaddr *)&addr, len);
+        ::listen(listen_fd, 1);
+        ::getsockname(listen_fd, (struct sockaddr *)&addr, &len);
+        write_fd_ = ::socket(AF_INET, SOCK_STREAM, 0);
+        ::connect(write_fd_, (struct sockaddr *)&addr, len);
+        read_fd_ = ::accept(listen_fd, nullptr, nullptr);
+        ::close(listen_fd);
+        drainer_ = std::thread([fd = read_fd_] {
+            std::unique_ptr<char[]> buf(new char[256 * 1024]);
+            while (::read(fd, buf.get(), 256 * 1024) > 0) {
+            }
+        });
+    }
+
+    ~LoopbackPair() {
+        ::shutdown(write_fd_, SHUT_WR);
+        drainer_.join();
+        ::close(write_fd_);
+        ::close(read_fd_);
+    }
+
+    int writeFd() const {
+        return write_fd_;
+    }
+
+private:
+    int write_fd_ = -1;
+    int read_fd_ = -1;
+    std::thread drainer_;
+};
+
+static double threadCpuSeconds() {
+    struct timespec ts;
+    ::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void reportCpuPerGB(benchmark::State &state, double cpu_seconds, size_t bytes) {
+    state.SetBytesProcessed(bytes);
+    state.counters["cpu_ms_per_GB"] = cpu_seconds * 1000 / ((double)bytes / (1024 * 1024 * 1024));
+}
+
+static void BM_send_write(benchmark::State &state) {
+    LoopbackPair pair;
+    std::string value(state.range(0), 'v');
+    size_t bytes = 0;
+    double cpu_start = threadCpuSeconds();
+    for (auto _ : state) {
+        const char *data = value.data();
+        size_t len = value.size();
+        while (len > 0) {
+            ssize_t n = ::write(pair.writeFd(), data, len);
+            if (n <= 0) {
+                break;
+            }
+            data += n;
+            len -= n;
+            bytes += n;
+        }
+    }
+    reportCpuPerGB(state, threadCpuSeconds() - cpu_start, bytes);
+}
+BENCHMARK(BM_send_write)->Arg(64 * 1024)->Arg(1024 * 1024)->Arg(4 * 1024 * 1024);
+
+static void BM_send_zerocopy(benchmark::State &state) {
+    LoopbackPair pair;
+    if (!sockets::setZeroCopy(pair.writeFd(), true)) {
+        state.SkipWithError("SO_ZEROCOPY is not supported");
+        return;
+    }
+    std::string value(state.range(0), 'v');
+    size_t bytes = 0;
+    uint32_t lo = 0;
+    uint32_t hi = 0;
+    double cpu_start = threadCpuSeconds();
+    for (auto _ : state) {
+        size_t offset = 0;
+        while (offset < value.size()) {
+            struct iovec iov = {value.data() + offset, value.size() - offset};
+            ssize_t n = sockets::sendZeroCopyToSocket(pair.writeFd(), &iov, 1);
+            if (n <= 0) {
+                if (errno != ENOBUFS) {
+                    break;
+                }
+                n = 0;
+            }
+            offset += n;
+            bytes += n;
+            // value is never modified, completions are only reaped to keep the error queue short
+            while (sockets::recvZeroCopyCompletion(pair.writeFd(), &lo, &hi) > 0) {
+            }
+        }
+    }
+    reportCpuPerGB(state, threadCpuSeconds() - cpu_start, bytes);
+}
+BENCHMARK(BM_send_zerocopy)->Arg(64 * 1024)->Arg(1024 * 1024)->Arg(4 * 1024 * 1024);
+
+BENCHMARK_MAIN();
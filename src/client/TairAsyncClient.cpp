@@ -32,6 +32,9 @@ using protocol::IntegerPacket;
 using protocol::ArrayPacket;
 
 TairResult<std::string> TairAsyncClient::init() {
+    if (TairBaseClient::isLazyConnect()) {
+        return TairResult<std::string>::create("ok");
+    }
     return TairBaseClient::connect().get();
 }
 
@@ -71,6 +74,90 @@ void TairAsyncClient::setKeepAliveSeconds(int seconds) {
     TairBaseClient::setKeepAliveSeconds(seconds);
 }
 
+void TairAsyncClient::setConnectionPoolSize(int size) {
+    TairBaseClient::setConnectionPoolSize(size);
+}
+
+void TairAsyncClient::setPoolSelectPolicy(PoolSelectPolicy policy) {
+    TairBaseClient::setPoolSelectPolicy(policy);
+}
+
+void TairAsyncClient::setReleaseRequestAfterWrite(bool release) {
+    TairBaseClient::setReleaseRequestAfterWrite(release);
+}
+
+void TairAsyncClient::setZeroCopyThreshold(size_t bytes) {
+    TairBaseClient::setZeroCopyThreshold(bytes);
+}
+
+void TairAsyncClient::setTls(std::shared_ptr<TlsClientContext> context) {
+    TairBaseClient::setTls(std::move(context));
+}
+
+void TairAsyncClient::setLazyConnect(bool lazy) {
+    TairBaseClient::setLazyConnect(lazy);
+}
+
+void TairAsyncClient::setDatabase(int db) {
+    TairBaseClient::setDatabase(db);
+}
+
+void TairAsyncClient::setFastOpen(bool on) {
+    TairBaseClient::setFastOpen(on);
+}
+
+void TairAsyncClient::setReconnectBufferSize(size_t size) {
+    TairBaseClient::setReconnectBufferSize(size);
+}
+
+void TairAsyncClient::setReconnectBufferTimeoutMs(int timeout_ms) {
+    TairBaseClient::setReconnectBufferTimeoutMs(timeout_ms);
+}
+
+void TairAsyncClient::setHedgeBudgetPercent(int percent) {
+    TairBaseClient::setHedgeBudgetPercent(percent);
+}
+
+void TairAsyncClient::setRequestLimits(const RequestLimits &limits) {
+    TairBaseClient::setRequestLimits(limits);
+}
+
+TairClientStats TairAsyncClient::getStats() const {
+    return TairBaseClient::getStats();
+}
+
+void TairAsyncClient::setSlowLog(const SlowLogConfig &config) {
+    TairBaseClient::setSlowLog(config);
+}
+
+std::vector<SlowRequestEntry> TairAsyncClient::getSlowLog(size_t count) const {
+    return TairBaseClient::getSlowLog(count);
+}
+
+void TairAsyncClient::setHotKeys(const HotKeyConfig &config) {
+    TairBaseClient::setHotKeys(config);
+}
+
+HotKeyReport TairAsyncClient::getHotKeys() const {
+    return TairBaseClient::getHotKeys();
+}
+
+void TairAsyncClient::setBigKeys(const BigKeyConfig &config) {
+    TairBaseClient::setBigKeys(config);
+}
+
+BigKeyReport TairAsyncClient::getBigKeys() const {
+    return TairBaseClient::getBigKeys();
+}
+
+void TairAsyncClient::setSlotLoad(bool enable) {
+    TairBaseClient::setSlotLoad(enable);
+}
+
+LoadReport TairAsyncClient::getLoad() const {
+    return TairBaseClient::getLoad();
+}
+
 // -------------------------------- send Command --------------------------------
 void TairAsyncClient::sendCommand(CommandArgv &&argv, const ResultPacketCallback &callback) {
     TairBaseClient::sendCommand(std::move(argv), [this, callback](auto &req, auto &resp, int64_t) {
@@ -96,6 +183,18 @@ void TairAsyncClient::sendCommand(const CommandArgv &argv, const ResultPacketAnd
     });
 }
 
+void TairAsyncClient::sendCommand(CommandArgv &&argv, const ResultPacketAndTimingCallback &callback) {
+    TairBaseClient::sendCommand(std::move(argv), [this, callback](auto &req, auto &resp, int64_t latency_us) {
+        callback(this, req, resp, latency_us, currentTiming(latency_us));
+    });
+}
+
+void TairAsyncClient::sendCommand(const CommandArgv &argv, const ResultPacketAndTimingCallback &callback) {
+    TairBaseClient::sendCommand(argv, [this, callback](auto &req, auto &resp, int64_t latency_us) {
+        callback(this, req, resp, latency_us, currentTiming(latency_us));
+    });
+}
+
 // -------------------------------- Generic Command --------------------------------
 void TairAsyncClient::del(const std::string &key, const ResultIntegerCallback &callback) {
     sendCommand({"del", key}, [callback](auto *, auto &, auto &resp) {
@@ -461,12 +560,29 @@ void TairAsyncClient::set(const std::string &key, const std::string &value, cons
     });
 }
 
+void TairAsyncClient::set(const std::string &key, std::shared_ptr<const std::string> value, const ResultStringCallback &callback) {
+    auto req = std::make_shared<ArrayPacket>();
+    req->addReplyBulk("set");
+    req->addReplyBulk(key);
+    req->addReplyBulk(std::move(value));
+    TairBaseClient::sendCommand(req, [callback](auto &, auto &resp, int64_t) {
+        TairResultHelper::doCallbackOneResult<SimpleStringPacket, std::string>(resp, callback);
+    });
+}
+
 void TairAsyncClient::get(const std::string &key, const ResultStringPtrCallback &callback) {
     sendCommand({"get", key}, [callback](auto *, auto &, auto &resp) {
         TairResultHelper::doCallbackByBuilder<BulkStringPacket, std::shared_ptr<std::string>>(resp, TairResultHelper::stringPtrBuilder, callback);
     });
 }
 
+void TairAsyncClient::getToSink(const std::string &key, const BulkStringSink &sink, const ResultIntegerPtrCallback &callback) {
+    BulkStringSink stream_sink = sink;
+    TairBaseClient::sendCommand({"get", key}, std::move(stream_sink), [callback](auto &, auto &resp, int64_t) {
+        TairResultHelper::doCallbackByBuilder<BulkStringPacket, std::shared_ptr<int64_t>>(resp, TairResultHelper::streamedLengthPtrBuilder, callback);
+    });
+}
+
 void TairAsyncClient::incr(const std::string &key, const ResultIntegerCallback &callback) {
     sendCommand({"incr", key}, [callback](auto *, auto &, auto &resp) {
         TairResultHelper::doCallbackOneResult<IntegerPacket, int64_t>(resp, callback);
@@ -48,6 +48,28 @@ public:
     void setReconnectIntervalMs(int timeout_ms) override;
     void setAutoReconnect(bool reconnect) override;
     void setKeepAliveSeconds(int seconds) override;
+    void setConnectionPoolSize(int size) override;
+    void setPoolSelectPolicy(PoolSelectPolicy policy) override;
+    void setReleaseRequestAfterWrite(bool release) override;
+    void setZeroCopyThreshold(size_t bytes) override;
+    void setTls(std::shared_ptr<TlsClientContext> context) override;
+    void setLazyConnect(bool lazy) override;
+    void setDatabase(int db) override;
+    void setFastOpen(bool on) override;
+    void setReconnectBufferSize(size_t size) override;
+    void setReconnectBufferTimeoutMs(int timeout_ms) override;
+    void setHedgeBudgetPercent(int percent) override;
+    void setRequestLimits(const RequestLimits &limits) override;
+
+    TairClientStats getStats() const override;
+    void setSlowLog(const SlowLogConfig &config) override;
+    std::vector<SlowRequestEntry> getSlowLog(size_t count) const override;
+    void setHotKeys(const HotKeyConfig &config) override;
+    HotKeyReport getHotKeys() const override;
+    void setBigKeys(const BigKeyConfig &config) override;
+    BigKeyReport getBigKeys() const override;
+    void setSlotLoad(bool enable) override;
+    LoadReport getLoad() const override;
 
     // send command
     void sendCommand(CommandArgv &&argv, const ResultPacketCallback &callback) override;
@@ -56,6 +78,9 @@ public:
     void sendCommand(CommandArgv &&argv, const ResultPacketAndLatencyCallback &callback) override;
     void sendCommand(const CommandArgv &argv, const ResultPacketAndLatencyCallback &callback) override;
 
+    void sendCommand(CommandArgv &&argv, const ResultPacketAndTimingCallback &callback) override;
+    void sendCommand(const CommandArgv &argv, const ResultPacketAndTimingCallback &callback) override;
+
     // generic
     void del(const std::string &key, const ResultIntegerCallback &callback) override;
     void del(InitializerList<std::string> keys, const ResultIntegerCallback &callback) override;
@@ -110,7 +135,9 @@ public:
     void getset(const std::string &key, const std::string &value, const ResultStringPtrCallback &callback) override;
     void set(const std::string &key, const std::string &value, const SetParams &params, const ResultStringCallback &callback) override;
     void set(const std::string &key, const std::string &value, const ResultStringCallback &callback) override;
+    void set(const std::string &key, std::shared_ptr<const std::string> value, const ResultStringCallback &callback) override;
     void get(const std::string &key, const ResultStringPtrCallback &callback) override;
+    void getToSink(const std::string &key, const BulkStringSink &sink, const ResultIntegerPtrCallback &callback) override;
     void incr(const std::string &key, const ResultIntegerCallback &callback) override;
     void incrby(const std::string &key, int64_t increment, const ResultIntegerCallback &callback) override;
     void incrbyfloat(const std::string &key, double increment, const ResultStringCallback &callback) override;
@@ -21,49 +21,50 @@
  */
 #include "client/TairBaseClient.hpp"
 
+#include <algorithm>
+#include <iterator>
+#include <unordered_set>
+
 #include "common/ClockTime.hpp"
 #include "common/Logger.hpp"
-#include "network/EventLoopThread.hpp"
+#include "common/StringUtil.hpp"
 #include "network/TcpClient.hpp"
 #include "network/TcpConnection.hpp"
 #include "protocol/packet/resp/ArrayPacket.hpp"
+#include "protocol/packet/resp/ErrorPacket.hpp"
 #include "client/TairClientInfo.hpp"
+#include "client/TairLoopPool.hpp"
+#include "client/TairRequestKey.hpp"
 #include "client/TairResultHelper.hpp"
+#include "client/TairTracepoints.hpp"
 
 namespace tair::client {
 
 using protocol::ArrayPacket;
+using protocol::BulkStringPacket;
 using protocol::CodecFactory;
 using protocol::CodecType;
 using protocol::DState;
+using protocol::ErrorPacket;
 using protocol::IntegerPacket;
 using protocol::SimpleStringPacket;
 using common::ClockTime;
+using common::StringUtil;
 
-TairBaseClient::TairBaseClient() {
-    initEventLoop();
-}
+TairBaseClient::TairBaseClient()
+    : TairBaseClient(nullptr) {}
 
 TairBaseClient::TairBaseClient(EventLoop *loop) {
     loop_ = loop;
     if (!loop_) {
-        initEventLoop();
+        loop_ = TairLoopPool::instance().getNextLoop();
     }
 }
 
 TairBaseClient::~TairBaseClient() {
+    // The loop is shared and outlives this client, so a task it already queued must find it gone
+    alive_.reset();
     disconnect();
-    if (loop_thread_) {
-        loop_thread_->stop();
-        loop_thread_->join();
-        loop_thread_.reset();
-    }
-}
-
-void TairBaseClient::initEventLoop() {
-    loop_thread_ = std::make_unique<EventLoopThread>("client-io");
-    loop_thread_->start();
-    loop_ = loop_thread_->loop();
 }
 
 void TairBaseClient::setServerAddr(const std::string &addr) {
@@ -98,18 +99,179 @@ void TairBaseClient::setKeepAliveSeconds(int seconds) {
     keepalive_seconds_ = seconds;
 }
 
+void TairBaseClient::setConnectionPoolSize(int size) {
+    connection_pool_size_ = std::max(size, 1);
+}
+
+void TairBaseClient::setPoolSelectPolicy(PoolSelectPolicy policy) {
+    pool_select_policy_ = policy;
+}
+
+void TairBaseClient::setReleaseRequestAfterWrite(bool release) {
+    release_request_after_write_ = release;
+}
+
+void TairBaseClient::setZeroCopyThreshold(size_t bytes) {
+    zerocopy_threshold_ = bytes;
+}
+
+void TairBaseClient::setTls(std::shared_ptr<TlsClientContext> context) {
+    tls_context_ = std::move(context);
+}
+
+void TairBaseClient::setLazyConnect(bool lazy) {
+    lazy_connect_ = lazy;
+}
+
+bool TairBaseClient::isLazyConnect() const {
+    return lazy_connect_;
+}
+
+void TairBaseClient::setReconnectBufferSize(size_t size) {
+    reconnect_buffer_size_ = size;
+}
+
+void TairBaseClient::setReconnectBufferTimeoutMs(int timeout_ms) {
+    reconnect_buffer_timeout_ms_ = timeout_ms;
+}
+
+void TairBaseClient::setRequestLimits(const RequestLimits &limits) {
+    if (limits.max_inflight == 0 && limits.max_inflight_bytes == 0 && limits.max_qps == 0) {
+        limiter_.reset();
+        return;
+    }
+    limiter_ = std::make_shared<TairRequestLimiter>(limits);
+}
+
+const std::shared_ptr<TairRequestLimiter> &TairBaseClient::getRequestLimiter() const {
+    return limiter_;
+}
+
+void TairBaseClient::setHedgeBudgetPercent(int percent) {
+    hedge_budget_percent_ = std::clamp(percent, 0, 100);
+}
+
+uint64_t TairBaseClient::getHedgeCount() const {
+    return hedge_count_;
+}
+
+void TairBaseClient::setDatabase(int db) {
+    database_ = db;
+}
+
+void TairBaseClient::setFastOpen(bool on) {
+    fast_open_ = on;
+}
+
+int64_t TairBaseClient::getConnectLatencyUs() const {
+    return connect_latency_us_;
+}
+
+thread_local const RequestTiming *TairBaseClient::current_timing_ = nullptr;
+
+TairClientStats TairBaseClient::getStats() const {
+    TairStatsBuilder builder;
+    collectStats(builder);
+    return builder.build();
+}
+
+void TairBaseClient::collectStats(TairStatsBuilder &builder) const {
+    builder.add(server_addr_, latency_recorder_);
+}
+
+void TairBaseClient::setSlowLog(const SlowLogConfig &config) {
+    if (config.threshold_us <= 0) {
+        slow_log_.reset();
+        return;
+    }
+    slow_log_ = std::make_unique<TairSlowLog>(config);
+}
+
+std::vector<SlowRequestEntry> TairBaseClient::getSlowLog(size_t count) const {
+    if (!slow_log_) {
+        return {};
+    }
+    return slow_log_->getEntries(count);
+}
+
+void TairBaseClient::setHotKeys(const HotKeyConfig &config) {
+    if (config.sample_rate <= 0) {
+        hot_keys_.reset();
+        return;
+    }
+    hot_keys_ = std::make_unique<TairHotKeyDetector>(config);
+}
+
+HotKeyReport TairBaseClient::getHotKeys() const {
+    if (!hot_keys_) {
+        return {};
+    }
+    return hot_keys_->getReport(server_addr_);
+}
+
+void TairBaseClient::setBigKeys(const BigKeyConfig &config) {
+    if (config.sample_rate <= 0 && config.reply_threshold_bytes == 0 && config.request_threshold_bytes == 0) {
+        big_keys_.reset();
+        return;
+    }
+    big_keys_ = std::make_unique<TairBigKeyDetector>(config);
+}
+
+BigKeyReport TairBaseClient::getBigKeys() const {
+    if (!big_keys_) {
+        return {};
+    }
+    return big_keys_->getReport();
+}
+
+void TairBaseClient::setSlotLoad(bool enable) {
+    if (!enable) {
+        slot_load_.reset();
+        return;
+    }
+    slot_load_ = std::make_unique<TairSlotLoad>();
+}
+
+LoadReport TairBaseClient::getLoad() const {
+    std::vector<SlotLoad> slots;
+    collectSlotLoad(slots);
+    return load_tracker_.build(std::move(slots), getStats());
+}
+
+void TairBaseClient::collectSlotLoad(std::vector<SlotLoad> &loads) const {
+    if (slot_load_) {
+        slot_load_->collect(server_addr_, loads);
+    }
+}
+
 bool TairBaseClient::isConnected() const {
+    // pool_clients_ belongs to the loop thread, the pooled connections publish their state instead
+    if (connection_pool_size_ > 1) {
+        return pool_connected_ > 0;
+    }
     return tcp_client_ && tcp_client_->isConnected();
 }
 
+void TairBaseClient::setPoolConnected(bool connected) {
+    if (!pool_owner_ || pool_counted_ == connected) {
+        return;
+    }
+    pool_counted_ = connected;
+    pool_owner_->pool_connected_ += connected ? 1 : -1;
+}
+
 bool TairBaseClient::doConnect() {
     assertNotInCallbackContext();
     if (server_addr_.empty() || !loop_) {
         return false;
     }
-    tcp_client_ = TcpClient::create(loop_, server_addr_);
+    bool has_scheme = server_addr_.starts_with("tcp://") || server_addr_.starts_with("tls://");
+    tcp_client_ = TcpClient::create(loop_, tls_context_ && !has_scheme ? "tls://" + server_addr_ : server_addr_);
+    tcp_client_->setTlsContext(tls_context_);
     tcp_client_->setConnectingTimeout(Duration(connecting_timeout_ms_ * Duration::kMillisecond));
     tcp_client_->setKeepAlive(keepalive_seconds_);
+    tcp_client_->setZeroCopyThreshold(zerocopy_threshold_);
+    tcp_client_->setFastOpen(fast_open_);
     tcp_client_->setConnectionCallback([this](const TcpConnectionPtr &conn) {
         onConnection(conn);
     });
@@ -117,63 +279,212 @@ bool TairBaseClient::doConnect() {
         onMessage(conn, buf);
     });
     tcp_client_->setAutoReConnect(auto_reconnect_);
+    connect_start_us_ = ClockTime::intervalUs();
     tcp_client_->connect();
     return true;
 }
 
+bool TairBaseClient::doConnectPool() {
+    assertNotInCallbackContext();
+    if (server_addr_.empty() || !loop_) {
+        return false;
+    }
+    std::vector<std::unique_ptr<TairBaseClient>> clients;
+    for (int i = 0; i < connection_pool_size_; ++i) {
+        auto client = std::make_unique<TairBaseClient>(loop_);
+        client->setServerAddr(server_addr_);
+        client->setUser(user_);
+        client->setPassword(password_);
+        client->setConnectingTimeoutMs(connecting_timeout_ms_);
+        client->setReconnectIntervalMs(reconnect_interval_ms_);
+        client->setAutoReconnect(auto_reconnect_);
+        client->setKeepAliveSeconds(keepalive_seconds_);
+        client->setReleaseRequestAfterWrite(release_request_after_write_);
+        client->setZeroCopyThreshold(zerocopy_threshold_);
+        client->setTls(tls_context_);
+        client->setDatabase(database_);
+        client->setFastOpen(fast_open_);
+        client->setReconnectBufferSize(reconnect_buffer_size_);
+        client->setReconnectBufferTimeoutMs(reconnect_buffer_timeout_ms_);
+        client->pool_owner_ = this;
+        {
+            LockGuard client_lock(client->mutex_);
+            client->auth_promise_ = std::make_unique<std::promise<TairResult<std::string>>>();
+        }
+        clients.emplace_back(std::move(client));
+    }
+    // The loop thread routes through pool_clients_, so the old pool is replaced there
+    CountDownLatch latch;
+    loop_->runInLoop([&](EventLoop *) {
+        cancelHedgeTimers();
+        pool_clients_ = std::move(clients);
+        pool_next_index_ = 0;
+        for (auto &client : pool_clients_) {
+            client->doConnect();
+        }
+        latch.countDown();
+    });
+    latch.wait();
+    return true;
+}
+
 std::future<TairResult<std::string>> TairBaseClient::connect() {
-    LockGuard lock(mutex_);
-    auth_promise_ = std::make_unique<std::promise<TairResult<std::string>>>();
-    if (!doConnect()) {
-        auth_promise_->set_value(TairResult<std::string>::createErr("server addr is empty or loop init failed"));
-        return auth_promise_->get_future();
+    std::future<TairResult<std::string>> future;
+    {
+        LockGuard lock(mutex_);
+        auth_promise_ = std::make_unique<std::promise<TairResult<std::string>>>();
+        future = auth_promise_->get_future();
+        pool_connecting_ = connection_pool_size_;
+    }
+    // Not under mutex_, the pooled connections report to it from the loop thread while the pool is swapped
+    bool ok = connection_pool_size_ > 1 ? doConnectPool() : doConnect();
+    if (!ok) {
+        finishConnect(TairResult<std::string>::createErr("server addr is empty or loop init failed"));
     }
-    return auth_promise_->get_future();
+    return future;
 }
 
 void TairBaseClient::disconnect() {
+    // Always through the loop, even without a connection there may be requests and timers to drop
+    CountDownLatch latch;
+    loop_->runInLoop([&](EventLoop *) {
+        closeInLoop();
+        latch.countDown();
+    });
+    latch.wait();
+}
+
+void TairBaseClient::closeInLoop() {
+    runtimeAssert(loop_->isInLoopThread());
+    // Each pooled client closes itself the same way when destroyed
+    cancelHedgeTimers();
+    pool_clients_.clear();
     if (tcp_client_) {
-        CountDownLatch latch;
-        loop_->runInLoop([&](EventLoop *) {
-            tcp_client_->disconnect();
-            tcp_client_.reset();
-            latch.countDown();
-        });
-        latch.wait();
+        tcp_client_->disconnect();
+        tcp_client_.reset();
     }
+    setPoolConnected(false);
+    if (reconnect_timer_id_ > 0) {
+        loop_->cancelTimer(reconnect_timer_id_);
+        reconnect_timer_id_ = -1;
+    }
+    std::vector<PendingRequest> requests;
+    {
+        LockGuard lock(pending_mutex_);
+        requests.swap(pending_requests_);
+    }
+    for (auto &request : requests) {
+        invokeCallback(request.callback, request.req, nullptr, 0);
+    }
+    // Also cancels the buffer timer
+    failConnectingRequests();
 }
 
 void TairBaseClient::reconnect() {
     LOG_INFO("Reconnect TairClient now");
+    if (!pool_clients_.empty()) {
+        for (auto &client : pool_clients_) {
+            client->reconnect();
+        }
+        return;
+    }
+    TRACING_SDT_WITH_SEMAPHORE(tair_client, reconnect, server_addr_.c_str(), callbacks_.size(), "reconnect");
     doConnect();
 }
 
-void TairBaseClient::authentication() {
+void TairBaseClient::finishConnect(const TairResult<std::string> &result) {
+    {
+        LockGuard lock(mutex_);
+        if (!auth_promise_) {
+            return;
+        }
+        auth_promise_->set_value(result);
+        auth_promise_.reset();
+    }
+    if (pool_owner_) {
+        pool_owner_->onPoolClientConnected(result);
+    }
+}
+
+void TairBaseClient::onPoolClientConnected(const TairResult<std::string> &result) {
+    LockGuard lock(mutex_);
+    if (!auth_promise_) {
+        return;
+    }
+    // The pool is ready when every connection is authenticated, the first failure fails it
+    if (!result.isSuccess() || --pool_connecting_ == 0) {
+        auth_promise_->set_value(result);
+        auth_promise_.reset();
+    }
+}
+
+void TairBaseClient::sendHandshake() {
+    struct HandshakeStep {
+        CommandArgv argv;
+        bool required; // a proxy may reject CLIENT SETNAME, that must not fail the connection
+    };
+    std::vector<HandshakeStep> steps;
     if (!user_.empty() && !password_.empty()) {
-        auth(user_, password_, [this](const auto &result) {
-            LockGuard lock(mutex_);
-            LOG_INFO("TairClient auth user password, result: {}", result.getValue());
-            if (auth_promise_) {
-                auth_promise_->set_value(result);
-                auth_promise_.reset();
-            }
-        });
+        steps.push_back({{"auth", user_, password_}, true});
     } else if (!password_.empty()) {
-        auth(password_, [this](const auto &result) {
-            LockGuard lock(mutex_);
-            LOG_INFO("TairClient auth password, result: {}", result.getValue());
-            if (auth_promise_) {
-                auth_promise_->set_value(result);
-                auth_promise_.reset();
+        steps.push_back({{"auth", password_}, true});
+    }
+    steps.push_back({{"client", "setname", TairClientInfo::toJSON()}, false});
+    if (database_ > 0) {
+        steps.push_back({{"select", std::to_string(database_)}, true});
+    }
+
+    struct HandshakeState {
+        size_t remaining;
+        std::string err;
+        bool disconnected = false;
+    };
+    auto state = std::make_shared<HandshakeState>(HandshakeState{steps.size(), {}});
+    handshaking_ = true;
+    Buffer buf;
+    for (auto &step : steps) {
+        PacketPtr req = std::make_shared<ArrayPacket>(std::move(step.argv));
+        codec_->encodeRequest(&buf, req.get());
+        callbacks_.emplace_back(req, [this, state, required = step.required](auto &, auto &resp, int64_t) {
+            if (!resp) {
+                state->disconnected = true;
+                if (state->err.empty()) {
+                    state->err = "connect to server fail, disconnected";
+                }
+            } else if (auto *err = resp->template packet_cast<ErrorPacket>(); err && required && state->err.empty()) {
+                state->err = err->getValue();
+            }
+            if (--state->remaining > 0) {
+                return;
             }
+            if (!state->err.empty()) {
+                LOG_ERROR("TairClient handshake with {} failed: {}", server_addr_, state->err);
+                if (!state->disconnected) {
+                    // Unauthenticated or on the wrong db, nothing may run on this connection. A new one would
+                    // be rejected the same way, so it is not reconnected until connect() is called again.
+                    // Queued as we are inside the read callback of the connection, requests keep being held till then
+                    failConnectingRequests(std::make_shared<ErrorPacket>(state->err));
+                    loop_->queueInLoop([this, alive = std::weak_ptr<void>(alive_)](EventLoop *) {
+                        if (alive.lock()) {
+                            closeInLoop();
+                        }
+                    });
+                }
+                finishConnect(TairResult<std::string>::createErr(state->err));
+                return;
+            }
+            connect_latency_us_ = ClockTime::intervalUs() - connect_start_us_;
+            LOG_INFO("TairClient handshake with {} done in {}us", server_addr_, connect_latency_us_.load());
+            handshaking_ = false;
+            flushConnectingRequests();
+            finishConnect(TairResult<std::string>::create("ok"));
         });
-    } else {
-        LOG_DEBUG("TairClient user and password are not set, skip auth.");
-        LockGuard lock(mutex_);
-        if (auth_promise_) {
-            auth_promise_->set_value(TairResult<std::string>::create("ok"));
-            auth_promise_.reset();
-        }
+    }
+    // One write for the whole burst, the replies come back in a single round trip
+    bytes_queued_ += buf.length();
+    tcp_client_->connection()->send(buf);
+    if (reconnect_interval_ms_ > 0) {
+        last_send_req_time_ms_ = ClockTime::intervalMs();
     }
 }
 
@@ -191,14 +502,13 @@ void TairBaseClient::clientCron() {
         LOG_INFO("TairClient has not been active for a long time and will reconnect, now: {}, recv: {}, send: {}, interval: {}",
                  now, last_recv_resp_time_ms_, last_send_req_time_ms_, reconnect_interval_ms_);
         tcp_client_.reset();
-        clearCallbacks();
+        replayOrFailCallbacks();
         reconnect();
     }
 }
 
 void TairBaseClient::onConnected() {
-    authentication();
-    clientSetName(TairClientInfo::toJSON(), [](const auto &result) {});
+    sendHandshake();
     if (reconnect_interval_ms_ > 0) {
         LOG_INFO("TairClient starts a timer for black hole detection");
         auto interval = Duration(reconnect_interval_ms_ / 2 * Duration::kMillisecond);
@@ -209,11 +519,17 @@ void TairBaseClient::onConnected() {
 }
 
 void TairBaseClient::onDisconnected() {
-    LockGuard lock(mutex_);
-    if (auth_promise_) {
-        auth_promise_->set_value(TairResult<std::string>::createErr("connect to server fail, disconnected"));
-        auth_promise_.reset();
+    handshaking_ = false;
+    // Auto reconnect starts right away, measure the next handshake from here
+    connect_start_us_ = ClockTime::intervalUs();
+    if (auto_reconnect_ && TRACING_SDT_IS_ENABLED(tair_client, reconnect)) {
+        TRACING_SDT_WITH_SEMAPHORE(tair_client, reconnect, server_addr_.c_str(), connecting_requests_.size(), "disconnected");
+    }
+    if (!auto_reconnect_) {
+        // Nothing will bring the connection back, buffered requests fail now instead of at their deadline
+        failConnectingRequests();
     }
+    finishConnect(TairResult<std::string>::createErr("connect to server fail, disconnected"));
     if (reconnect_timer_id_ > 0) {
         LOG_INFO("TairClient stop a timer for black hole detection");
         loop_->cancelTimer(reconnect_timer_id_);
@@ -225,20 +541,34 @@ void TairBaseClient::onConnection(const TcpConnectionPtr &conn) {
     if (conn->isConnected()) {
         // init codec when connect success (and reconnect success)
         codec_ = CodecFactory::getCodec(CodecType::RESP2);
+        decode_wait_bytes_ = 0;
+        bytes_queued_ = 0;
+        bytes_written_ = 0;
+        written_count_ = 0;
+        conn->setAfterWriteEventCallback([this](const TcpConnectionPtr &, size_t bytes) {
+            onWriteSocket(bytes);
+        });
+        if (has_connected_) {
+            (pool_owner_ ? pool_owner_ : this)->latency_recorder_.countReconnect();
+        }
+        has_connected_ = true;
+        setPoolConnected(true);
         LOG_INFO("TairClient is connected: {} -> {}", conn->getLocalIpPort(), conn->getRemoteIpPort());
         onConnected();
     } else {
         LOG_INFO("TairClient is disconnected: {} -> {}", conn->getLocalIpPort(), conn->getRemoteIpPort());
-        clearCallbacks();
+        setPoolConnected(false);
+        replayOrFailCallbacks();
         onDisconnected();
     }
 }
 
-void TairBaseClient::onRecvResponse(const PacketPtr &resp) {
-    runtimeAssert(!callbacks_.empty());
-    auto [init_time, req, callback] = callbacks_.front();
-    int64_t latency_us = ClockTime::intervalUs() - init_time;
-    callbacks_.pop_front();
+void TairBaseClient::invokeCallback(RespPacketPtrCallback &callback, const PacketPtr &req, const PacketPtr &resp, int64_t latency_us) {
+    auto *error = resp ? resp->packet_cast<ErrorPacket>() : nullptr;
+    if (!resp || error) {
+        bool redirect = error && (error->getValue().starts_with("MOVED ") || error->getValue().starts_with("ASK "));
+        (pool_owner_ ? pool_owner_ : this)->latency_recorder_.countError(redirect);
+    }
     if (callback) {
         in_callback_context_ = true;
         callback(req, resp, latency_us);
@@ -246,8 +576,135 @@ void TairBaseClient::onRecvResponse(const PacketPtr &resp) {
     }
 }
 
+RequestTiming TairBaseClient::currentTiming(int64_t latency_us) {
+    if (current_timing_) {
+        return *current_timing_;
+    }
+    RequestTiming timing;
+    timing.total_us = latency_us;
+    return timing;
+}
+
+void TairBaseClient::onWriteSocket(size_t bytes) {
+    bytes_written_ += bytes;
+    size_t written = written_count_;
+    if (written_count_ < callbacks_.size() && callbacks_[written_count_].write_offset <= bytes_written_) {
+        int64_t now = ClockTime::intervalUs();
+        while (written_count_ < callbacks_.size() && callbacks_[written_count_].write_offset <= bytes_written_) {
+            callbacks_[written_count_++].write_time = now;
+        }
+    }
+    if (TRACING_SDT_IS_ENABLED(tair_client, socket_write)) {
+        uint64_t trace_id = written_count_ > written ? callbacks_[written_count_ - 1].trace_id : 0;
+        TRACING_SDT_WITH_SEMAPHORE(tair_client, socket_write, trace_id, server_addr_.c_str(), bytes);
+    }
+}
+
+TairBaseClient::CallBackContext TairBaseClient::popFrontCallback() {
+    CallBackContext ctx = std::move(callbacks_.front());
+    callbacks_.pop_front();
+    (pool_owner_ ? pool_owner_ : this)->latency_recorder_.countCompleted();
+    if (written_count_ > 0) {
+        written_count_--;
+    }
+    return ctx;
+}
+
+void TairBaseClient::onRecvResponse(const PacketPtr &resp) {
+    runtimeAssert(!callbacks_.empty());
+    CallBackContext ctx = popFrontCallback();
+    int64_t now = ClockTime::intervalUs();
+    int64_t latency_us = now - ctx.init_time;
+    // A missing stamp folds that phase into the next one
+    int64_t write_time = std::max(ctx.write_time, ctx.init_time);
+    int64_t first_byte_time = ctx.first_byte_time ? std::max(ctx.first_byte_time, write_time) : now;
+    RequestTiming timing;
+    timing.queue_us = write_time - ctx.init_time;
+    timing.network_us = first_byte_time - write_time;
+    timing.decode_us = now - first_byte_time;
+    timing.total_us = latency_us;
+    if (ctx.latency_histogram) {
+        auto *owner = pool_owner_ ? pool_owner_ : this;
+        ctx.latency_histogram->recordSingleWriter(latency_us);
+        owner->latency_recorder_.recordTiming(timing);
+        if (owner->slow_log_ && owner->slow_log_->isSlow(latency_us)) {
+            owner->recordSlowRequest(ctx, resp, write_time, first_byte_time, now);
+        }
+        if (ctx.hot_key_sampled && owner->hot_keys_) {
+            owner->hot_keys_->record(server_addr_, ctx.req, ctx.request_bytes + (resp ? resp->getRESP2EncodeSize() : 0));
+        }
+        if (owner->slot_load_ && ctx.slot >= 0) {
+            owner->slot_load_->recordReply(ctx.slot, resp ? resp->getPacketSize() : 0);
+        }
+        if (owner->big_keys_) {
+            // Counted by the codec while decoding, no walk over the reply
+            size_t reply_bytes = resp ? resp->getPacketSize() : 0;
+            if (ctx.big_key_sampled || owner->big_keys_->isBigReply(reply_bytes)) {
+                owner->big_keys_->recordReply(server_addr_, owner->latency_recorder_.getCommandName(ctx.latency_histogram), ctx.req,
+                                              ctx.request_bytes, reply_bytes, ctx.big_key_sampled);
+            }
+        }
+    }
+    if (ctx.trace_id) {
+        traceResponse(ctx, resp, timing, now);
+        return;
+    }
+    current_timing_ = &timing;
+    invokeCallback(ctx.callback, ctx.req, resp, latency_us);
+    current_timing_ = nullptr;
+}
+
+void TairBaseClient::traceResponse(CallBackContext &ctx, const PacketPtr &resp, const RequestTiming &timing, int64_t now) {
+    std::string command = (pool_owner_ ? pool_owner_ : this)->latency_recorder_.getCommandName(ctx.latency_histogram);
+    const char *node = server_addr_.c_str();
+    if (TRACING_SDT_IS_ENABLED(tair_client, decode)) {
+        TRACING_SDT_WITH_SEMAPHORE(tair_client, decode, ctx.trace_id, command.c_str(), node, resp ? resp->getRESP2EncodeSize() : 0);
+    }
+    TRACING_SDT_WITH_SEMAPHORE(tair_client, callback_start, ctx.trace_id, command.c_str(), node, timing.total_us);
+    current_timing_ = &timing;
+    invokeCallback(ctx.callback, ctx.req, resp, timing.total_us);
+    current_timing_ = nullptr;
+    TRACING_SDT_WITH_SEMAPHORE(tair_client, callback_end, ctx.trace_id, command.c_str(), node, ClockTime::intervalUs() - now);
+}
+
+void TairBaseClient::recordSlowRequest(const CallBackContext &ctx, const PacketPtr &resp, int64_t write_time, int64_t first_byte_time, int64_t now) {
+    SlowRequestEntry entry;
+    entry.node = server_addr_;
+    entry.command = latency_recorder_.getCommandName(ctx.latency_histogram);
+    auto key = TairRequestKey::extractKey(ctx.req);
+    entry.key = std::move(key.name);
+    entry.slot = key.slot;
+    entry.request_bytes = ctx.request_bytes;
+    entry.reply_bytes = resp ? resp->getRESP2EncodeSize() : 0;
+    // Monotonic stamps to wall clock
+    int64_t offset = ClockTime::nowUs() - now;
+    entry.submit_us = ctx.init_time + offset;
+    entry.write_us = write_time + offset;
+    entry.first_byte_us = first_byte_time + offset;
+    entry.callback_us = now + offset;
+    slow_log_->add(std::move(entry));
+}
+
 void TairBaseClient::onMessage(const TcpConnectionPtr &conn, Buffer *buf) {
+    // The pending bulk is still incomplete, no need to rescan it
+    if (buf->length() < decode_wait_bytes_) {
+        return;
+    }
+    decode_wait_bytes_ = 0;
+    int64_t read_time = ClockTime::intervalUs();
+    if (TRACING_SDT_IS_ENABLED(tair_client, socket_read)) {
+        TRACING_SDT_WITH_SEMAPHORE(tair_client, socket_read, callbacks_.empty() ? 0 : callbacks_.front().trace_id,
+                                   server_addr_.c_str(), buf->length());
+    }
     while (conn->isConnected()) {
+        if (!callbacks_.empty() && !callbacks_.front().first_byte_time && !buf->empty()) {
+            callbacks_.front().first_byte_time = read_time;
+        }
+        if (!callbacks_.empty() && callbacks_.front().sink) {
+            // Hand the sink over before its reply starts decoding
+            codec_->setResponseSink(std::move(callbacks_.front().sink));
+            callbacks_.front().sink = nullptr;
+        }
         PacketUniqPtr packet;
         auto dstate = codec_->decodeResponse(buf, packet);
         PacketPtr resp = std::move(packet);
@@ -257,6 +714,12 @@ void TairBaseClient::onMessage(const TcpConnectionPtr &conn, Buffer *buf) {
             if (!buf->empty()) {
                 LOG_TRACE("connection not read full cmd, need read again");
             }
+            size_t expected = codec_->getExpectedBytes();
+            if (expected > buf->length()) {
+                // Reserve the whole payload once instead of growing per read
+                buf->ensureWritableBytes(expected - buf->length());
+                decode_wait_bytes_ = expected;
+            }
             break;
         } else if (dstate == DState::ERROR) {
             LOG_ERROR("redis protocol decode error: {}, connection addr: {}",
@@ -278,53 +741,402 @@ void TairBaseClient::onMessage(const TcpConnectionPtr &conn, Buffer *buf) {
 void TairBaseClient::clearCallbacks() {
     assertNotInCallbackContext();
     while (!callbacks_.empty()) {
-        auto [init_time, req, callback] = callbacks_.front();
-        int64_t latency_us = ClockTime::intervalUs() - init_time;
-        callbacks_.pop_front();
-        if (callback) {
-            in_callback_context_ = true;
-            callback(req, nullptr, latency_us);
-            in_callback_context_ = false;
+        CallBackContext ctx = popFrontCallback();
+        int64_t latency_us = ClockTime::intervalUs() - ctx.init_time;
+        invokeCallback(ctx.callback, ctx.req, nullptr, latency_us);
+    }
+}
+
+TairBaseClient *TairBaseClient::selectPoolClient(const PacketPtr &req) {
+    size_t size = pool_clients_.size();
+    if (pool_select_policy_ == PoolSelectPolicy::KEY_STICKY) {
+        int slot = TairRequestKey::calcRequestSlot(req);
+        if (slot >= 0) {
+            return pool_clients_[slot % size].get();
+        }
+        // Commands without a key have no ordering to keep, fall back to least inflight
+    }
+    if (pool_select_policy_ == PoolSelectPolicy::ROUND_ROBIN) {
+        for (size_t i = 0; i < size; ++i) {
+            TairBaseClient *client = pool_clients_[pool_next_index_++ % size].get();
+            if (client->isConnected()) {
+                return client;
+            }
+        }
+        return pool_clients_[pool_next_index_++ % size].get();
+    }
+    TairBaseClient *selected = nullptr;
+    for (auto &client : pool_clients_) {
+        if (client->isConnected() && (!selected || client->callbacks_.size() < selected->callbacks_.size())) {
+            selected = client.get();
         }
     }
+    return selected ? selected : pool_clients_.front().get();
 }
 
-void TairBaseClient::sendCommandInLoop(const PacketPtr &req, const RespPacketPtrCallback &callback) {
+void TairBaseClient::sendHedgedInLoop(PendingRequest &&request) {
+    struct HedgeState {
+        PacketPtr req;
+        RespPacketPtrCallback callback;
+        int64_t init_time;
+        uint64_t trace_id;
+        int outstanding = 1;
+        bool done = false;
+        int64_t timer_id = -1;
+    };
+    auto state = std::make_shared<HedgeState>();
+    state->req = request.req;
+    state->callback = std::move(request.callback);
+    state->init_time = request.init_time > 0 ? request.init_time : ClockTime::intervalUs();
+    state->trace_id = request.trace_id;
+    // The first reply completes the request, a null one only if no other attempt is left
+    auto make_callback = [this, state](bool primary) -> RespPacketPtrCallback {
+        return [this, state, primary](const PacketPtr &req, const PacketPtr &resp, int64_t latency_us) {
+            if (primary && resp) {
+                recordHedgeSample(latency_us);
+            }
+            --state->outstanding;
+            if (state->done || (!resp && state->outstanding > 0)) {
+                return;
+            }
+            state->done = true;
+            // Not armed anymore if cancelHedgeTimers got to it first
+            if (state->timer_id > 0 && hedge_timer_ids_.erase(state->timer_id) > 0) {
+                loop_->cancelTimer(state->timer_id);
+            }
+            state->timer_id = -1;
+            state->callback(req, resp, ClockTime::intervalUs() - state->init_time);
+        };
+    };
+
+    TairBaseClient *primary = selectPoolClient(request.req);
+    hedge_credit_ = std::min(hedge_credit_ + hedge_budget_percent_, kMaxHedgeCredit);
+    primary->sendRequestInLoop({request.req, make_callback(true), nullptr, request.init_time, request.replayed, request.trace_id});
+    if (state->done || hedge_threshold_us_ < 0) {
+        return;
+    }
+    auto delay = Duration(std::max(hedge_threshold_us_, kMinHedgeDelayUs) * Duration::kMicrosecond);
+    state->timer_id = loop_->runAfterTimer(delay, [this, state, primary, make_callback](EventLoop *) {
+        // timer auto removed by loop, just set id = -1
+        hedge_timer_ids_.erase(state->timer_id);
+        state->timer_id = -1;
+        if (state->done || hedge_credit_ < 100) {
+            return;
+        }
+        TairBaseClient *backup = nullptr;
+        for (auto &client : pool_clients_) {
+            if (client.get() != primary && client->isConnected() && (!backup || client->callbacks_.size() < backup->callbacks_.size())) {
+                backup = client.get();
+            }
+        }
+        if (!backup) {
+            return;
+        }
+        hedge_credit_ -= 100;
+        ++hedge_count_;
+        ++state->outstanding;
+        backup->sendRequestInLoop({state->req, make_callback(false), nullptr, 0, false, state->trace_id});
+    });
+    hedge_timer_ids_.insert(state->timer_id);
+}
+
+void TairBaseClient::cancelHedgeTimers() {
     runtimeAssert(loop_->isInLoopThread());
+    // The request stays on its primary, which replies or fails it on its own
+    for (int64_t timer_id : hedge_timer_ids_) {
+        loop_->cancelTimer(timer_id);
+    }
+    hedge_timer_ids_.clear();
+}
+
+void TairBaseClient::recordHedgeSample(int64_t latency_us) {
+    if (hedge_samples_.size() < kHedgeSampleSize) {
+        hedge_samples_.push_back(latency_us);
+    } else {
+        hedge_samples_[hedge_sample_index_ % kHedgeSampleSize] = latency_us;
+    }
+    // Refresh the p95 every so often rather than per reply, a sort of the window is not free
+    if (++hedge_sample_index_ % kHedgeRefreshInterval == 0) {
+        std::vector<int64_t> sorted = hedge_samples_;
+        auto nth = sorted.begin() + sorted.size() * 95 / 100;
+        std::nth_element(sorted.begin(), nth, sorted.end());
+        hedge_threshold_us_ = *nth;
+    }
+}
+
+void TairBaseClient::sendCommandInLoop(const PacketPtr &req, RespPacketPtrCallback &&callback, BulkStringSink &&sink) {
+    sendRequestInLoop({req, std::move(callback), std::move(sink)});
+}
+
+void TairBaseClient::sendRequestInLoop(PendingRequest &&request) {
+    runtimeAssert(loop_->isInLoopThread());
+    if (lazy_connect_ && !tcp_client_ && pool_clients_.empty()) {
+        LOG_INFO("TairClient connects to {} on first use", server_addr_);
+        lazy_connect_ = false;
+        connect();
+    }
+    if (hedge_budget_percent_ > 0 && pool_clients_.size() > 1 && !request.sink && isIdempotentRead(request.req)) {
+        sendHedgedInLoop(std::move(request));
+        return;
+    }
+    if (!pool_clients_.empty()) {
+        selectPoolClient(request.req)->sendRequestInLoop(std::move(request));
+        return;
+    }
     if (!tcp_client_) { // disconnected
-        in_callback_context_ = true;
-        callback(req, nullptr, 0);
-        in_callback_context_ = false;
+        invokeCallback(request.callback, request.req, nullptr, 0);
         return;
     }
-    callbacks_.emplace_back(CallBackContext(req, callback));
-    Buffer buf;
-    codec_->encodeRequest(&buf, req.get());
     auto conn = tcp_client_->connection();
-    conn->send(buf);
+    bool connected = conn && conn->isConnected();
+    if (!connected || handshaking_) { // connecting, reconnecting or not authenticated yet
+        if (conn && !connected && !auto_reconnect_) {
+            invokeCallback(request.callback, request.req, nullptr, 0);
+            return;
+        }
+        bufferRequest(std::move(request));
+        return;
+    }
+    auto &ctx = callbacks_.emplace_back(request.req, std::move(request.callback));
+    if (request.init_time > 0) {
+        ctx.init_time = request.init_time;
+    }
+    ctx.replayed = request.replayed;
+    ctx.trace_id = request.trace_id;
+    ctx.has_sink = request.sink != nullptr;
+    ctx.sink = std::move(request.sink);
+    auto *owner = pool_owner_ ? pool_owner_ : this;
+    ctx.latency_histogram = owner->latency_recorder_.getHistogram(request.req);
+    owner->latency_recorder_.countRequest();
+    ctx.hot_key_sampled = owner->hot_keys_ && owner->hot_keys_->shouldSample();
+    ctx.big_key_sampled = owner->big_keys_ && owner->big_keys_->shouldSample();
+    const PacketPtr &req = request.req;
+    // The write may complete inside send(), so the offset is set first
+    if (codec_->hasLargePayload(req.get())) {
+        // Large values are written from the request itself with writev, not copied
+        OutputChain chain;
+        codec_->encodeRequestToChain(&chain, req);
+        ctx.request_bytes = chain.length();
+        bytes_queued_ += ctx.request_bytes;
+        ctx.write_offset = bytes_queued_;
+        conn->send(std::move(chain));
+    } else {
+        Buffer buf;
+        codec_->encodeRequest(&buf, req.get());
+        ctx.request_bytes = buf.length();
+        bytes_queued_ += ctx.request_bytes;
+        ctx.write_offset = bytes_queued_;
+        conn->send(buf);
+    }
+    if (ctx.trace_id && TRACING_SDT_IS_ENABLED(tair_client, encode)) {
+        TRACING_SDT_WITH_SEMAPHORE(tair_client, encode, ctx.trace_id, TairTracepoints::commandName(req), server_addr_.c_str(),
+                                   ctx.request_bytes);
+    }
+    if (owner->slot_load_) {
+        ctx.slot = TairRequestKey::calcRequestSlot(req);
+        owner->slot_load_->recordRequest(ctx.slot, ctx.request_bytes);
+    }
+    if (owner->big_keys_ && owner->big_keys_->isBigRequest(ctx.request_bytes)) {
+        owner->big_keys_->recordRequest(server_addr_, owner->latency_recorder_.getCommandName(ctx.latency_histogram), req,
+                                        ctx.request_bytes);
+    }
+    if (release_request_after_write_ && !ctx.hot_key_sampled && !ctx.big_key_sampled) {
+        // The connection owns the encoded bytes (or a reference to the payload) now
+        ctx.req.reset();
+    }
     if (reconnect_interval_ms_ > 0) {
         last_send_req_time_ms_ = ClockTime::intervalMs();
     }
 }
 
-void TairBaseClient::sendCommand(const PacketPtr &req, const RespPacketPtrCallback &callback) {
+void TairBaseClient::flushPendingRequests() {
+    std::vector<PendingRequest> requests;
+    {
+        LockGuard lock(pending_mutex_);
+        requests.swap(pending_requests_);
+    }
+    for (auto &request : requests) {
+        sendRequestInLoop(std::move(request));
+    }
+}
+
+void TairBaseClient::bufferRequest(PendingRequest &&request) {
+    if (connecting_requests_.size() >= reconnect_buffer_size_) {
+        LOG_WARN("TairClient reconnect buffer is full ({} requests), fail the request", reconnect_buffer_size_);
+        invokeCallback(request.callback, request.req, nullptr, 0);
+        return;
+    }
+    if (request.init_time == 0) {
+        request.init_time = ClockTime::intervalUs();
+    }
+    connecting_requests_.push_back(std::move(request));
+    armBufferTimer();
+}
+
+void TairBaseClient::armBufferTimer() {
+    if (buffer_timer_id_ > 0 || connecting_requests_.empty() || reconnect_buffer_timeout_ms_ <= 0) {
+        return;
+    }
+    auto oldest = std::min_element(connecting_requests_.begin(), connecting_requests_.end(), [](const auto &a, const auto &b) {
+        return a.init_time < b.init_time;
+    });
+    int64_t wait_us = std::max<int64_t>(oldest->init_time + reconnect_buffer_timeout_ms_ * 1000L - ClockTime::intervalUs(), 0);
+    buffer_timer_id_ = loop_->runAfterTimer(Duration(wait_us * Duration::kMicrosecond), [this](EventLoop *) {
+        // timer auto removed by loop, just set id = -1
+        buffer_timer_id_ = -1;
+        expireConnectingRequests();
+    });
+}
+
+void TairBaseClient::cancelBufferTimer() {
+    if (buffer_timer_id_ > 0) {
+        loop_->cancelTimer(buffer_timer_id_);
+        buffer_timer_id_ = -1;
+    }
+}
+
+void TairBaseClient::expireConnectingRequests() {
+    int64_t deadline = ClockTime::intervalUs() - reconnect_buffer_timeout_ms_ * 1000L;
+    std::vector<PendingRequest> expired;
+    auto iter = std::stable_partition(connecting_requests_.begin(), connecting_requests_.end(), [deadline](const auto &request) {
+        return request.init_time > deadline;
+    });
+    std::move(iter, connecting_requests_.end(), std::back_inserter(expired));
+    connecting_requests_.erase(iter, connecting_requests_.end());
+    if (!expired.empty()) {
+        LOG_WARN("TairClient fails {} requests still waiting for a connection to {} after {}ms",
+                 expired.size(), server_addr_, reconnect_buffer_timeout_ms_);
+    }
+    for (auto &request : expired) {
+        invokeCallback(request.callback, request.req, nullptr, ClockTime::intervalUs() - request.init_time);
+    }
+    armBufferTimer();
+}
+
+void TairBaseClient::flushConnectingRequests() {
+    cancelBufferTimer();
+    std::vector<PendingRequest> requests;
+    requests.swap(connecting_requests_);
+    for (auto &request : requests) {
+        sendRequestInLoop(std::move(request));
+    }
+}
+
+void TairBaseClient::failConnectingRequests(const PacketPtr &resp) {
+    cancelBufferTimer();
+    std::vector<PendingRequest> requests;
+    requests.swap(connecting_requests_);
+    for (auto &request : requests) {
+        invokeCallback(request.callback, request.req, resp, 0);
+    }
+}
+
+bool TairBaseClient::isIdempotentRead(const PacketPtr &req) {
+    // Replaying these on a new connection returns what the lost reply would have
+    static const std::unordered_set<std::string> kIdempotentReads = {
+        "get", "mget", "getrange", "strlen", "exists", "type", "ttl", "pttl",
+        "hget", "hmget", "hgetall", "hkeys", "hvals", "hlen", "hexists", "hstrlen",
+        "lindex", "llen", "lrange", "scard", "sismember", "smismember", "smembers",
+        "zcard", "zcount", "zrange", "zrangebyscore", "zrevrange", "zrevrangebyscore",
+        "zrank", "zrevrank", "zscore", "zmscore", "xlen", "xrange", "xrevrange",
+        "bitcount", "getbit", "pfcount", "dbsize", "ping", "echo"};
+    auto *array = req->packet_cast<ArrayPacket>();
+    if (!array || array->getPacketArray().empty()) {
+        return false;
+    }
+    auto *cmd = array->getPacketArray()[0]->packet_cast<BulkStringPacket>();
+    if (!cmd) {
+        return false;
+    }
+    std::string name = cmd->getValue();
+    StringUtil::toLower(name);
+    return kIdempotentReads.count(name) > 0;
+}
+
+void TairBaseClient::replayOrFailCallbacks() {
+    assertNotInCallbackContext();
+    std::vector<PendingRequest> replay;
+    size_t room = reconnect_buffer_size_ > connecting_requests_.size() ? reconnect_buffer_size_ - connecting_requests_.size() : 0;
+    while (!callbacks_.empty()) {
+        CallBackContext ctx = popFrontCallback();
+        // Each request is replayed at most once, and never after part of a reply reached its sink
+        if (auto_reconnect_ && replay.size() < room && ctx.req && !ctx.has_sink && !ctx.replayed && isIdempotentRead(ctx.req)) {
+            replay.push_back({std::move(ctx.req), std::move(ctx.callback), nullptr, ctx.init_time, true, ctx.trace_id});
+            continue;
+        }
+        int64_t latency_us = ClockTime::intervalUs() - ctx.init_time;
+        invokeCallback(ctx.callback, ctx.req, nullptr, latency_us);
+    }
+    if (replay.empty()) {
+        return;
+    }
+    LOG_INFO("TairClient replays {} read requests once {} is back", replay.size(), server_addr_);
+    // They were sent before anything buffered since, keep that order
+    connecting_requests_.insert(connecting_requests_.begin(), std::make_move_iterator(replay.begin()), std::make_move_iterator(replay.end()));
+    armBufferTimer();
+}
+
+void TairBaseClient::sendCommand(const PacketPtr &req, RespPacketPtrCallback &&callback, BulkStringSink &&sink) {
+    if (limiter_) {
+        size_t bytes = limiter_->isBytesLimited() ? req->getRESP2EncodeSize() : 0;
+        if (!limiter_->acquire(bytes, !loop_->isInLoopThread())) {
+            // Callbacks run on the loop thread, the reject is no exception
+            auto reject = std::make_shared<RespPacketPtrCallback>(std::move(callback));
+            loop_->runInLoop([this, alive = std::weak_ptr<void>(alive_), req, reject](EventLoop *) {
+                auto resp = std::make_shared<ErrorPacket>("ERR client side request limit reached");
+                if (alive.lock()) {
+                    invokeCallback(*reject, req, resp, 0);
+                } else if (*reject) {
+                    (*reject)(req, resp, 0);
+                }
+            });
+            return;
+        }
+        callback = [limiter = limiter_, bytes, callback = std::move(callback)](const PacketPtr &req, const PacketPtr &resp, int64_t latency_us) mutable {
+            limiter->release(bytes, latency_us);
+            if (callback) {
+                callback(req, resp, latency_us);
+            }
+        };
+    }
+    uint64_t trace_id = TairTracepoints::nextRequestId();
+    if (trace_id && TRACING_SDT_IS_ENABLED(tair_client, submit)) {
+        TRACING_SDT_WITH_SEMAPHORE(tair_client, submit, trace_id, TairTracepoints::commandName(req), server_addr_.c_str(),
+                                   req->getRESP2EncodeSize());
+    }
     if (loop_->isInLoopThread()) {
-        sendCommandInLoop(req, callback);
-    } else {
-        loop_->queueInLoop([this, req, callback](EventLoop *) {
-            sendCommandInLoop(req, callback);
+        sendRequestInLoop({req, std::move(callback), std::move(sink), 0, false, trace_id});
+        return;
+    }
+    bool need_wakeup = false;
+    {
+        LockGuard lock(pending_mutex_);
+        need_wakeup = pending_requests_.empty();
+        // Taken here so latency includes the hop to the loop thread
+        pending_requests_.push_back({req, std::move(callback), std::move(sink), ClockTime::intervalUs(), false, trace_id});
+    }
+    if (need_wakeup) {
+        loop_->queueInLoop([this, alive = std::weak_ptr<void>(alive_)](EventLoop *) {
+            if (alive.lock()) {
+                flushPendingRequests();
+            }
         });
     }
 }
 
-void TairBaseClient::sendCommand(CommandArgv &&argv, const RespPacketPtrCallback &callback) {
+void TairBaseClient::sendCommand(CommandArgv &&argv, RespPacketPtrCallback &&callback) {
+    PacketPtr req = std::make_shared<ArrayPacket>(std::move(argv));
+    sendCommand(req, std::move(callback));
+}
+
+void TairBaseClient::sendCommand(CommandArgv &&argv, BulkStringSink &&sink, RespPacketPtrCallback &&callback) {
     PacketPtr req = std::make_shared<ArrayPacket>(std::move(argv));
-    sendCommand(req, callback);
+    sendCommand(req, std::move(callback), std::move(sink));
 }
 
-void TairBaseClient::sendCommand(const CommandArgv &argv, const RespPacketPtrCallback &callback) {
+void TairBaseClient::sendCommand(const CommandArgv &argv, RespPacketPtrCallback &&callback) {
     PacketPtr req = std::make_shared<ArrayPacket>(argv);
-    sendCommand(req, callback);
+    sendCommand(req, std::move(callback));
 }
 
 void TairBaseClient::auth(const std::string &password, const ResultStringCallback &callback) {
@@ -22,19 +22,29 @@
 #pragma once
 
 #include <atomic>
-#include <deque>
 #include <functional>
 #include <memory>
+#include <string>
+#include <unordered_set>
 #include <vector>
 
 #include "common/ClockTime.hpp"
 #include "common/CountDownLatch.hpp"
+#include "common/MoveOnlyFunction.hpp"
 #include "common/Noncopyable.hpp"
+#include "common/RingQueue.hpp"
 #include "network/Duration.hpp"
 #include "network/TcpConnection.hpp"
+#include "network/TlsOptions.hpp"
 #include "network/Types.hpp"
 #include "protocol/codec/CodecFactory.hpp"
 #include "client/TairClientDefine.hpp"
+#include "client/TairHotKeyDetector.hpp"
+#include "client/TairBigKeyDetector.hpp"
+#include "client/TairSlotLoad.hpp"
+#include "client/TairLatencyRecorder.hpp"
+#include "client/TairRequestLimiter.hpp"
+#include "client/TairSlowLog.hpp"
 #include "client/TairResult.hpp"
 
 namespace tair::client {
@@ -44,19 +54,24 @@ using common::CountDownLatch;
 using common::ClockTime;
 using common::LockGuard;
 using common::Mutex;
+using common::MoveOnlyFunction;
+using common::RingQueue;
 using network::Duration;
 using network::Buffer;
+using network::OutputChain;
 using network::TcpClient;
 using network::TcpClientPtr;
 using network::TcpConnectionPtr;
 using network::EventLoop;
 using network::EventLoopThread;
 using network::ConnectionCallback;
+using network::TlsClientContext;
+using protocol::BulkStringSink;
 using protocol::CodecPtr;
 using protocol::Packet;
 using protocol::PacketUniqPtr;
 
-using RespPacketPtrCallback = std::function<void(const PacketPtr &req, const PacketPtr &resp, int64_t latency_us)>;
+using RespPacketPtrCallback = MoveOnlyFunction<void(const PacketPtr &req, const PacketPtr &resp, int64_t latency_us)>;
 
 class TairBaseClient : private Noncopyable {
 public:
@@ -73,6 +88,49 @@ public:
     void setReconnectIntervalMs(int timeout);
     void setAutoReconnect(bool reconnect);
     void setKeepAliveSeconds(int seconds);
+    void setConnectionPoolSize(int size);
+    void setPoolSelectPolicy(PoolSelectPolicy policy);
+    void setReleaseRequestAfterWrite(bool release);
+    void setZeroCopyThreshold(size_t bytes);
+    // Connect with tls:// through this context unless the server addr already names a scheme,
+    // nullptr keeps plain tcp. Pooled connections share it and so their session cache
+    void setTls(std::shared_ptr<TlsClientContext> context);
+    // Defer connect() to the first request, which waits for the handshake like later ones
+    void setLazyConnect(bool lazy);
+    bool isLazyConnect() const;
+    // SELECT db as part of the connection handshake, 0 skips it
+    void setDatabase(int db);
+    void setFastOpen(bool on);
+    // Requests made while (re)connecting wait in a buffer of at most size entries, and fail once
+    // they have waited timeout_ms. Read only commands lost in flight are replayed once through it
+    void setReconnectBufferSize(size_t size);
+    void setReconnectBufferTimeoutMs(int timeout_ms);
+    // Pooled clients only: a read still unanswered after the p95 latency of this node is sent again on
+    // another connection and the first reply wins. Duplicates are capped at percent of reads, 0 disables
+    void setHedgeBudgetPercent(int percent);
+    // Set before connect, requests over a limit are handled by limits.policy
+    void setRequestLimits(const RequestLimits &limits);
+    const std::shared_ptr<TairRequestLimiter> &getRequestLimiter() const;
+    uint64_t getHedgeCount() const;
+    // Time from starting the last (re)connect to the handshake completing, -1 before the first one
+    int64_t getConnectLatencyUs() const;
+    // Reply latency per command of this node, pooled connections included. Safe from any thread
+    TairClientStats getStats() const;
+    void collectStats(TairStatsBuilder &builder) const;
+    // Set before connect, replies slower than config.threshold_us are kept for getSlowLog()
+    void setSlowLog(const SlowLogConfig &config);
+    // Newest first, at most count entries. Safe from any thread
+    std::vector<SlowRequestEntry> getSlowLog(size_t count) const;
+    // Set before connect, samples one request in config.sample_rate into per window top-K sketches
+    void setHotKeys(const HotKeyConfig &config);
+    HotKeyReport getHotKeys() const;
+    // Set before connect, flags big requests and replies and keeps the largest keys for getBigKeys()
+    void setBigKeys(const BigKeyConfig &config);
+    BigKeyReport getBigKeys() const;
+    // Set before connect, counts requests and bytes per slot for getLoad()
+    void setSlotLoad(bool enable);
+    LoadReport getLoad() const;
+    void collectSlotLoad(std::vector<SlotLoad> &loads) const;
 
     std::future<TairResult<std::string>> connect() EXCLUDES(mutex_);
     void disconnect();
@@ -84,10 +142,12 @@ public:
     void clientSetName(const std::string &name, const ResultStringCallback &callback);
 
 protected:
-    void sendCommandInLoop(const PacketPtr &req, const RespPacketPtrCallback &callback);
-    void sendCommand(const PacketPtr &req, const RespPacketPtrCallback &callback);
-    void sendCommand(CommandArgv &&argv, const RespPacketPtrCallback &callback);
-    void sendCommand(const CommandArgv &argv, const RespPacketPtrCallback &callback);
+    void sendCommandInLoop(const PacketPtr &req, RespPacketPtrCallback &&callback, BulkStringSink &&sink = nullptr);
+    void sendCommand(const PacketPtr &req, RespPacketPtrCallback &&callback, BulkStringSink &&sink = nullptr);
+    // A bulk string reply is streamed into sink and the response carries only its length
+    void sendCommand(CommandArgv &&argv, BulkStringSink &&sink, RespPacketPtrCallback &&callback);
+    void sendCommand(CommandArgv &&argv, RespPacketPtrCallback &&callback);
+    void sendCommand(const CommandArgv &argv, RespPacketPtrCallback &&callback);
 
     virtual void onConnected();
     virtual void onDisconnected() EXCLUDES(mutex_);
@@ -96,11 +156,36 @@ protected:
     void onConnection(const TcpConnectionPtr &conn);
     void onMessage(const TcpConnectionPtr &conn, Buffer *buf);
     void clearCallbacks();
+    void invokeCallback(RespPacketPtrCallback &callback, const PacketPtr &req, const PacketPtr &resp, int64_t latency_us);
+    // Timing of the reply whose callback runs on this thread, only total_us outside of a reply
+    static RequestTiming currentTiming(int64_t latency_us);
 
 private:
     bool doConnect();
-    void authentication();
-    void initEventLoop();
+    bool doConnectPool() EXCLUDES(mutex_);
+    // Loop thread only, keeps the owner's pool_connected_ in step with this pooled connection
+    void setPoolConnected(bool connected);
+    void finishConnect(const TairResult<std::string> &result) EXCLUDES(mutex_);
+    void onPoolClientConnected(const TairResult<std::string> &result) EXCLUDES(mutex_);
+    TairBaseClient *selectPoolClient(const PacketPtr &req);
+    void flushPendingRequests() EXCLUDES(pending_mutex_);
+    // Drops the connections and fails every request not sent yet, then cancels this client's timers
+    void closeInLoop() EXCLUDES(pending_mutex_);
+    void flushConnectingRequests();
+    // Fails them with resp, nullptr reads as disconnected
+    void failConnectingRequests(const PacketPtr &resp = nullptr);
+    void expireConnectingRequests();
+    void armBufferTimer();
+    void cancelBufferTimer();
+    // Fails in flight requests after a disconnect, except idempotent reads which go back to the buffer
+    void replayOrFailCallbacks();
+    static bool isIdempotentRead(const PacketPtr &req);
+    void recordHedgeSample(int64_t latency_us);
+    // AUTH, CLIENT SETNAME and SELECT in one write, connect() completes on the last reply.
+    // Buffered requests go out once it succeeds, a failed AUTH or SELECT fails them and closes the client
+    void sendHandshake();
+    // Stamps the write time of requests whose last byte is now in the socket
+    void onWriteSocket(size_t bytes);
     void clientCron();
     void assertNotInCallbackContext();
 
@@ -113,28 +198,121 @@ protected:
     int reconnect_interval_ms_ = -1;
     bool auto_reconnect_ = true;
     int keepalive_seconds_ = 60;
+    int connection_pool_size_ = 1;
+    PoolSelectPolicy pool_select_policy_ = PoolSelectPolicy::LEAST_INFLIGHT;
+    bool release_request_after_write_ = false;
+    size_t zerocopy_threshold_ = 0;
+    std::shared_ptr<TlsClientContext> tls_context_;
+    bool lazy_connect_ = false;
+    int database_ = 0;
+    bool fast_open_ = false;
+    size_t reconnect_buffer_size_ = 4096;
+    int reconnect_buffer_timeout_ms_ = 2000;
+    int hedge_budget_percent_ = 0;
+    // Shared with the reply callbacks, which may outlive a reconfiguration
+    std::shared_ptr<TairRequestLimiter> limiter_;
 
     // Tcp client resource
     CodecPtr codec_;
+    size_t decode_wait_bytes_ = 0;
     TcpClientPtr tcp_client_;
+    bool has_connected_ = false; // any later connection counts as a reconnect
+    bool handshaking_ = false;   // requests are buffered until the handshake replies are all in
     int64_t reconnect_timer_id_ = -1;
     int64_t last_send_req_time_ms_ = 0;
     int64_t last_recv_resp_time_ms_ = 0;
-    std::unique_ptr<EventLoopThread> loop_thread_;
+    int64_t connect_start_us_ = 0;
+    std::atomic<int64_t> connect_latency_us_ = -1;
     EventLoop *loop_ = nullptr;
 
     struct CallBackContext {
-        CallBackContext(const PacketPtr &r, const RespPacketPtrCallback &cb)
-            : req(r), callback(cb) {}
+        CallBackContext(const PacketPtr &r, RespPacketPtrCallback &&cb)
+            : req(r), callback(std::move(cb)) {}
         int64_t init_time = ClockTime::intervalUs();
         PacketPtr req;
         RespPacketPtrCallback callback;
+        BulkStringSink sink;
+        bool has_sink = false;
+        bool replayed = false;
+        bool hot_key_sampled = false; // keeps req until the reply even when released after write
+        bool big_key_sampled = false; // same
+        int slot = -1;                // set only while slot load is on
+        HdrHistogram *latency_histogram = nullptr; // unset for handshake replies
+        size_t write_offset = 0; // end of the request in the bytes sent on this connection
+        size_t request_bytes = 0;
+        int64_t write_time = 0;
+        int64_t first_byte_time = 0;
+        uint64_t trace_id = 0; // set only while a tair_client probe is attached
     };
     bool in_callback_context_ = false;
-    std::deque<CallBackContext> callbacks_;
+    RingQueue<CallBackContext> callbacks_;
+    CallBackContext popFrontCallback();
+    // Bytes handed to and written by the connection, callbacks_ before written_count_ are in the socket
+    size_t bytes_queued_ = 0;
+    size_t bytes_written_ = 0;
+    size_t written_count_ = 0;
+    static thread_local const RequestTiming *current_timing_;
+
+    // Requests sent from other threads, drained by one loop task per batch
+    struct PendingRequest {
+        PacketPtr req;
+        RespPacketPtrCallback callback;
+        BulkStringSink sink;
+        int64_t init_time = 0; // submit time from other threads, else set once buffered. Kept across a replay
+        bool replayed = false;
+        uint64_t trace_id = 0;
+    };
+    Mutex pending_mutex_;
+    std::vector<PendingRequest> pending_requests_ GUARDED_BY(pending_mutex_);
+    // Loop tasks hold it weakly, reset first thing in the destructor
+    std::shared_ptr<void> alive_ = std::make_shared<char>();
+    // Requests made while no connection is up or authenticated, sent once the handshake succeeds, loop thread only
+    std::vector<PendingRequest> connecting_requests_;
+    int64_t buffer_timer_id_ = -1;
+
+    // Connection pool, each pooled client owns one connection and runs in loop_
+    std::vector<std::unique_ptr<TairBaseClient>> pool_clients_;
+    size_t pool_next_index_ = 0;
+    TairBaseClient *pool_owner_ = nullptr;
+    // Pooled connections up, kept by the pooled clients on the loop thread for isConnected() from any thread
+    std::atomic<int> pool_connected_ = 0;
+    bool pool_counted_ = false; // this pooled client is in its owner's pool_connected_
+
+    // Hedging state of a pool, loop thread only. Every read earns budget percent of credit,
+    // a hedge spends 100, so duplicates stay within budget with a short burst allowance
+    static constexpr size_t kHedgeSampleSize = 1024;
+    static constexpr size_t kHedgeRefreshInterval = 128;
+    static constexpr int kMaxHedgeCredit = 1000;
+    static constexpr int64_t kMinHedgeDelayUs = 1000;
+    std::vector<int64_t> hedge_samples_;
+    size_t hedge_sample_index_ = 0;
+    int64_t hedge_threshold_us_ = -1; // no hedging until the first window is full enough
+    int hedge_credit_ = 0;
+    std::atomic<uint64_t> hedge_count_ = 0;
+    // Armed hedge timers point at pool_clients_, cancelled before the pool goes away
+    std::unordered_set<int64_t> hedge_timer_ids_;
+
+    // Pooled connections record into their owner's, so a node has a single set of histograms
+    TairLatencyRecorder latency_recorder_;
+    std::unique_ptr<TairSlowLog> slow_log_;
+    std::unique_ptr<TairHotKeyDetector> hot_keys_;
+    std::unique_ptr<TairBigKeyDetector> big_keys_;
+    std::unique_ptr<TairSlotLoad> slot_load_;
+    mutable TairLoadTracker load_tracker_;
 
     Mutex mutex_;
     std::unique_ptr<std::promise<TairResult<std::string>>> auth_promise_ GUARDED_BY(mutex_);
+    int pool_connecting_ GUARDED_BY(mutex_) = 0;
+
+private:
+    void sendRequestInLoop(PendingRequest &&request);
+    // Same as the tail of onRecvResponse, with the decode and callback probes around the callback
+    void traceResponse(CallBackContext &ctx, const PacketPtr &resp, const RequestTiming &timing, int64_t now);
+    void recordSlowRequest(const CallBackContext &ctx, const PacketPtr &resp, int64_t write_time, int64_t first_byte_time, int64_t now);
+    void sendHedgedInLoop(PendingRequest &&request);
+    void cancelHedgeTimers();
+    // Holds a request until the connection is up, failing it at once when the buffer is full
+    void bufferRequest(PendingRequest &&request);
 };
 
 } // namespace tair::client
@@ -0,0 +1,113 @@
+/*
+ *  Copyright (c) 2023 Tair
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+#include "client/TairBigKeyDetector.hpp"
+
+#include <algorithm>
+#include <utility>
+
+#include "common/ClockTime.hpp"
+#include "common/Logger.hpp"
+
+namespace tair::client {
+
+using common::ClockTime;
+using common::LockGuard;
+
+static size_t sizeOf(const BigKeyEntry &entry) {
+    return std::max(entry.request_bytes, entry.reply_bytes);
+}
+
+static bool smallerEntry(const std::pair<const std::string, BigKeyEntry> &a, const std::pair<const std::string, BigKeyEntry> &b) {
+    return sizeOf(a.second) < sizeOf(b.second);
+}
+
+TairBigKeyDetector::TairBigKeyDetector(const BigKeyConfig &config)
+    : config_(config), sample_rate_(config.sample_rate) {}
+
+void TairBigKeyDetector::recordRequest(const std::string &node, const std::string &command, const PacketPtr &req, size_t bytes) {
+    auto key = TairRequestKey::extractKey(req);
+    if (config_.log) {
+        LOG_WARN("TairClient big request to {}, command: {}, key: {}, bytes: {}", node, command, key.name, bytes);
+    }
+    LockGuard lock(mutex_);
+    commands_[command].big_requests++;
+    addLargest(node, command, key, bytes, 0);
+}
+
+void TairBigKeyDetector::recordReply(const std::string &node, const std::string &command, const PacketPtr &req,
+                                     size_t request_bytes, size_t reply_bytes, bool sampled) {
+    bool big = isBigReply(reply_bytes);
+    auto key = TairRequestKey::extractKey(req);
+    if (config_.log && big) {
+        LOG_WARN("TairClient big reply from {}, command: {}, key: {}, bytes: {}", node, command, key.name, reply_bytes);
+    }
+    LockGuard lock(mutex_);
+    auto &stats = commands_[command];
+    if (sampled) {
+        stats.count += sample_rate_;
+        stats.request_bytes += request_bytes * sample_rate_;
+        stats.reply_bytes += reply_bytes * sample_rate_;
+        stats.max_request_bytes = std::max(stats.max_request_bytes, request_bytes);
+        stats.max_reply_bytes = std::max(stats.max_reply_bytes, reply_bytes);
+    }
+    if (big) {
+        stats.big_replies++;
+    }
+    addLargest(node, command, key, request_bytes, reply_bytes);
+}
+
+void TairBigKeyDetector::addLargest(const std::string &node, const std::string &command, const RequestKey &key,
+                                    size_t request_bytes, size_t reply_bytes) {
+    size_t size = std::max(request_bytes, reply_bytes);
+    if (key.name.empty() || config_.top_k == 0 || (largest_.size() >= config_.top_k && size <= largest_min_)) {
+        return;
+    }
+    auto it = largest_.find(key.name);
+    if (it != largest_.end()) {
+        // The reply of a flagged request is as large, it fills in reply_bytes
+        if (size < sizeOf(it->second)) {
+            return;
+        }
+    } else if (largest_.size() >= config_.top_k) {
+        largest_.erase(std::min_element(largest_.begin(), largest_.end(), smallerEntry));
+    }
+    largest_[key.name] = BigKeyEntry{key.name, command, key.slot, node, request_bytes, reply_bytes, ClockTime::nowUs()};
+    if (largest_.size() >= config_.top_k) {
+        largest_min_ = sizeOf(std::min_element(largest_.begin(), largest_.end(), smallerEntry)->second);
+    }
+}
+
+BigKeyReport TairBigKeyDetector::getReport() const {
+    BigKeyReport report;
+    LockGuard lock(mutex_);
+    report.commands = commands_;
+    report.largest.reserve(largest_.size());
+    for (const auto &[_, entry] : largest_) {
+        report.largest.push_back(entry);
+    }
+    std::sort(report.largest.begin(), report.largest.end(), [](const BigKeyEntry &a, const BigKeyEntry &b) {
+        return sizeOf(a) > sizeOf(b);
+    });
+    return report;
+}
+
+} // namespace tair::client
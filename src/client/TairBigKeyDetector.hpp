@@ -0,0 +1,86 @@
+/*
+ *  Copyright (c) 2023 Tair
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+
+#include "common/Mutex.hpp"
+#include "common/Noncopyable.hpp"
+#include "client/TairClientDefine.hpp"
+#include "client/TairRequestKey.hpp"
+
+namespace tair::client {
+
+using common::Mutex;
+using common::Noncopyable;
+
+// Request and reply sizes of one node per command, with the largest keys seen.
+// Flagging looks at every request and reply, the per command sizes at sampled ones only
+class TairBigKeyDetector : private Noncopyable {
+public:
+    explicit TairBigKeyDetector(const BigKeyConfig &config);
+    ~TairBigKeyDetector() = default;
+
+    // Loop thread only, true once every sample_rate calls
+    bool shouldSample() {
+        if (sample_rate_ <= 0 || ++since_sample_ < sample_rate_) {
+            return false;
+        }
+        since_sample_ = 0;
+        return true;
+    }
+
+    bool isBigRequest(size_t bytes) const {
+        return config_.request_threshold_bytes > 0 && bytes >= config_.request_threshold_bytes;
+    }
+
+    bool isBigReply(size_t bytes) const {
+        return config_.reply_threshold_bytes > 0 && bytes >= config_.reply_threshold_bytes;
+    }
+
+    // Called once the request is encoded, only for big ones
+    void recordRequest(const std::string &node, const std::string &command, const PacketPtr &req, size_t bytes) EXCLUDES(mutex_);
+    // Called for sampled and big replies, req is empty when released after write
+    void recordReply(const std::string &node, const std::string &command, const PacketPtr &req,
+                     size_t request_bytes, size_t reply_bytes, bool sampled) EXCLUDES(mutex_);
+    BigKeyReport getReport() const EXCLUDES(mutex_);
+
+private:
+    void addLargest(const std::string &node, const std::string &command, const RequestKey &key,
+                    size_t request_bytes, size_t reply_bytes) REQUIRES(mutex_);
+
+    const BigKeyConfig config_;
+    int sample_rate_;
+    int since_sample_ = 0;
+
+    mutable Mutex mutex_;
+    std::map<std::string, CommandSizeStats> commands_ GUARDED_BY(mutex_);
+    // At most top_k keys, largest_min_ is the smallest size among them once full
+    std::unordered_map<std::string, BigKeyEntry> largest_ GUARDED_BY(mutex_);
+    size_t largest_min_ GUARDED_BY(mutex_) = 0;
+};
+
+} // namespace tair::client
@@ -23,11 +23,15 @@
 
 #include "client/TairAsyncClient.hpp"
 #include "client/TairClusterAsyncClient.hpp"
+#include "client/TairClientMetrics.hpp"
 
 #include "common/Logger.hpp"
+#include "network/TlsOptions.hpp"
 
 namespace tair::client {
 
+using network::TlsClientContext;
+
 TairClient::~TairClient() {
     destroy();
 }
@@ -48,6 +52,14 @@ TairResult<std::string> TairClient::init(const TairURI &uri) {
     if (type == TairURI::STANDALONE && server_addrs.size() != 1) {
         return TairResult<std::string>::createErr("STANDALONE mode not support multi addrs");
     }
+    std::shared_ptr<TlsClientContext> tls_context;
+    if (uri.isTlsEnabled()) {
+        // Per client, its SNI name and session cache only apply to its own servers
+        tls_context = TlsClientContext::create(uri.getTlsConfig());
+        if (!tls_context) {
+            return TairResult<std::string>::createErr("tls client config failed");
+        }
+    }
     auto result = TairResult<std::string>::createErr("server_addrs is empty");
     for (const auto &server_addr : server_addrs) {
         if (server_addr.empty()) {
@@ -57,6 +69,22 @@ TairResult<std::string> TairClient::init(const TairURI &uri) {
         itair_->setConnectingTimeoutMs(uri.getConnectingTimeoutMs());
         itair_->setReconnectIntervalMs(uri.getReconnectIntervalMs());
         itair_->setAutoReconnect(uri.isAutoReconnect());
+        itair_->setConnectionPoolSize(uri.getConnectionPoolSize());
+        itair_->setPoolSelectPolicy(uri.getPoolSelectPolicy());
+        itair_->setReleaseRequestAfterWrite(uri.isReleaseRequestAfterWrite());
+        itair_->setZeroCopyThreshold(uri.getZeroCopyThreshold());
+        itair_->setTls(tls_context);
+        itair_->setLazyConnect(uri.isLazyConnect());
+        itair_->setDatabase(uri.getDatabase());
+        itair_->setFastOpen(uri.isFastOpen());
+        itair_->setReconnectBufferSize(uri.getReconnectBufferSize());
+        itair_->setReconnectBufferTimeoutMs(uri.getReconnectBufferTimeoutMs());
+        itair_->setHedgeBudgetPercent(uri.getHedgeBudgetPercent());
+        itair_->setRequestLimits(uri.getRequestLimits());
+        itair_->setSlowLog(uri.getSlowLogConfig());
+        itair_->setHotKeys(uri.getHotKeyConfig());
+        itair_->setBigKeys(uri.getBigKeyConfig());
+        itair_->setSlotLoad(uri.isSlotLoad());
         if (!uri.getUser().empty()) {
             itair_->setUser(uri.getUser());
         }
@@ -83,6 +111,48 @@ TairClientWrapper TairClient::getFutureWrapper() {
     return TairClientWrapper(*this);
 }
 
+TairClientStats TairClient::getStats() const {
+    if (!itair_) {
+        return {};
+    }
+    return itair_->getStats();
+}
+
+HotKeyReport TairClient::getHotKeys() const {
+    if (!itair_) {
+        return {};
+    }
+    return itair_->getHotKeys();
+}
+
+BigKeyReport TairClient::getBigKeys() const {
+    if (!itair_) {
+        return {};
+    }
+    return itair_->getBigKeys();
+}
+
+LoadReport TairClient::getLoad() const {
+    if (!itair_) {
+        return {};
+    }
+    return itair_->getLoad();
+}
+
+void TairClient::collectMetrics(const std::string &name, common::MetricSet &metrics) const {
+    if (!itair_) {
+        return;
+    }
+    TairClientMetrics::collect(name, itair_->getStats(), metrics);
+}
+
+std::vector<SlowRequestEntry> TairClient::getSlowLog(size_t count) const {
+    if (!itair_) {
+        return {};
+    }
+    return itair_->getSlowLog(count);
+}
+
 // -------------------------------- send Command --------------------------------
 void TairClient::sendCommand(CommandArgv &&argv, const ResultPacketCallback &callback) {
     if (!itair_) {
@@ -116,6 +186,22 @@ void TairClient::sendCommand(const CommandArgv &argv, const ResultPacketAndLaten
     }
 }
 
+void TairClient::sendCommand(CommandArgv &&argv, const ResultPacketAndTimingCallback &callback) {
+    if (!itair_) {
+        callback(nullptr, nullptr, nullptr, 0, {});
+    } else {
+        itair_->sendCommand(std::move(argv), callback);
+    }
+}
+
+void TairClient::sendCommand(const CommandArgv &argv, const ResultPacketAndTimingCallback &callback) {
+    if (!itair_) {
+        callback(nullptr, nullptr, nullptr, 0, {});
+    } else {
+        itair_->sendCommand(argv, callback);
+    }
+}
+
 // -------------------------------- Generic Command --------------------------------
 void TairClient::del(const std::string &key, const ResultIntegerCallback &callback) {
     if (!itair_) {
@@ -536,6 +622,14 @@ void TairClient::set(const std::string &key, const std::string &value, const Res
     }
 }
 
+void TairClient::set(const std::string &key, std::shared_ptr<const std::string> value, const ResultStringCallback &callback) {
+    if (!itair_) {
+        callback(TairResult<std::string>::createErr(E_NOT_INIT));
+    } else {
+        itair_->set(key, std::move(value), callback);
+    }
+}
+
 void TairClient::get(const std::string &key, const ResultStringPtrCallback &callback) {
     if (!itair_) {
         callback(TairResult<std::shared_ptr<std::string>>::createErr(E_NOT_INIT));
@@ -544,6 +638,14 @@ void TairClient::get(const std::string &key, const ResultStringPtrCallback &call
     }
 }
 
+void TairClient::getToSink(const std::string &key, const BulkStringSink &sink, const ResultIntegerPtrCallback &callback) {
+    if (!itair_) {
+        callback(TairResult<std::shared_ptr<int64_t>>::createErr(E_NOT_INIT));
+    } else {
+        itair_->getToSink(key, sink, callback);
+    }
+}
+
 void TairClient::incr(const std::string &key, const ResultIntegerCallback &callback) {
     if (!itair_) {
         callback(TairResult<int64_t>::createErr(E_NOT_INIT));
@@ -26,6 +26,10 @@
 #include "client/TairURI.hpp"
 #include "client/params/ParamsAll.hpp"
 
+namespace tair::common {
+class MetricSet;
+} // namespace tair::common
+
 namespace tair::client {
 
 class ITairClient;
@@ -59,6 +63,30 @@ public:
     /// @brief Return TairClientWrapper for Future Mode API
     TairClientWrapper getFutureWrapper();
 
+    /// @brief Reply latencies recorded so far, per command and per node.
+    /// @return count, avg, max and p50/p99/p999 in microseconds, empty before `init`.
+    TairClientStats getStats() const;
+
+    /// @brief Replies slower than the threshold set by `TairURIBuilder::slowLog`.
+    /// @param count Most entries to return, newest first.
+    std::vector<SlowRequestEntry> getSlowLog(size_t count = 128) const;
+
+    /// @brief Heaviest keys by request count and by bytes, sampled as set by `TairURIBuilder::hotKeys`.
+    /// @return The last finished window, empty when sampling is off.
+    HotKeyReport getHotKeys() const;
+
+    /// @brief Request and reply sizes per command and the largest keys, as set by `TairURIBuilder::bigKeys`.
+    /// @return Totals since connect, empty when detection is off.
+    BigKeyReport getBigKeys() const;
+
+    /// @brief Per slot requests and bytes, as set by `TairURIBuilder::slotLoad`, and per node rates and latency.
+    /// @return Rates cover the time since the previous call, `TairLoadTracker::dump` prints it compactly.
+    LoadReport getLoad() const;
+
+    /// @brief Add request counters and latencies to a scrape, e.g. from a `MetricsRegistry` collector.
+    /// @param name Value of the client label, tells clients of one process apart.
+    void collectMetrics(const std::string &name, common::MetricSet &metrics) const;
+
     // -------------------------------- send Command --------------------------------
     void sendCommand(CommandArgv &&argv, const ResultPacketCallback &callback);
     void sendCommand(const CommandArgv &argv, const ResultPacketCallback &callback);
@@ -66,6 +94,9 @@ public:
     void sendCommand(CommandArgv &&argv, const ResultPacketAndLatencyCallback &callback);
     void sendCommand(const CommandArgv &argv, const ResultPacketAndLatencyCallback &callback);
 
+    void sendCommand(CommandArgv &&argv, const ResultPacketAndTimingCallback &callback);
+    void sendCommand(const CommandArgv &argv, const ResultPacketAndTimingCallback &callback);
+
     // -------------------------------- Generic Command --------------------------------
     /// @brief Delete a key.
     /// @param key The key.
@@ -174,12 +205,15 @@ public:
     /// @param OK If the key has been set.
     /// @param other errors means fail.
     void set(const std::string &key, const std::string &value, const ResultStringCallback &callback);
+    void set(const std::string &key, std::shared_ptr<const std::string> value, const ResultStringCallback &callback);
 
     /// @brief Get value by key.
     /// @param key The key.
     /// @param callback The string callback.
     /// @param callback The result value.
     void get(const std::string &key, const ResultStringPtrCallback &callback);
+    // Stream the value into sink instead of buffering it, the result is the value length or null
+    void getToSink(const std::string &key, const BulkStringSink &sink, const ResultIntegerPtrCallback &callback);
     void incr(const std::string &key, const ResultIntegerCallback &callback);
     void incrby(const std::string &key, int64_t increment, const ResultIntegerCallback &callback);
     void incrbyfloat(const std::string &key, double increment, const ResultStringCallback &callback);
@@ -23,6 +23,7 @@
 
 #include <functional>
 #include <initializer_list>
+#include <map>
 #include <memory>
 #include <optional>
 #include <string>
@@ -37,6 +38,7 @@
 namespace tair::client {
 
 using protocol::PacketPtr;
+using protocol::BulkStringSink;
 
 using CommandArgv = std::vector<std::string>;
 
@@ -61,8 +63,188 @@ using ResultXPendingCallback = Function<void(const TairResult<XPendingResult> &)
 using ResultXRangeCallback = Function<void(const TairResult<std::vector<XRangeResult>> &)>;
 using ResultXreadCallback = Function<void(const TairResult<std::vector<XReadResult>> &)>;
 
+// Where the latency of one request went, in microseconds, total_us = queue_us + network_us + decode_us.
+// queue_us runs from the send call until the request's last byte is written to the socket, so it holds
+// the hop to the client loop, reconnect buffering and output backlog. network_us runs until the first
+// byte of the reply is read, covering the round trip and the server. decode_us is the rest of the reply
+struct RequestTiming {
+    int64_t queue_us = 0;
+    int64_t network_us = 0;
+    int64_t decode_us = 0;
+    int64_t total_us = 0;
+};
+
 class ITairClient;
 using ResultPacketCallback = std::function<void(ITairClient *client, const PacketPtr &req, const PacketPtr &resp)>;
 using ResultPacketAndLatencyCallback = std::function<void(ITairClient *client, const PacketPtr &req, const PacketPtr &resp, int64_t latency_us)>;
+// Requests failing without a reply only have timing.total_us set
+using ResultPacketAndTimingCallback = std::function<void(ITairClient *client, const PacketPtr &req, const PacketPtr &resp, int64_t latency_us, const RequestTiming &timing)>;
+
+// How a request picks a connection when a node has a connection pool
+enum class PoolSelectPolicy {
+    LEAST_INFLIGHT, // connection with the fewest outstanding requests
+    ROUND_ROBIN,    // rotate over the connected connections
+    KEY_STICKY,     // same key always uses the same connection, keeps per-key ordering
+};
+
+// What a client does with a request that would break one of its RequestLimits
+enum class LimitPolicy {
+    BLOCK,        // wait in the calling thread, fails fast instead when called on the client loop
+    FAIL_FAST,    // complete the request at once with a client side error
+    BACKPRESSURE, // send anyway and report the overload through backpressure_callback
+};
+
+// Client side admission limits, 0 means unlimited
+struct RequestLimits {
+    size_t max_inflight = 0;
+    size_t max_inflight_bytes = 0;
+    int64_t max_qps = 0;
+    LimitPolicy policy = LimitPolicy::FAIL_FAST;
+    // AIMD on the in-flight cap within [1, max_inflight]: a reply slower than this cuts the cap,
+    // faster ones grow it back by one per window. 0 keeps the cap fixed
+    int64_t target_latency_us = 0;
+    // Called with true when a limit is first exceeded and with false once the client is back under it
+    Function<void(bool overloaded)> backpressure_callback;
+};
+
+// Client side slow log, a threshold of 0 turns it off
+struct SlowLogConfig {
+    int64_t threshold_us = 0;
+    size_t capacity = 128; // entries kept per node, the oldest go first
+    bool log = false;      // also write every entry to the log as a warning
+};
+
+// A reply that took at least SlowLogConfig::threshold_us. Stage times are wall clock microseconds
+struct SlowRequestEntry {
+    uint64_t id = 0; // grows by one per entry of a node
+    std::string node;
+    std::string command; // lowercase
+    std::string key;     // first argument, cut at 128 bytes, empty when released after write
+    int slot = -1;
+    size_t request_bytes = 0;
+    size_t reply_bytes = 0;
+    int64_t submit_us = 0;
+    int64_t write_us = 0;
+    int64_t first_byte_us = 0;
+    int64_t callback_us = 0;
+};
+
+// Client side hot key sampling, a sample_rate of 0 turns it off
+struct HotKeyConfig {
+    int sample_rate = 0; // one request in sample_rate feeds the sketch
+    size_t top_k = 16;   // keys reported per window, by count and by bytes
+    int64_t window_ms = 10000;
+    bool log = false; // write the top keys of every finished window to the log
+};
+
+// A key among the heaviest of a window, counts are scaled up by the sample rate
+struct HotKeyEntry {
+    std::string key; // first argument, cut at 128 bytes
+    int slot = -1;
+    std::string node;
+    uint64_t count = 0;
+    uint64_t bytes = 0; // request plus reply
+};
+
+struct HotKeyReport {
+    int64_t window_start_us = 0; // wall clock
+    int64_t window_end_us = 0;
+    std::vector<HotKeyEntry> by_count;
+    std::vector<HotKeyEntry> by_bytes;
+};
+
+struct BigKeyConfig {
+    size_t reply_threshold_bytes = 0;   // every reply at least this large is flagged, 0 to not flag
+    size_t request_threshold_bytes = 0; // every request at least this large is flagged, 0 to not flag
+    int sample_rate = 0;                // one request in sample_rate feeds the per command sizes, 0 to not sample
+    size_t top_k = 16;                  // largest keys kept per node
+    bool log = false;                   // write every flagged request and reply to the log as a warning
+};
+
+// Sampled counts and sums are scaled by sample_rate, the big_ counts are exact
+struct CommandSizeStats {
+    uint64_t count = 0;
+    uint64_t request_bytes = 0;
+    uint64_t reply_bytes = 0;
+    size_t max_request_bytes = 0;
+    size_t max_reply_bytes = 0;
+    uint64_t big_requests = 0;
+    uint64_t big_replies = 0;
+};
+
+struct BigKeyEntry {
+    std::string key; // first argument, cut at 128 bytes
+    std::string command;
+    int slot = -1;
+    std::string node;
+    size_t request_bytes = 0;
+    size_t reply_bytes = 0; // 0 until the reply of that request is seen
+    int64_t seen_us = 0;    // wall clock
+};
+
+struct BigKeyReport {
+    std::map<std::string, CommandSizeStats> commands; // lowercase command name
+    std::vector<BigKeyEntry> largest;                 // by the larger of request_bytes and reply_bytes
+};
+
+// Reply latency summary, percentiles are within 1% of the recorded value
+struct LatencyStats {
+    uint64_t count = 0;
+    uint64_t sum_us = 0; // exact, avg_us is rounded down
+    uint64_t avg_us = 0;
+    uint64_t max_us = 0;
+    double p50_us = 0;
+    double p99_us = 0;
+    double p999_us = 0;
+};
+
+// The phases of RequestTiming over many replies
+struct PhaseStats {
+    LatencyStats queue;
+    LatencyStats network;
+    LatencyStats decode;
+};
+
+// Requests of one node since the client was created
+struct NodeCounters {
+    uint64_t requests = 0; // written to the connection, a replayed request counts again
+    uint64_t errors = 0;   // error replies and requests failed without a reply
+    uint64_t inflight = 0; // written and waiting for the reply
+    uint64_t reconnects = 0;
+    uint64_t redirects = 0; // MOVED and ASK replies
+};
+
+// Snapshot of the latencies recorded since the client was created
+struct TairClientStats {
+    LatencyStats total;
+    std::map<std::string, LatencyStats> commands; // lowercase command name, over all nodes
+    std::map<std::string, LatencyStats> nodes;    // node address, over all commands
+    PhaseStats phases;
+    std::map<std::string, PhaseStats> node_phases;
+    std::map<std::string, NodeCounters> counters; // node address
+};
+
+// Totals since connect of the requests sent to one slot through one node
+struct SlotLoad {
+    int slot = -1;
+    std::string node;
+    uint64_t requests = 0;
+    uint64_t request_bytes = 0;
+    uint64_t reply_bytes = 0;
+};
+
+struct NodeLoad {
+    uint64_t requests = 0; // since connect
+    uint64_t errors = 0;
+    double qps = 0;        // since the previous report
+    double error_rate = 0; // errors per request since the previous report
+    LatencyStats latency;  // since connect
+};
+
+struct LoadReport {
+    int64_t interval_us = 0;     // since the previous report, covered by qps and error_rate
+    std::vector<SlotLoad> slots; // slots with any request, by slot
+    std::map<std::string, NodeLoad> nodes;
+};
 
 } // namespace tair::client
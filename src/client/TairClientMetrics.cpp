@@ -0,0 +1,56 @@
+/*
+ *  Copyright (c) 2023 Tair
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+#include "client/TairClientMetrics.hpp"
+
+namespace tair::client {
+
+void TairClientMetrics::addLatency(MetricSet &metrics, const std::string &name, const std::string &help,
+                                   const common::MetricLabels &labels, const LatencyStats &stats) {
+    constexpr double kUsPerSecond = 1e6;
+    metrics.addSummary(name, help, labels, stats.count, stats.sum_us / kUsPerSecond,
+                       {{0.5, stats.p50_us / kUsPerSecond}, {0.99, stats.p99_us / kUsPerSecond}, {0.999, stats.p999_us / kUsPerSecond}});
+}
+
+void TairClientMetrics::collect(const std::string &client, const TairClientStats &stats, MetricSet &metrics) {
+    for (const auto &[node, counters] : stats.counters) {
+        common::MetricLabels labels = {{"client", client}, {"node", node}};
+        metrics.addCounter("tair_client_requests", "Requests written to the node", labels, counters.requests);
+        metrics.addCounter("tair_client_errors", "Error replies and requests failed without a reply", labels, counters.errors);
+        metrics.addGauge("tair_client_inflight_requests", "Requests waiting for their reply", labels, counters.inflight);
+        metrics.addCounter("tair_client_reconnects", "Connections re-established to the node", labels, counters.reconnects);
+        metrics.addCounter("tair_client_redirects", "MOVED and ASK replies", labels, counters.redirects);
+    }
+    for (const auto &[node, latency] : stats.nodes) {
+        addLatency(metrics, "tair_client_node_latency_seconds", "Reply latency per node", {{"client", client}, {"node", node}}, latency);
+    }
+    for (const auto &[command, latency] : stats.commands) {
+        addLatency(metrics, "tair_client_command_latency_seconds", "Reply latency per command", {{"client", client}, {"command", command}}, latency);
+    }
+    for (const auto &[node, phases] : stats.node_phases) {
+        const char *help = "Time of a request spent queued, on the network and decoding";
+        addLatency(metrics, "tair_client_phase_latency_seconds", help, {{"client", client}, {"node", node}, {"phase", "queue"}}, phases.queue);
+        addLatency(metrics, "tair_client_phase_latency_seconds", help, {{"client", client}, {"node", node}, {"phase", "network"}}, phases.network);
+        addLatency(metrics, "tair_client_phase_latency_seconds", help, {{"client", client}, {"node", node}, {"phase", "decode"}}, phases.decode);
+    }
+}
+
+} // namespace tair::client
@@ -251,10 +251,18 @@ std::future<TairResult<std::string>> TairClientWrapper::set(const std::string &k
     FUTURE_CALL(TairResult<std::string>, set, key, value);
 }
 
+std::future<TairResult<std::string>> TairClientWrapper::set(const std::string &key, std::shared_ptr<const std::string> value) {
+    FUTURE_CALL(TairResult<std::string>, set, key, std::move(value));
+}
+
 std::future<TairResult<std::shared_ptr<std::string>>> TairClientWrapper::get(const std::string &key) {
     FUTURE_CALL(TairResult<std::shared_ptr<std::string>>, get, key);
 }
 
+std::future<TairResult<std::shared_ptr<int64_t>>> TairClientWrapper::getToSink(const std::string &key, const BulkStringSink &sink) {
+    FUTURE_CALL(TairResult<std::shared_ptr<int64_t>>, getToSink, key, sink);
+}
+
 std::future<TairResult<int64_t>> TairClientWrapper::incr(const std::string &key) {
     FUTURE_CALL(TairResult<int64_t>, incr, key);
 }
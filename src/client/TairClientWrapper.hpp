@@ -98,7 +98,9 @@ public:
     std::future<TairResult<std::shared_ptr<std::string>>> getset(const std::string &key, const std::string &value);
     std::future<TairResult<std::string>> set(const std::string &key, const std::string &value, const SetParams &params);
     std::future<TairResult<std::string>> set(const std::string &key, const std::string &value);
+    std::future<TairResult<std::string>> set(const std::string &key, std::shared_ptr<const std::string> value);
     std::future<TairResult<std::shared_ptr<std::string>>> get(const std::string &key);
+    std::future<TairResult<std::shared_ptr<int64_t>>> getToSink(const std::string &key, const BulkStringSink &sink);
     std::future<TairResult<int64_t>> incr(const std::string &key);
     std::future<TairResult<int64_t>> incrby(const std::string &key, int64_t increment);
     std::future<TairResult<std::string>> incrbyfloat(const std::string &key, double increment);
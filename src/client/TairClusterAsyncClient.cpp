@@ -21,10 +21,17 @@
  */
 #include "client/TairClusterAsyncClient.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <future>
+#include <iterator>
+#include <vector>
+
 #include "common/ClockTime.hpp"
 #include "common/StringUtil.hpp"
-#include "network/EventLoopThread.hpp"
+#include "protocol/packet/resp/ErrorPacket.hpp"
 #include "client/TairResultHelper.hpp"
+#include "client/TairTracepoints.hpp"
 
 #include "absl/strings/numbers.h"
 
@@ -33,42 +40,31 @@ namespace tair::client {
 using common::ClockTime;
 using common::StringUtil;
 using protocol::BulkStringPacket;
+using protocol::ErrorPacket;
 using protocol::IntegerPacket;
 using protocol::SimpleStringPacket;
 using client::TairResultHelper;
 
 using absl::SimpleAtoi;
 
-TairClusterAsyncClient::TairClusterAsyncClient() {
-    initEventLoop();
-}
+TairClusterAsyncClient::TairClusterAsyncClient() = default;
 
 TairClusterAsyncClient::TairClusterAsyncClient(EventLoop *loop) {
+    // Without a loop, each node client picks its own loop from the shared pool
     loop_ = loop;
-    if (!loop_) {
-        initEventLoop();
-    }
 }
 
 TairClusterAsyncClient::~TairClusterAsyncClient() {
     destroy();
-    if (loop_thread_) {
-        loop_thread_->stop();
-        loop_thread_->join();
-        loop_thread_.reset();
-    }
-}
-
-void TairClusterAsyncClient::initEventLoop() {
-    loop_thread_ = std::make_unique<EventLoopThread>("client-io");
-    loop_thread_->start();
-    loop_ = loop_thread_->loop();
 }
 
 TairResult<std::string> TairClusterAsyncClient::init() {
     TairResult<std::string> result;
     auto client = createClient(server_addr_);
-    if (!client) {
+    auto seed_result = client->connect().get();
+    if (!seed_result.isSuccess()) {
+        LOG_ERROR("FATAL: connect to server failed: {}", seed_result.getErr());
+        client_map_.clear();
         result.setErr("connect to server failed");
         return result;
     }
@@ -84,9 +80,15 @@ TairResult<std::string> TairClusterAsyncClient::init() {
         return result;
     }
     if (!checkSlotToClients()) {
+        destroy();
         result.setErr("some slots are not initialized");
         return result;
     }
+    if (!connectClients(client)) {
+        destroy();
+        result.setErr("connect to cluster nodes failed");
+        return result;
+    }
 
     result.setValue("ok");
     return result;
@@ -132,10 +134,158 @@ void TairClusterAsyncClient::setKeepAliveSeconds(int seconds) {
     keepalive_seconds_ = seconds;
 }
 
-bool TairClusterAsyncClient::checkResultHasClusterError(const PacketPtr &resp) {
+void TairClusterAsyncClient::setConnectionPoolSize(int size) {
+    connection_pool_size_ = size;
+}
+
+void TairClusterAsyncClient::setPoolSelectPolicy(PoolSelectPolicy policy) {
+    pool_select_policy_ = policy;
+}
+
+void TairClusterAsyncClient::setReleaseRequestAfterWrite(bool release) {
+    release_request_after_write_ = release;
+}
+
+void TairClusterAsyncClient::setZeroCopyThreshold(size_t bytes) {
+    zerocopy_threshold_ = bytes;
+}
+
+void TairClusterAsyncClient::setTls(std::shared_ptr<TlsClientContext> context) {
+    tls_context_ = std::move(context);
+}
+
+void TairClusterAsyncClient::setLazyConnect(bool lazy) {
+    lazy_connect_ = lazy;
+}
+
+void TairClusterAsyncClient::setDatabase(int db) {
+    database_ = db;
+}
+
+void TairClusterAsyncClient::setFastOpen(bool on) {
+    fast_open_ = on;
+}
+
+void TairClusterAsyncClient::setReconnectBufferSize(size_t size) {
+    reconnect_buffer_size_ = size;
+}
+
+void TairClusterAsyncClient::setReconnectBufferTimeoutMs(int timeout_ms) {
+    reconnect_buffer_timeout_ms_ = timeout_ms;
+}
+
+void TairClusterAsyncClient::setHedgeBudgetPercent(int percent) {
+    hedge_budget_percent_ = percent;
+}
+
+void TairClusterAsyncClient::setRequestLimits(const RequestLimits &limits) {
+    request_limits_ = limits;
+}
+
+TairClientStats TairClusterAsyncClient::getStats() const {
+    TairStatsBuilder builder;
+    for (const auto &[_, client] : client_map_) {
+        client->collectStats(builder);
+    }
+    return builder.build();
+}
+
+void TairClusterAsyncClient::setSlowLog(const SlowLogConfig &config) {
+    slow_log_config_ = config;
+}
+
+std::vector<SlowRequestEntry> TairClusterAsyncClient::getSlowLog(size_t count) const {
+    std::vector<SlowRequestEntry> entries;
+    for (const auto &[_, client] : client_map_) {
+        auto node_entries = client->getSlowLog(count);
+        entries.insert(entries.end(), std::make_move_iterator(node_entries.begin()), std::make_move_iterator(node_entries.end()));
+    }
+    std::sort(entries.begin(), entries.end(), [](const SlowRequestEntry &a, const SlowRequestEntry &b) {
+        return a.callback_us > b.callback_us;
+    });
+    entries.resize(std::min(count, entries.size()));
+    return entries;
+}
+
+void TairClusterAsyncClient::setHotKeys(const HotKeyConfig &config) {
+    hot_key_config_ = config;
+}
+
+HotKeyReport TairClusterAsyncClient::getHotKeys() const {
+    HotKeyReport report;
+    for (const auto &[_, client] : client_map_) {
+        auto node_report = client->getHotKeys();
+        if (node_report.window_end_us == 0) {
+            continue;
+        }
+        if (report.window_end_us == 0 || node_report.window_start_us < report.window_start_us) {
+            report.window_start_us = node_report.window_start_us;
+        }
+        report.window_end_us = std::max(report.window_end_us, node_report.window_end_us);
+        std::move(node_report.by_count.begin(), node_report.by_count.end(), std::back_inserter(report.by_count));
+        std::move(node_report.by_bytes.begin(), node_report.by_bytes.end(), std::back_inserter(report.by_bytes));
+    }
+    std::sort(report.by_count.begin(), report.by_count.end(), [](const HotKeyEntry &a, const HotKeyEntry &b) {
+        return a.count > b.count;
+    });
+    std::sort(report.by_bytes.begin(), report.by_bytes.end(), [](const HotKeyEntry &a, const HotKeyEntry &b) {
+        return a.bytes > b.bytes;
+    });
+    report.by_count.resize(std::min(hot_key_config_.top_k, report.by_count.size()));
+    report.by_bytes.resize(std::min(hot_key_config_.top_k, report.by_bytes.size()));
+    return report;
+}
+
+void TairClusterAsyncClient::setBigKeys(const BigKeyConfig &config) {
+    big_key_config_ = config;
+}
+
+BigKeyReport TairClusterAsyncClient::getBigKeys() const {
+    BigKeyReport report;
+    for (const auto &[_, client] : client_map_) {
+        auto node_report = client->getBigKeys();
+        for (const auto &[command, node_stats] : node_report.commands) {
+            auto &stats = report.commands[command];
+            stats.count += node_stats.count;
+            stats.request_bytes += node_stats.request_bytes;
+            stats.reply_bytes += node_stats.reply_bytes;
+            stats.max_request_bytes = std::max(stats.max_request_bytes, node_stats.max_request_bytes);
+            stats.max_reply_bytes = std::max(stats.max_reply_bytes, node_stats.max_reply_bytes);
+            stats.big_requests += node_stats.big_requests;
+            stats.big_replies += node_stats.big_replies;
+        }
+        std::move(node_report.largest.begin(), node_report.largest.end(), std::back_inserter(report.largest));
+    }
+    std::sort(report.largest.begin(), report.largest.end(), [](const BigKeyEntry &a, const BigKeyEntry &b) {
+        return std::max(a.request_bytes, a.reply_bytes) > std::max(b.request_bytes, b.reply_bytes);
+    });
+    report.largest.resize(std::min(big_key_config_.top_k, report.largest.size()));
+    return report;
+}
+
+void TairClusterAsyncClient::setSlotLoad(bool enable) {
+    slot_load_ = enable;
+}
+
+LoadReport TairClusterAsyncClient::getLoad() const {
+    std::vector<SlotLoad> slots;
+    for (const auto &[_, client] : client_map_) {
+        client->collectSlotLoad(slots);
+    }
+    return load_tracker_.build(std::move(slots), getStats());
+}
+
+bool TairClusterAsyncClient::checkResultHasClusterError(ITairClient *client, const PacketPtr &req, const PacketPtr &resp) {
     // Check for ask or moved errors here.
     // But it is not implemented now.
     // The upper layer code is required to reinitialize the client.
+    if (TRACING_SDT_IS_ENABLED(tair_client, cluster_redirect) && resp) {
+        auto *error = resp->packet_cast<ErrorPacket>();
+        if (error && (error->getValue().starts_with("MOVED ") || error->getValue().starts_with("ASK "))) {
+            TRACING_SDT_WITH_SEMAPHORE(tair_client, cluster_redirect, TairTracepoints::commandName(req),
+                                       client->getServerAddr().c_str(), error->getValue().c_str());
+        }
+    }
     return false;
 }
 
@@ -208,10 +358,6 @@ bool TairClusterAsyncClient::parseNodesInfoAndInitClient(std::string &nodes_info
             return false;
         }
         auto client = createClient(server_addr);
-        if (!client) {
-            LOG_ERROR("FATAL: unknown server addr format, cluster info line : {}", line);
-            return false;
-        }
         for (size_t slot_index = 8; slot_index < items.size(); ++slot_index) {
             auto &slot_info = items[slot_index];
             if (slot_info.empty() || slot_info[0] == '[') {
@@ -272,17 +418,65 @@ TairAsyncClientPtr TairClusterAsyncClient::createClient(const std::string &addr)
     client->setReconnectIntervalMs(reconnect_interval_ms_);
     client->setKeepAliveSeconds(keepalive_seconds_);
     client->setAutoReconnect(auto_reconnect_);
+    client->setConnectionPoolSize(connection_pool_size_);
+    client->setPoolSelectPolicy(pool_select_policy_);
+    client->setReleaseRequestAfterWrite(release_request_after_write_);
+    client->setZeroCopyThreshold(zerocopy_threshold_);
+    client->setTls(tls_context_);
+    client->setDatabase(database_);
+    client->setFastOpen(fast_open_);
+    client->setReconnectBufferSize(reconnect_buffer_size_);
+    client->setReconnectBufferTimeoutMs(reconnect_buffer_timeout_ms_);
+    client->setHedgeBudgetPercent(hedge_budget_percent_);
+    // Limits apply per node, a hot node is throttled without starving the others
+    client->setRequestLimits(request_limits_);
+    client->setSlowLog(slow_log_config_);
+    client->setHotKeys(hot_key_config_);
+    client->setBigKeys(big_key_config_);
+    client->setSlotLoad(slot_load_);
     client->setUser(user_);
     client->setPassword(password_);
-    TairResult<std::string> result = client->connect().get();
-    if (!result.isSuccess()) {
-        LOG_ERROR("FATAL: connect to server failed: {}", result.getErr());
-        return nullptr;
-    }
     client_map_.emplace(addr, client);
     return client;
 }
 
+bool TairClusterAsyncClient::connectClients(const TairAsyncClientPtr &seed) {
+    if (lazy_connect_) {
+        for (auto &[_, client] : client_map_) {
+            if (client != seed) {
+                client->setLazyConnect(true);
+            }
+        }
+        return true;
+    }
+    // Start every handshake first, so a large cluster costs one round trip instead of one per node
+    std::vector<std::pair<std::string, std::future<TairResult<std::string>>>> futures;
+    futures.reserve(client_map_.size());
+    for (auto &[addr, client] : client_map_) {
+        if (client != seed) {
+            futures.emplace_back(addr, client->connect());
+        }
+    }
+    // Each connector already gives up after connecting_timeout_ms_, the handshake round trip
+    // after it gets as long again, the budget of the CLUSTER NODES request of the seed
+    int timeout_ms = 2 * connecting_timeout_ms_;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    bool ok = true;
+    for (auto &[addr, future] : futures) {
+        if (future.wait_until(deadline) != std::future_status::ready) {
+            LOG_ERROR("FATAL: connect to server {} timed out after {}ms", addr, timeout_ms);
+            ok = false;
+            continue;
+        }
+        auto result = future.get();
+        if (!result.isSuccess()) {
+            LOG_ERROR("FATAL: connect to server {} failed: {}", addr, result.getErr());
+            ok = false;
+        }
+    }
+    return ok;
+}
+
 bool TairClusterAsyncClient::checkKeyInSameSlot(std::initializer_list<std::string> list) {
     if (list.size() == 0) {
         return true;
@@ -316,7 +510,7 @@ void TairClusterAsyncClient::sendCommand(CommandArgv &&argv, const ResultPacketC
     }
     auto tair_client = slot_to_clients_[slot];
     tair_client->sendCommand(std::move(argv), [this, callback](auto *client, auto &req, auto &resp) {
-        if (!checkResultHasClusterError(resp)) {
+        if (!checkResultHasClusterError(client, req, resp)) {
             callback(client, req, resp);
         }
     });
@@ -329,7 +523,7 @@ void TairClusterAsyncClient::sendCommand(const CommandArgv &argv, const ResultPa
     }
     auto tair_client = slot_to_clients_[slot];
     tair_client->sendCommand(argv, [this, callback](auto *client, auto &req, auto &resp) {
-        if (!checkResultHasClusterError(resp)) {
+        if (!checkResultHasClusterError(client, req, resp)) {
             callback(client, req, resp);
         }
     });
@@ -342,7 +536,7 @@ void TairClusterAsyncClient::sendCommand(CommandArgv &&argv, const ResultPacketA
     }
     auto tair_client = slot_to_clients_[slot];
     tair_client->sendCommand(std::move(argv), [this, callback](auto *client, auto &req, auto &resp, int64_t latency_us) {
-        if (!checkResultHasClusterError(resp)) {
+        if (!checkResultHasClusterError(client, req, resp)) {
             callback(client, req, resp, latency_us);
         }
     });
@@ -355,12 +549,40 @@ void TairClusterAsyncClient::sendCommand(const CommandArgv &argv, const ResultPa
     }
     auto tair_client = slot_to_clients_[slot];
     tair_client->sendCommand(argv, [this, callback](auto *client, auto &req, auto &resp, int64_t latency_us) {
-        if (!checkResultHasClusterError(resp)) {
+        if (!checkResultHasClusterError(client, req, resp)) {
             callback(client, req, resp, latency_us);
         }
     });
 }
 
+void TairClusterAsyncClient::sendCommand(CommandArgv &&argv, const ResultPacketAndTimingCallback &callback) {
+    int slot = calcCommandSlot(argv);
+    if (slot < 0 || !slot_to_clients_[slot]) {
+        callback(nullptr, nullptr, nullptr, 0, {});
+        return;
+    }
+    auto tair_client = slot_to_clients_[slot];
+    tair_client->sendCommand(std::move(argv), [this, callback](auto *client, auto &req, auto &resp, int64_t latency_us, auto &timing) {
+        if (!checkResultHasClusterError(client, req, resp)) {
+            callback(client, req, resp, latency_us, timing);
+        }
+    });
+}
+
+void TairClusterAsyncClient::sendCommand(const CommandArgv &argv, const ResultPacketAndTimingCallback &callback) {
+    int slot = calcCommandSlot(argv);
+    if (slot < 0 || !slot_to_clients_[slot]) {
+        callback(nullptr, nullptr, nullptr, 0, {});
+        return;
+    }
+    auto tair_client = slot_to_clients_[slot];
+    tair_client->sendCommand(argv, [this, callback](auto *client, auto &req, auto &resp, int64_t latency_us, auto &timing) {
+        if (!checkResultHasClusterError(client, req, resp)) {
+            callback(client, req, resp, latency_us, timing);
+        }
+    });
+}
+
 // -------------------------------- Generic Command --------------------------------
 void TairClusterAsyncClient::del(const std::string &key, const ResultIntegerCallback &callback) {
     auto client = getClientByKey(key);
@@ -664,11 +886,21 @@ void TairClusterAsyncClient::set(const std::string &key, const std::string &valu
     client->set(key, value, callback);
 }
 
+void TairClusterAsyncClient::set(const std::string &key, std::shared_ptr<const std::string> value, const ResultStringCallback &callback) {
+    auto client = getClientByKey(key);
+    client->set(key, std::move(value), callback);
+}
+
 void TairClusterAsyncClient::get(const std::string &key, const ResultStringPtrCallback &callback) {
     auto client = getClientByKey(key);
     client->get(key, callback);
 }
 
+void TairClusterAsyncClient::getToSink(const std::string &key, const BulkStringSink &sink, const ResultIntegerPtrCallback &callback) {
+    auto client = getClientByKey(key);
+    client->getToSink(key, sink, callback);
+}
+
 void TairClusterAsyncClient::incr(const std::string &key, const ResultIntegerCallback &callback) {
     auto client = getClientByKey(key);
     client->incr(key, callback);
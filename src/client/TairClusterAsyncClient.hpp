@@ -56,6 +56,33 @@ public:
     void setReconnectIntervalMs(int timeout_ms) override;
     void setAutoReconnect(bool reconnect) override;
     void setKeepAliveSeconds(int seconds) override;
+    void setConnectionPoolSize(int size) override;
+    void setPoolSelectPolicy(PoolSelectPolicy policy) override;
+    void setReleaseRequestAfterWrite(bool release) override;
+    void setZeroCopyThreshold(size_t bytes) override;
+    void setTls(std::shared_ptr<TlsClientContext> context) override;
+    void setLazyConnect(bool lazy) override;
+    void setDatabase(int db) override;
+    void setFastOpen(bool on) override;
+    void setReconnectBufferSize(size_t size) override;
+    void setReconnectBufferTimeoutMs(int timeout_ms) override;
+    void setHedgeBudgetPercent(int percent) override;
+    void setRequestLimits(const RequestLimits &limits) override;
+
+    // Histograms of all nodes merged, with a per node breakdown
+    TairClientStats getStats() const override;
+    void setSlowLog(const SlowLogConfig &config) override;
+    // Entries of all nodes, newest first
+    std::vector<SlowRequestEntry> getSlowLog(size_t count) const override;
+    void setHotKeys(const HotKeyConfig &config) override;
+    // The heaviest keys over all nodes, each node samples on its own
+    HotKeyReport getHotKeys() const override;
+    void setBigKeys(const BigKeyConfig &config) override;
+    // Command sizes summed over all nodes, the largest keys of any node
+    BigKeyReport getBigKeys() const override;
+    // Each node counts its own slots on its loop thread
+    void setSlotLoad(bool enable) override;
+    LoadReport getLoad() const override;
 
     // send command
     void sendCommand(CommandArgv &&argv, const ResultPacketCallback &callback) override;
@@ -64,6 +91,9 @@ public:
     void sendCommand(CommandArgv &&argv, const ResultPacketAndLatencyCallback &callback) override;
     void sendCommand(const CommandArgv &argv, const ResultPacketAndLatencyCallback &callback) override;
 
+    void sendCommand(CommandArgv &&argv, const ResultPacketAndTimingCallback &callback) override;
+    void sendCommand(const CommandArgv &argv, const ResultPacketAndTimingCallback &callback) override;
+
     // generic
     void del(const std::string &key, const ResultIntegerCallback &callback) override;
     void del(InitializerList<std::string> keys, const ResultIntegerCallback &callback) override;
@@ -118,7 +148,9 @@ public:
     void getset(const std::string &key, const std::string &value, const ResultStringPtrCallback &callback) override;
     void set(const std::string &key, const std::string &value, const SetParams &params, const ResultStringCallback &callback) override;
     void set(const std::string &key, const std::string &value, const ResultStringCallback &callback) override;
+    void set(const std::string &key, std::shared_ptr<const std::string> value, const ResultStringCallback &callback) override;
     void get(const std::string &key, const ResultStringPtrCallback &callback) override;
+    void getToSink(const std::string &key, const BulkStringSink &sink, const ResultIntegerPtrCallback &callback) override;
     void incr(const std::string &key, const ResultIntegerCallback &callback) override;
     void incrby(const std::string &key, int64_t increment, const ResultIntegerCallback &callback) override;
     void incrbyfloat(const std::string &key, double increment, const ResultStringCallback &callback) override;
@@ -294,8 +326,7 @@ public:
     void clusterNodes(const ResultStringCallback &callback) override;
 
 private:
-    void initEventLoop();
-    bool checkResultHasClusterError(const PacketPtr &resp);
+    bool checkResultHasClusterError(ITairClient *client, const PacketPtr &req, const PacketPtr &resp);
     static int calcCommandSlot(const CommandArgv &argv);
     TairAsyncClientPtr getClientByKey(const std::string &key);
     TairAsyncClientPtr getClientRandom();
@@ -303,6 +334,7 @@ private:
     bool parseNodesInfoAndInitClient(std::string &nodes_info);
     bool getClusterNodesInfo(const TairAsyncClientPtr &client, std::string &nodes_info);
     TairAsyncClientPtr createClient(const std::string &addr);
+    bool connectClients(const TairAsyncClientPtr &seed);
     bool checkKeyInSameSlot(std::initializer_list<std::string> list);
     bool checkKeyInSameSlot(const std::string &dest, std::initializer_list<std::string> list);
 
@@ -315,9 +347,25 @@ private:
     int reconnect_interval_ms_ = -1;
     bool auto_reconnect_ = true;
     int keepalive_seconds_ = 60;
+    int connection_pool_size_ = 1;
+    PoolSelectPolicy pool_select_policy_ = PoolSelectPolicy::LEAST_INFLIGHT;
+    bool release_request_after_write_ = false;
+    size_t zerocopy_threshold_ = 0;
+    std::shared_ptr<TlsClientContext> tls_context_;
+    bool lazy_connect_ = false;
+    int database_ = 0;
+    bool fast_open_ = false;
+    size_t reconnect_buffer_size_ = 4096;
+    int reconnect_buffer_timeout_ms_ = 2000;
+    int hedge_budget_percent_ = 0;
+    RequestLimits request_limits_;
+    SlowLogConfig slow_log_config_;
+    HotKeyConfig hot_key_config_;
+    BigKeyConfig big_key_config_;
+    bool slot_load_ = false;
+    mutable TairLoadTracker load_tracker_;
 
     // Cluster resource
-    std::unique_ptr<EventLoopThread> loop_thread_;
     EventLoop *loop_ = nullptr;
     TairClientMap client_map_;
     std::array<TairAsyncClientPtr, KeyHash::SLOTS_NUM> slot_to_clients_ = {nullptr};
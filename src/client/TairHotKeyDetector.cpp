@@ -0,0 +1,127 @@
+/*
+ *  Copyright (c) 2023 Tair
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+#include "client/TairHotKeyDetector.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+#include "common/ClockTime.hpp"
+#include "common/KeyHash.hpp"
+#include "common/Logger.hpp"
+
+#include "fmt/format.h"
+
+namespace tair::client {
+
+using common::ClockTime;
+using common::KeyHash;
+using common::LockGuard;
+
+TairHotKeyDetector::TairHotKeyDetector(const HotKeyConfig &config)
+    : config_(config), sample_rate_(std::max(config.sample_rate, 1)),
+      counts_(config.top_k), bytes_(config.top_k),
+      window_start_(ClockTime::intervalUs()), window_start_us_(ClockTime::nowUs()) {}
+
+void TairHotKeyDetector::record(const std::string &node, const PacketPtr &req, size_t bytes) {
+    auto key = TairRequestKey::extractKey(req);
+    if (key.slot < 0) {
+        return;
+    }
+    int64_t now = ClockTime::intervalUs();
+    LockGuard lock(mutex_);
+    if (now - window_start_ >= config_.window_ms * 1000) {
+        rotate(node, now);
+    }
+    counts_.add(key.name);
+    bytes_.add(key.name, bytes);
+    if (key.name.size() == TairRequestKey::kMaxKeyLength) {
+        cut_key_slots_[key.name] = key.slot;
+        if (cut_key_slots_.size() > 4 * config_.top_k) {
+            pruneCutKeySlots();
+        }
+    }
+}
+
+void TairHotKeyDetector::pruneCutKeySlots() {
+    std::unordered_map<std::string, int> kept;
+    for (const auto *sketch : {&counts_, &bytes_}) {
+        for (const auto &[key, _] : sketch->getTopK()) {
+            if (auto it = cut_key_slots_.find(key); it != cut_key_slots_.end()) {
+                kept.emplace(key, it->second);
+            }
+        }
+    }
+    cut_key_slots_.swap(kept);
+}
+
+void TairHotKeyDetector::rotate(const std::string &node, int64_t now) {
+    int64_t end_us = window_start_us_ + (now - window_start_);
+    last_ = buildReport(node, end_us);
+    if (config_.log && !last_.by_count.empty()) {
+        LOG_INFO("TairClient hot keys of {} in the last {}ms, by count: {} by bytes: {}",
+                 node, (now - window_start_) / 1000, toString(last_.by_count), toString(last_.by_bytes));
+    }
+    counts_.clear();
+    bytes_.clear();
+    cut_key_slots_.clear();
+    window_start_ = now;
+    window_start_us_ = end_us;
+}
+
+HotKeyReport TairHotKeyDetector::getReport(const std::string &node) const {
+    int64_t now = ClockTime::intervalUs();
+    LockGuard lock(mutex_);
+    // Nothing was sampled since the window ran out, so the current one is finished as well
+    if (last_.window_end_us == 0 || now - window_start_ >= config_.window_ms * 1000) {
+        return buildReport(node, window_start_us_ + (now - window_start_));
+    }
+    return last_;
+}
+
+HotKeyReport TairHotKeyDetector::buildReport(const std::string &node, int64_t end_us) const {
+    auto to_entry = [&](const std::string &key, uint64_t count, uint64_t bytes) {
+        auto it = cut_key_slots_.find(key);
+        int slot = it != cut_key_slots_.end() ? it->second : KeyHash::keyHashSlot(key);
+        return HotKeyEntry{key, slot, node, count * sample_rate_, bytes * sample_rate_};
+    };
+    HotKeyReport report;
+    report.window_start_us = window_start_us_;
+    report.window_end_us = end_us;
+    for (const auto &[key, count] : counts_.getTopK()) {
+        report.by_count.push_back(to_entry(key, count, bytes_.estimate(key)));
+    }
+    for (const auto &[key, bytes] : bytes_.getTopK()) {
+        report.by_bytes.push_back(to_entry(key, counts_.estimate(key), bytes));
+    }
+    return report;
+}
+
+std::string TairHotKeyDetector::toString(const std::vector<HotKeyEntry> &entries) {
+    std::string out;
+    for (const auto &entry : entries) {
+        fmt::format_to(std::back_inserter(out), "{}{} (slot {}) count={} bytes={}",
+                       out.empty() ? "" : ", ", entry.key, entry.slot, entry.count, entry.bytes);
+    }
+    return out;
+}
+
+} // namespace tair::client
@@ -0,0 +1,82 @@
+/*
+ *  Copyright (c) 2023 Tair
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "common/Mutex.hpp"
+#include "common/Noncopyable.hpp"
+#include "common/statistics/TopKSketch.hpp"
+#include "client/TairClientDefine.hpp"
+#include "client/TairRequestKey.hpp"
+
+namespace tair::client {
+
+using common::Mutex;
+using common::Noncopyable;
+using common::TopKSketch;
+
+// Sampled keys of one node counted per time window in top-K sketches, by requests and by bytes
+class TairHotKeyDetector : private Noncopyable {
+public:
+    explicit TairHotKeyDetector(const HotKeyConfig &config);
+    ~TairHotKeyDetector() = default;
+
+    // Loop thread only, true once every sample_rate calls. All a request pays when not sampled
+    bool shouldSample() {
+        if (++since_sample_ < sample_rate_) {
+            return false;
+        }
+        since_sample_ = 0;
+        return true;
+    }
+
+    // Loop thread only, bytes are those of the request and its reply
+    void record(const std::string &node, const PacketPtr &req, size_t bytes) EXCLUDES(mutex_);
+    // The last finished window, or the current one while none has finished
+    HotKeyReport getReport(const std::string &node) const EXCLUDES(mutex_);
+
+private:
+    void rotate(const std::string &node, int64_t now) REQUIRES(mutex_);
+    void pruneCutKeySlots() REQUIRES(mutex_);
+    HotKeyReport buildReport(const std::string &node, int64_t end_us) const REQUIRES(mutex_);
+    static std::string toString(const std::vector<HotKeyEntry> &entries);
+
+    HotKeyConfig config_;
+    int sample_rate_;
+    int since_sample_ = 0;
+
+    mutable Mutex mutex_;
+    TopKSketch counts_ GUARDED_BY(mutex_);
+    TopKSketch bytes_ GUARDED_BY(mutex_);
+    int64_t window_start_ GUARDED_BY(mutex_);    // monotonic
+    int64_t window_start_us_ GUARDED_BY(mutex_); // wall clock
+    HotKeyReport last_ GUARDED_BY(mutex_);
+    // Slots of the keys that were cut, the cut name hashes elsewhere. Pruned to the top-K keys
+    std::unordered_map<std::string, int> cut_key_slots_ GUARDED_BY(mutex_);
+};
+
+} // namespace tair::client
@@ -0,0 +1,166 @@
+/*
+ *  Copyright (c) 2023 Tair
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+#include "client/TairLatencyRecorder.hpp"
+
+#include "common/StringUtil.hpp"
+#include "protocol/packet/resp/ArrayPacket.hpp"
+#include "protocol/packet/resp/BulkStringPacket.hpp"
+
+namespace tair::client {
+
+using common::LockGuard;
+using common::StringUtil;
+using protocol::ArrayPacket;
+using protocol::BulkStringPacket;
+
+std::unique_ptr<HdrHistogram> TairLatencyRecorder::newHistogram() {
+    return std::make_unique<HdrHistogram>(kHighestLatencyUs, 0.01);
+}
+
+HdrHistogram *TairLatencyRecorder::getHistogram(const PacketPtr &req) {
+    auto *array = req ? req->packet_cast<ArrayPacket>() : nullptr;
+    if (!array || array->getPacketArray().empty()) {
+        return other_.get();
+    }
+    auto *cmd = array->getPacketArray()[0]->packet_cast<BulkStringPacket>();
+    if (!cmd) {
+        return other_.get();
+    }
+    const std::string &name = cmd->getValue();
+    auto iter = histograms_.find(name);
+    if (iter != histograms_.end()) {
+        return iter->second.get();
+    }
+    LockGuard lock(mutex_);
+    if (histograms_.size() >= kMaxCommands) {
+        return other_.get();
+    }
+    return histograms_.emplace(name, newHistogram()).first->second.get();
+}
+
+void TairLatencyRecorder::recordTiming(const RequestTiming &timing) {
+    queue_->recordSingleWriter(timing.queue_us);
+    network_->recordSingleWriter(timing.network_us);
+    decode_->recordSingleWriter(timing.decode_us);
+}
+
+std::string TairLatencyRecorder::getCommandName(const HdrHistogram *histogram) const {
+    for (const auto &[name, value] : histograms_) {
+        if (value.get() == histogram) {
+            std::string lower = name;
+            StringUtil::toLower(lower);
+            return lower;
+        }
+    }
+    return "other";
+}
+
+static HdrHistogram &histogramOf(std::map<std::string, std::unique_ptr<HdrHistogram>> &histograms, const std::string &name) {
+    auto &histogram = histograms[name];
+    if (!histogram) {
+        histogram = TairLatencyRecorder::newHistogram();
+    }
+    return *histogram;
+}
+
+void TairLatencyRecorder::mergeTo(std::map<std::string, std::unique_ptr<HdrHistogram>> &commands, HdrHistogram &total) const {
+    LockGuard lock(mutex_);
+    for (const auto &[name, histogram] : histograms_) {
+        std::string lower = name;
+        StringUtil::toLower(lower);
+        histogramOf(commands, lower).merge(*histogram);
+        total.merge(*histogram);
+    }
+    if (other_->getCount() > 0) {
+        histogramOf(commands, "other").merge(*other_);
+        total.merge(*other_);
+    }
+}
+
+NodeCounters TairLatencyRecorder::getCounters() const {
+    NodeCounters counters;
+    uint64_t completed = completed_.load(std::memory_order_relaxed);
+    counters.requests = requests_.load(std::memory_order_relaxed);
+    // The loads race with the loop thread, keep the difference from going negative
+    counters.inflight = counters.requests > completed ? counters.requests - completed : 0;
+    counters.errors = errors_.load(std::memory_order_relaxed);
+    counters.reconnects = reconnects_.load(std::memory_order_relaxed);
+    counters.redirects = redirects_.load(std::memory_order_relaxed);
+    return counters;
+}
+
+void TairStatsBuilder::add(const std::string &node, const TairLatencyRecorder &recorder) {
+    auto node_total = TairLatencyRecorder::newHistogram();
+    recorder.mergeTo(commands_, *node_total);
+    histogramOf(nodes_, node).merge(*node_total);
+    total_->merge(*node_total);
+    phases_.merge(recorder);
+    node_phases_[node].merge(recorder);
+    NodeCounters counters = recorder.getCounters();
+    auto &node_counters = counters_[node];
+    node_counters.requests += counters.requests;
+    node_counters.errors += counters.errors;
+    node_counters.inflight += counters.inflight;
+    node_counters.reconnects += counters.reconnects;
+    node_counters.redirects += counters.redirects;
+}
+
+void TairStatsBuilder::PhaseHistograms::merge(const TairLatencyRecorder &recorder) {
+    queue->merge(recorder.getQueueHistogram());
+    network->merge(recorder.getNetworkHistogram());
+    decode->merge(recorder.getDecodeHistogram());
+}
+
+PhaseStats TairStatsBuilder::PhaseHistograms::toPhaseStats() const {
+    return {toLatencyStats(*queue), toLatencyStats(*network), toLatencyStats(*decode)};
+}
+
+TairClientStats TairStatsBuilder::build() const {
+    TairClientStats stats;
+    stats.total = toLatencyStats(*total_);
+    for (const auto &[name, histogram] : commands_) {
+        stats.commands.emplace(name, toLatencyStats(*histogram));
+    }
+    for (const auto &[node, histogram] : nodes_) {
+        stats.nodes.emplace(node, toLatencyStats(*histogram));
+    }
+    stats.phases = phases_.toPhaseStats();
+    for (const auto &[node, phases] : node_phases_) {
+        stats.node_phases.emplace(node, phases.toPhaseStats());
+    }
+    stats.counters = counters_;
+    return stats;
+}
+
+LatencyStats TairStatsBuilder::toLatencyStats(const HdrHistogram &histogram) {
+    LatencyStats stats;
+    stats.count = histogram.getCount();
+    stats.sum_us = histogram.getSum();
+    stats.avg_us = histogram.getMean();
+    stats.max_us = histogram.getMax();
+    stats.p50_us = histogram.getValueAtPercentile(50);
+    stats.p99_us = histogram.getValueAtPercentile(99);
+    stats.p999_us = histogram.getValueAtPercentile(99.9);
+    return stats;
+}
+
+} // namespace tair::client
@@ -0,0 +1,129 @@
+/*
+ *  Copyright (c) 2023 Tair
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+#pragma once
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "common/Mutex.hpp"
+#include "common/Noncopyable.hpp"
+#include "common/statistics/HdrHistogram.hpp"
+#include "client/TairClientDefine.hpp"
+
+namespace tair::client {
+
+using common::HdrHistogram;
+using common::Mutex;
+using common::Noncopyable;
+
+// Reply latency histograms of one node keyed by command name. Written by the node's loop thread
+// without locking, snapshots may be taken from any thread
+class TairLatencyRecorder : private Noncopyable {
+public:
+    TairLatencyRecorder() = default;
+    ~TairLatencyRecorder() = default;
+
+    // Loop thread only, record with HdrHistogram::recordSingleWriter(). The histogram lives as long as
+    // the recorder, so a request can hold it from send to reply even when released after the write
+    HdrHistogram *getHistogram(const PacketPtr &req);
+    // Loop thread only
+    void recordTiming(const RequestTiming &timing);
+    // Loop thread only, the lowercase command a histogram of getHistogram() belongs to
+    std::string getCommandName(const HdrHistogram *histogram) const;
+
+    // Adds the histograms recorded so far into commands, keyed by lowercase name, and into total
+    void mergeTo(std::map<std::string, std::unique_ptr<HdrHistogram>> &commands, HdrHistogram &total) const EXCLUDES(mutex_);
+    const HdrHistogram &getQueueHistogram() const { return *queue_; }
+    const HdrHistogram &getNetworkHistogram() const { return *network_; }
+    const HdrHistogram &getDecodeHistogram() const { return *decode_; }
+
+    // Loop thread only, a single writer needs no locked increment
+    void countRequest() { increment(requests_); }
+    void countCompleted() { increment(completed_); }
+    void countError(bool redirect) {
+        increment(errors_);
+        if (redirect) {
+            increment(redirects_);
+        }
+    }
+    void countReconnect() { increment(reconnects_); }
+    NodeCounters getCounters() const;
+
+    // 1% precision up to a minute, slower replies count as a minute in percentiles but not in max
+    static std::unique_ptr<HdrHistogram> newHistogram();
+
+private:
+    static void increment(std::atomic<uint64_t> &counter) {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    // Bounds the map when callers send arbitrary command names, the rest share one entry
+    static constexpr size_t kMaxCommands = 256;
+    static constexpr uint64_t kHighestLatencyUs = 60UL * 1000 * 1000;
+
+    // Inserts take the lock, the loop thread is the only writer so its lookups go without it
+    mutable Mutex mutex_;
+    std::unordered_map<std::string, std::unique_ptr<HdrHistogram>> histograms_;
+    std::unique_ptr<HdrHistogram> other_ = newHistogram();
+    std::unique_ptr<HdrHistogram> queue_ = newHistogram();
+    std::unique_ptr<HdrHistogram> network_ = newHistogram();
+    std::unique_ptr<HdrHistogram> decode_ = newHistogram();
+    std::atomic<uint64_t> requests_ = 0;
+    std::atomic<uint64_t> completed_ = 0;
+    std::atomic<uint64_t> errors_ = 0;
+    std::atomic<uint64_t> reconnects_ = 0;
+    std::atomic<uint64_t> redirects_ = 0;
+};
+
+// Merges the recorders of several nodes, percentiles come from the merged histograms
+class TairStatsBuilder : private Noncopyable {
+public:
+    TairStatsBuilder() = default;
+    ~TairStatsBuilder() = default;
+
+    void add(const std::string &node, const TairLatencyRecorder &recorder);
+    TairClientStats build() const;
+
+    static LatencyStats toLatencyStats(const HdrHistogram &histogram);
+
+private:
+    struct PhaseHistograms {
+        void merge(const TairLatencyRecorder &recorder);
+        PhaseStats toPhaseStats() const;
+
+        std::unique_ptr<HdrHistogram> queue = TairLatencyRecorder::newHistogram();
+        std::unique_ptr<HdrHistogram> network = TairLatencyRecorder::newHistogram();
+        std::unique_ptr<HdrHistogram> decode = TairLatencyRecorder::newHistogram();
+    };
+
+    std::unique_ptr<HdrHistogram> total_ = TairLatencyRecorder::newHistogram();
+    PhaseHistograms phases_;
+    std::map<std::string, PhaseHistograms> node_phases_;
+    std::map<std::string, std::unique_ptr<HdrHistogram>> commands_;
+    std::map<std::string, std::unique_ptr<HdrHistogram>> nodes_;
+    std::map<std::string, NodeCounters> counters_;
+};
+
+} // namespace tair::client
@@ -0,0 +1,77 @@
+/*
+ *  Copyright (c) 2023 Tair
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+#include "client/TairLoopPool.hpp"
+
+#include "common/Logger.hpp"
+
+namespace tair::client {
+
+TairLoopPool &TairLoopPool::instance() {
+    static TairLoopPool pool;
+    return pool;
+}
+
+TairLoopPool::~TairLoopPool() {
+    LockGuard lock(mutex_);
+    if (thread_pool_) {
+        thread_pool_->stop();
+        thread_pool_->join();
+        thread_pool_.reset();
+    }
+    if (base_thread_) {
+        base_thread_->stop();
+        base_thread_->join();
+        base_thread_.reset();
+    }
+}
+
+bool TairLoopPool::setThreadNum(size_t thread_num) {
+    LockGuard lock(mutex_);
+    if (thread_pool_ || thread_num == 0 || thread_num > EventLoopThreadPool::MAX_THREAD_POOL_SIZE) {
+        return false;
+    }
+    thread_num_ = thread_num;
+    return true;
+}
+
+size_t TairLoopPool::getThreadNum() const {
+    LockGuard lock(mutex_);
+    return thread_num_;
+}
+
+void TairLoopPool::start() {
+    LOG_INFO("TairLoopPool start, thread_num: {}", thread_num_);
+    base_thread_ = std::make_unique<EventLoopThread>("client-base");
+    base_thread_->start();
+    thread_pool_ = std::make_unique<EventLoopThreadPool>(base_thread_->loop(), thread_num_, "client-io");
+    thread_pool_->start();
+}
+
+EventLoop *TairLoopPool::getNextLoop() {
+    LockGuard lock(mutex_);
+    if (!thread_pool_) {
+        start();
+    }
+    return thread_pool_->getNextLoop();
+}
+
+} // namespace tair::client
@@ -0,0 +1,68 @@
+/*
+ *  Copyright (c) 2023 Tair
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+#pragma once
+
+#include <memory>
+
+#include "common/Mutex.hpp"
+#include "common/Noncopyable.hpp"
+#include "network/EventLoopThread.hpp"
+#include "network/EventLoopThreadPool.hpp"
+
+namespace tair::client {
+
+using common::LockGuard;
+using common::Mutex;
+using common::Noncopyable;
+using network::EventLoop;
+using network::EventLoopThread;
+using network::EventLoopThreadPool;
+
+// Process-wide IO loops shared by all clients that are not given an event loop,
+// the threads are started lazily when the first client picks a loop.
+class TairLoopPool : private Noncopyable {
+public:
+    static TairLoopPool &instance();
+
+    // Only takes effect before the pool is started
+    bool setThreadNum(size_t thread_num) EXCLUDES(mutex_);
+    size_t getThreadNum() const EXCLUDES(mutex_);
+
+    // Loops are handed out round-robin, so connections are balanced across threads
+    EventLoop *getNextLoop() EXCLUDES(mutex_);
+
+    constexpr static const size_t DEFAULT_THREAD_NUM = 4;
+
+private:
+    TairLoopPool() = default;
+    ~TairLoopPool();
+
+    void start() REQUIRES(mutex_);
+
+private:
+    mutable Mutex mutex_;
+    size_t thread_num_ GUARDED_BY(mutex_) = DEFAULT_THREAD_NUM;
+    std::unique_ptr<EventLoopThread> base_thread_ GUARDED_BY(mutex_);
+    std::unique_ptr<EventLoopThreadPool> thread_pool_ GUARDED_BY(mutex_);
+};
+
+} // namespace tair::client
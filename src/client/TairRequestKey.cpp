@@ -0,0 +1,56 @@
+/*
+ *  Copyright (c) 2023 Tair
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+#include "client/TairRequestKey.hpp"
+
+#include "common/KeyHash.hpp"
+#include "protocol/packet/resp/ArrayPacket.hpp"
+#include "protocol/packet/resp/BulkStringPacket.hpp"
+
+namespace tair::client {
+
+using common::KeyHash;
+using protocol::ArrayPacket;
+using protocol::BulkStringPacket;
+
+static const BulkStringPacket *keyArgument(const PacketPtr &req) {
+    auto *array = req ? req->packet_cast<ArrayPacket>() : nullptr;
+    if (!array || array->getPacketArray().size() < 2) {
+        return nullptr;
+    }
+    return array->getPacketArray()[1]->packet_cast<BulkStringPacket>();
+}
+
+int TairRequestKey::calcRequestSlot(const PacketPtr &req) {
+    auto *key = keyArgument(req);
+    return key ? KeyHash::keyHashSlot(key->getValue()) : -1;
+}
+
+RequestKey TairRequestKey::extractKey(const PacketPtr &req) {
+    auto *key = keyArgument(req);
+    if (!key) {
+        return {};
+    }
+    // The slot is taken before the cut, a long key without a hashtag hashes all of its bytes
+    return RequestKey{key->getValue().substr(0, kMaxKeyLength), KeyHash::keyHashSlot(key->getValue())};
+}
+
+} // namespace tair::client
@@ -0,0 +1,48 @@
+/*
+ *  Copyright (c) 2023 Tair
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include "client/TairClientDefine.hpp"
+
+namespace tair::client {
+
+// The first argument of a command, its key for the commands that have one
+struct RequestKey {
+    std::string name; // cut at kMaxKeyLength
+    int slot = -1;    // of the whole key
+};
+
+class TairRequestKey {
+public:
+    // Keys are reported up to this many bytes
+    static constexpr size_t kMaxKeyLength = 128;
+
+    // -1 when req has no key argument
+    static int calcRequestSlot(const PacketPtr &req);
+    // An empty name and slot -1 when req has no key argument or was released after write
+    static RequestKey extractKey(const PacketPtr &req);
+};
+
+} // namespace tair::client
@@ -0,0 +1,150 @@
+/*
+ *  Copyright (c) 2023 Tair
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+#include "client/TairRequestLimiter.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+#include "common/ClockTime.hpp"
+
+namespace tair::client {
+
+using common::ClockTime;
+using common::UniqueLock;
+using common::LockGuard;
+
+TairRequestLimiter::TairRequestLimiter(const RequestLimits &limits)
+    : limits_(limits) {
+    LockGuard lock(mutex_);
+    concurrency_limit_ = (double)limits_.max_inflight;
+    if (limits_.max_qps > 0) {
+        // One second worth of burst, no strict mode
+        qps_bucket_.emplace(limits_.max_qps, limits_.max_qps, 0);
+    }
+}
+
+bool TairRequestLimiter::acquire(size_t bytes, bool may_block) {
+    bool notify_overloaded = false;
+    {
+        UniqueLock lock(mutex_);
+        while (true) {
+            int64_t wait_ms = 0;
+            if (tryAdmit(bytes, wait_ms)) {
+                return true;
+            }
+            if (limits_.policy == LimitPolicy::BLOCK && may_block) {
+                ++waiters_;
+                if (wait_ms > 0) {
+                    condition_.waitFor(lock, std::chrono::milliseconds(wait_ms));
+                } else {
+                    condition_.wait(lock);
+                }
+                --waiters_;
+                continue;
+            }
+            if (limits_.policy != LimitPolicy::BACKPRESSURE) {
+                return false;
+            }
+            // Admitted over the limit, the producer is told to slow down instead
+            ++inflight_;
+            inflight_bytes_ += bytes;
+            notify_overloaded = !overloaded_;
+            overloaded_ = true;
+            break;
+        }
+    }
+    if (notify_overloaded && limits_.backpressure_callback) {
+        limits_.backpressure_callback(true);
+    }
+    return true;
+}
+
+void TairRequestLimiter::release(size_t bytes, int64_t latency_us) {
+    bool notify_recovered = false;
+    {
+        LockGuard lock(mutex_);
+        --inflight_;
+        inflight_bytes_ -= bytes;
+        if (limits_.target_latency_us > 0 && limits_.max_inflight > 0) {
+            adjustLimit(latency_us);
+        }
+        if (overloaded_ && underLimits()) {
+            overloaded_ = false;
+            notify_recovered = true;
+        }
+        if (waiters_ > 0) {
+            condition_.notifyAll();
+        }
+    }
+    if (notify_recovered && limits_.backpressure_callback) {
+        limits_.backpressure_callback(false);
+    }
+}
+
+size_t TairRequestLimiter::getInflight() const {
+    LockGuard lock(mutex_);
+    return inflight_;
+}
+
+size_t TairRequestLimiter::getConcurrencyLimit() const {
+    LockGuard lock(mutex_);
+    return (size_t)concurrency_limit_;
+}
+
+bool TairRequestLimiter::tryAdmit(size_t bytes, int64_t &wait_ms) {
+    if (!underLimits()) {
+        return false;
+    }
+    // A single request larger than the byte cap still goes out once nothing else is in flight
+    if (limits_.max_inflight_bytes > 0 && inflight_bytes_ > 0 && inflight_bytes_ + bytes > limits_.max_inflight_bytes) {
+        return false;
+    }
+    if (qps_bucket_ && !qps_bucket_->consume(1, wait_ms)) {
+        wait_ms = std::max<int64_t>(wait_ms, 1);
+        return false;
+    }
+    ++inflight_;
+    inflight_bytes_ += bytes;
+    return true;
+}
+
+bool TairRequestLimiter::underLimits() const {
+    if (limits_.max_inflight > 0 && inflight_ >= std::max<size_t>((size_t)concurrency_limit_, 1)) {
+        return false;
+    }
+    return limits_.max_inflight_bytes == 0 || inflight_bytes_ < limits_.max_inflight_bytes;
+}
+
+void TairRequestLimiter::adjustLimit(int64_t latency_us) {
+    if (latency_us > limits_.target_latency_us) {
+        // Cut at most once per round trip, a burst of slow replies is one congestion signal
+        int64_t now = ClockTime::intervalUs();
+        if (now - last_decrease_us_ >= latency_us) {
+            concurrency_limit_ = std::max(concurrency_limit_ * 0.9, 1.0);
+            last_decrease_us_ = now;
+        }
+    } else {
+        concurrency_limit_ = std::min(concurrency_limit_ + 1.0 / concurrency_limit_, (double)limits_.max_inflight);
+    }
+}
+
+} // namespace tair::client
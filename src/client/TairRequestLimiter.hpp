@@ -0,0 +1,77 @@
+/*
+ *  Copyright (c) 2023 Tair
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include "common/Mutex.hpp"
+#include "common/Noncopyable.hpp"
+#include "common/TokenBucket.hpp"
+#include "client/TairClientDefine.hpp"
+
+namespace tair::client {
+
+using common::Condition;
+using common::Mutex;
+using common::Noncopyable;
+using common::TokenBucket;
+
+// Admission control shared by every thread sending through one client. A request takes a slot
+// in acquire() before it is queued and gives it back in release() when its reply arrives
+class TairRequestLimiter : private Noncopyable {
+public:
+    explicit TairRequestLimiter(const RequestLimits &limits);
+
+    bool isBytesLimited() const {
+        return limits_.max_inflight_bytes > 0;
+    }
+
+    // may_block is false on the client loop thread, where BLOCK degrades to FAIL_FAST
+    bool acquire(size_t bytes, bool may_block) EXCLUDES(mutex_);
+    void release(size_t bytes, int64_t latency_us) EXCLUDES(mutex_);
+
+    size_t getInflight() const EXCLUDES(mutex_);
+    size_t getConcurrencyLimit() const EXCLUDES(mutex_);
+
+private:
+    // wait_ms is how long a qps shortfall lasts, 0 when only a release can help
+    bool tryAdmit(size_t bytes, int64_t &wait_ms) REQUIRES(mutex_);
+    bool underLimits() const REQUIRES(mutex_);
+    void adjustLimit(int64_t latency_us) REQUIRES(mutex_);
+
+private:
+    const RequestLimits limits_;
+
+    mutable Mutex mutex_;
+    Condition condition_ GUARDED_BY(mutex_);
+    size_t waiters_ GUARDED_BY(mutex_) = 0;
+    size_t inflight_ GUARDED_BY(mutex_) = 0;
+    size_t inflight_bytes_ GUARDED_BY(mutex_) = 0;
+    double concurrency_limit_ GUARDED_BY(mutex_) = 0;
+    int64_t last_decrease_us_ GUARDED_BY(mutex_) = 0;
+    std::optional<TokenBucket> qps_bucket_ GUARDED_BY(mutex_);
+    bool overloaded_ GUARDED_BY(mutex_) = false;
+};
+
+} // namespace tair::client
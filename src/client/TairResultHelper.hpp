@@ -127,6 +127,16 @@ public:
         result.setValue(s_ptr);
     }
 
+    static void streamedLengthPtrBuilder(BulkStringPacket *packet, TairResult<std::shared_ptr<int64_t>> &result) {
+        if (packet->getType() == PacketType::TYPE_NULL) {
+            result.setValue(nullptr);
+        } else if (packet->isSinkAborted()) {
+            result.setErr("sink stopped receiving the value");
+        } else {
+            result.setValue(std::make_shared<int64_t>(packet->getStreamedLength()));
+        }
+    }
+
     static void doIntegerPtrCallback(const PacketPtr &resp, const ResultIntegerPtrCallback &callback) {
         TairResult<std::shared_ptr<int64_t>> result;
         IntegerPacket *p = resp.get()->packet_cast<IntegerPacket>();
@@ -0,0 +1,70 @@
+/*
+ *  Copyright (c) 2023 Tair
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+#include "client/TairSink.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "common/Logger.hpp"
+
+namespace tair::client {
+
+BulkStringSink TairSink::toFd(int fd) {
+    struct stat st = {};
+    if (::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+        LOG_ERROR("TairSink::toFd needs a regular file, fd: {}", fd);
+        return [](const char *, size_t) {
+            return false;
+        };
+    }
+    return [fd](const char *data, size_t len) {
+        while (len > 0) {
+            ssize_t n = ::write(fd, data, len);
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                // EAGAIN included, waiting for the fd would stall every client on the IO thread
+                LOG_ERROR("TairSink::toFd write failed, fd: {}, errno: {}", fd, errno);
+                return false;
+            }
+            data += n;
+            len -= n;
+        }
+        return true;
+    };
+}
+
+BulkStringSink TairSink::toBuffer(char *data, size_t capacity) {
+    return [data, capacity, offset = (size_t)0](const char *chunk, size_t len) mutable {
+        if (len > capacity - offset) {
+            return false;
+        }
+        std::memcpy(data + offset, chunk, len);
+        offset += len;
+        return true;
+    };
+}
+
+} // namespace tair::client
@@ -0,0 +1,43 @@
+/*
+ *  Copyright (c) 2023 Tair
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+#pragma once
+
+#include <cstddef>
+
+#include "client/TairClientDefine.hpp"
+
+namespace tair::client {
+
+// Ready-made sinks for getToSink, the body is delivered chunk by chunk as it arrives.
+// Sinks run on the IO thread, which every client of the process shares, so they must not block
+class TairSink {
+public:
+    // Write every chunk to fd, stops receiving on write error. Regular files only, a pipe or
+    // socket could block the shared IO thread or refuse a chunk with EAGAIN, so it fails at once
+    static BulkStringSink toFd(int fd);
+
+    // Copy into a caller owned buffer, stops receiving when the value exceeds capacity.
+    // The buffer must outlive the request.
+    static BulkStringSink toBuffer(char *data, size_t capacity);
+};
+
+} // namespace tair::client
@@ -0,0 +1,98 @@
+/*
+ *  Copyright (c) 2023 Tair
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+#include "client/TairSlotLoad.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+#include "common/ClockTime.hpp"
+
+#include "fmt/format.h"
+
+namespace tair::client {
+
+using common::ClockTime;
+using common::LockGuard;
+
+void TairSlotLoad::collect(const std::string &node, std::vector<SlotLoad> &loads) const {
+    for (int slot = 0; slot < KeyHash::SLOTS_NUM; ++slot) {
+        const auto &counters = slots_[slot];
+        uint64_t requests = counters.requests.load(std::memory_order_relaxed);
+        if (requests == 0) {
+            continue;
+        }
+        loads.push_back(SlotLoad{slot, node, requests, counters.request_bytes.load(std::memory_order_relaxed),
+                                 counters.reply_bytes.load(std::memory_order_relaxed)});
+    }
+}
+
+TairLoadTracker::TairLoadTracker()
+    : last_us_(ClockTime::intervalUs()) {}
+
+LoadReport TairLoadTracker::build(std::vector<SlotLoad> &&slots, const TairClientStats &stats) {
+    LoadReport report;
+    std::sort(slots.begin(), slots.end(), [](const SlotLoad &a, const SlotLoad &b) {
+        return a.slot != b.slot ? a.slot < b.slot : a.node < b.node;
+    });
+    report.slots = std::move(slots);
+    int64_t now = ClockTime::intervalUs();
+    LockGuard lock(mutex_);
+    report.interval_us = now - last_us_;
+    for (const auto &[node, counters] : stats.counters) {
+        auto &load = report.nodes[node];
+        load.requests = counters.requests;
+        load.errors = counters.errors;
+        if (auto it = stats.nodes.find(node); it != stats.nodes.end()) {
+            load.latency = it->second;
+        }
+        auto &last = last_[node];
+        // The node's client was made again after a topology change, its counters restarted
+        if (counters.requests < last.requests || counters.errors < last.errors) {
+            last = NodeCounters{};
+        }
+        uint64_t requests = counters.requests - last.requests;
+        if (report.interval_us > 0) {
+            load.qps = static_cast<double>(requests) * 1000 * 1000 / static_cast<double>(report.interval_us);
+        }
+        if (requests > 0) {
+            load.error_rate = static_cast<double>(counters.errors - last.errors) / static_cast<double>(requests);
+        }
+        last = counters;
+    }
+    last_us_ = now;
+    return report;
+}
+
+std::string TairLoadTracker::dump(const LoadReport &report) {
+    std::string out;
+    for (const auto &[node, load] : report.nodes) {
+        fmt::format_to(std::back_inserter(out), "node {} {} {} {:.1f} {:.4f} {:.0f} {:.0f}\n", node, load.requests, load.errors,
+                       load.qps, load.error_rate, load.latency.p50_us, load.latency.p99_us);
+    }
+    for (const auto &slot : report.slots) {
+        fmt::format_to(std::back_inserter(out), "slot {} {} {} {} {}\n", slot.slot, slot.node, slot.requests,
+                       slot.request_bytes, slot.reply_bytes);
+    }
+    return out;
+}
+
+} // namespace tair::client
@@ -0,0 +1,98 @@
+/*
+ *  Copyright (c) 2023 Tair
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/KeyHash.hpp"
+#include "common/Mutex.hpp"
+#include "common/Noncopyable.hpp"
+#include "client/TairClientDefine.hpp"
+
+namespace tair::client {
+
+using common::KeyHash;
+using common::Mutex;
+using common::Noncopyable;
+
+// Requests and bytes per slot of one node. Each node has its own counters written by its loop
+// thread without locking, so recording never contends with other nodes or with callers
+class TairSlotLoad : private Noncopyable {
+public:
+    TairSlotLoad() = default;
+    ~TairSlotLoad() = default;
+
+    // Loop thread only, slot is -1 for commands without a key
+    void recordRequest(int slot, size_t bytes) {
+        if (slot >= 0 && slot < KeyHash::SLOTS_NUM) {
+            increment(slots_[slot].requests, 1);
+            increment(slots_[slot].request_bytes, bytes);
+        }
+    }
+    void recordReply(int slot, size_t bytes) {
+        if (slot >= 0 && slot < KeyHash::SLOTS_NUM) {
+            increment(slots_[slot].reply_bytes, bytes);
+        }
+    }
+
+    // Appends the slots with any request
+    void collect(const std::string &node, std::vector<SlotLoad> &loads) const;
+
+private:
+    static void increment(std::atomic<uint64_t> &counter, uint64_t value) {
+        counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+
+    struct Counters {
+        std::atomic<uint64_t> requests = 0;
+        std::atomic<uint64_t> request_bytes = 0;
+        std::atomic<uint64_t> reply_bytes = 0;
+    };
+    std::unique_ptr<Counters[]> slots_ = std::make_unique<Counters[]>(KeyHash::SLOTS_NUM);
+};
+
+// Turns slot loads and node stats into a LoadReport, rates are over the time since the previous build
+class TairLoadTracker : private Noncopyable {
+public:
+    TairLoadTracker();
+    ~TairLoadTracker() = default;
+
+    LoadReport build(std::vector<SlotLoad> &&slots, const TairClientStats &stats) EXCLUDES(mutex_);
+
+    // One line per node then one per slot, space separated for scripts:
+    //   node <addr> <requests> <errors> <qps> <error_rate> <p50_us> <p99_us>
+    //   slot <slot> <addr> <requests> <request_bytes> <reply_bytes>
+    static std::string dump(const LoadReport &report);
+
+private:
+    Mutex mutex_;
+    int64_t last_us_ GUARDED_BY(mutex_);
+    std::map<std::string, NodeCounters> last_ GUARDED_BY(mutex_);
+};
+
+} // namespace tair::client
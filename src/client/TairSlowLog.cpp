@@ -0,0 +1,57 @@
+/*
+ *  Copyright (c) 2023 Tair
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+#include "client/TairSlowLog.hpp"
+
+#include <algorithm>
+
+#include "common/Logger.hpp"
+
+namespace tair::client {
+
+using common::LockGuard;
+
+TairSlowLog::TairSlowLog(const SlowLogConfig &config)
+    : config_(config) {}
+
+void TairSlowLog::add(SlowRequestEntry &&entry) {
+    if (config_.log) {
+        LOG_WARN("TairClient slow request to {}: {} key: {} slot: {} bytes: {}/{} total: {}us "
+                 "queue: {}us network: {}us decode: {}us",
+                 entry.node, entry.command, entry.key, entry.slot, entry.request_bytes, entry.reply_bytes,
+                 entry.callback_us - entry.submit_us, entry.write_us - entry.submit_us,
+                 entry.first_byte_us - entry.write_us, entry.callback_us - entry.first_byte_us);
+    }
+    LockGuard lock(mutex_);
+    entry.id = next_id_++;
+    entries_.push_front(std::move(entry));
+    while (entries_.size() > std::max<size_t>(config_.capacity, 1)) {
+        entries_.pop_back();
+    }
+}
+
+std::vector<SlowRequestEntry> TairSlowLog::getEntries(size_t count) const {
+    LockGuard lock(mutex_);
+    count = std::min(count, entries_.size());
+    return {entries_.begin(), entries_.begin() + count};
+}
+
+} // namespace tair::client
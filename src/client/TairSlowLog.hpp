@@ -0,0 +1,59 @@
+/*
+ *  Copyright (c) 2023 Tair
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+#include "common/Mutex.hpp"
+#include "common/Noncopyable.hpp"
+#include "client/TairClientDefine.hpp"
+
+namespace tair::client {
+
+using common::Mutex;
+using common::Noncopyable;
+
+// Bounded log of slow replies of one node, the client side counterpart of SLOWLOG
+class TairSlowLog : private Noncopyable {
+public:
+    explicit TairSlowLog(const SlowLogConfig &config);
+    ~TairSlowLog() = default;
+
+    bool isSlow(int64_t latency_us) const {
+        return latency_us >= config_.threshold_us;
+    }
+
+    void add(SlowRequestEntry &&entry) EXCLUDES(mutex_);
+    // Newest first, at most count entries
+    std::vector<SlowRequestEntry> getEntries(size_t count) const EXCLUDES(mutex_);
+
+private:
+    const SlowLogConfig config_;
+    mutable Mutex mutex_;
+    std::deque<SlowRequestEntry> entries_ GUARDED_BY(mutex_);
+    uint64_t next_id_ GUARDED_BY(mutex_) = 0;
+};
+
+} // namespace tair::client
@@ -73,10 +73,9 @@ void TairSubscribeClient::onRecvResponse(const PacketPtr &resp) {
     } else {
         runtimeAssert(!callbacks_.empty());
         // auth、subscribe、unsubscribe、psubscribe、 punsubscribe or error
-        auto [init_time, req, callback] = callbacks_.front();
-        int64_t latency_us = ClockTime::intervalUs() - init_time;
-        callback(req, resp, latency_us);
-        callbacks_.pop_front();
+        CallBackContext ctx = popFrontCallback();
+        int64_t latency_us = ClockTime::intervalUs() - ctx.init_time;
+        invokeCallback(ctx.callback, ctx.req, resp, latency_us);
     }
 }
 
@@ -0,0 +1,53 @@
+/*
+ *  Copyright (c) 2023 Tair
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+#include "client/TairTracepoints.hpp"
+
+#include "protocol/packet/resp/ArrayPacket.hpp"
+#include "protocol/packet/resp/BulkStringPacket.hpp"
+
+TRACING_SDT_DEFINE_SEMAPHORE(tair_client, submit)
+TRACING_SDT_DEFINE_SEMAPHORE(tair_client, encode)
+TRACING_SDT_DEFINE_SEMAPHORE(tair_client, socket_write)
+TRACING_SDT_DEFINE_SEMAPHORE(tair_client, socket_read)
+TRACING_SDT_DEFINE_SEMAPHORE(tair_client, decode)
+TRACING_SDT_DEFINE_SEMAPHORE(tair_client, callback_start)
+TRACING_SDT_DEFINE_SEMAPHORE(tair_client, callback_end)
+TRACING_SDT_DEFINE_SEMAPHORE(tair_client, reconnect)
+TRACING_SDT_DEFINE_SEMAPHORE(tair_client, cluster_redirect)
+
+namespace tair::client {
+
+using protocol::ArrayPacket;
+using protocol::BulkStringPacket;
+
+std::atomic<uint64_t> TairTracepoints::next_request_id_{1};
+
+const char *TairTracepoints::commandName(const PacketPtr &req) {
+    auto *array = req ? req->packet_cast<ArrayPacket>() : nullptr;
+    if (!array || array->getPacketArray().empty()) {
+        return "";
+    }
+    auto *cmd = array->getPacketArray()[0]->packet_cast<BulkStringPacket>();
+    return cmd ? cmd->getValue().c_str() : "";
+}
+
+} // namespace tair::client
@@ -0,0 +1,80 @@
+/*
+ *  Copyright (c) 2023 Tair
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include "common/tracing/StaticTracepoint.hpp"
+#include "protocol/packet/Packet.hpp"
+
+// USDT probes along the life of a request, all under provider tair_client:
+//   submit         (id, command, node, request_bytes)  request handed to sendCommand
+//   encode         (id, command, node, request_bytes)  request encoded into the connection
+//   socket_write   (id, node, bytes)                   bytes written, id of the last request fully written or 0
+//   socket_read    (id, node, bytes)                   bytes readable, id of the request being decoded or 0
+//   decode         (id, command, node, reply_bytes)    reply decoded
+//   callback_start (id, command, node, latency_us)
+//   callback_end   (id, command, node, callback_us)
+//   reconnect      (node, inflight, reason)
+//   cluster_redirect (command, node, error)            MOVED or ASK reply
+// Each has a semaphore, arguments are only built while a tracer is attached, e.g.
+//   bpftrace -e 'usdt:./app:tair_client:decode { @[str(arg1)] = hist(arg3); }'
+TRACING_SDT_DECLARE_SEMAPHORE(tair_client, submit);
+TRACING_SDT_DECLARE_SEMAPHORE(tair_client, encode);
+TRACING_SDT_DECLARE_SEMAPHORE(tair_client, socket_write);
+TRACING_SDT_DECLARE_SEMAPHORE(tair_client, socket_read);
+TRACING_SDT_DECLARE_SEMAPHORE(tair_client, decode);
+TRACING_SDT_DECLARE_SEMAPHORE(tair_client, callback_start);
+TRACING_SDT_DECLARE_SEMAPHORE(tair_client, callback_end);
+TRACING_SDT_DECLARE_SEMAPHORE(tair_client, reconnect);
+TRACING_SDT_DECLARE_SEMAPHORE(tair_client, cluster_redirect);
+
+namespace tair::client {
+
+using protocol::PacketPtr;
+
+class TairTracepoints {
+public:
+    // An id to correlate the probes of one request, 0 while none of them is attached
+    static uint64_t nextRequestId() {
+        if (!isRequestTraced()) {
+            return 0;
+        }
+        return next_request_id_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static bool isRequestTraced() {
+        return TRACING_SDT_IS_ENABLED(tair_client, submit) || TRACING_SDT_IS_ENABLED(tair_client, encode)
+               || TRACING_SDT_IS_ENABLED(tair_client, socket_write) || TRACING_SDT_IS_ENABLED(tair_client, socket_read)
+               || TRACING_SDT_IS_ENABLED(tair_client, decode) || TRACING_SDT_IS_ENABLED(tair_client, callback_start)
+               || TRACING_SDT_IS_ENABLED(tair_client, callback_end);
+    }
+
+    // First element of a command array, "" if there is none
+    static const char *commandName(const PacketPtr &req);
+
+private:
+    static std::atomic<uint64_t> next_request_id_;
+};
+
+} // namespace tair::client
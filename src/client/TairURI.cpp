@@ -72,6 +72,74 @@ bool TairURI::isAutoReconnect() const {
     return auto_reconnect_;
 }
 
+int TairURI::getConnectionPoolSize() const {
+    return connection_pool_size_;
+}
+
+PoolSelectPolicy TairURI::getPoolSelectPolicy() const {
+    return pool_select_policy_;
+}
+
+bool TairURI::isReleaseRequestAfterWrite() const {
+    return release_request_after_write_;
+}
+
+size_t TairURI::getZeroCopyThreshold() const {
+    return zerocopy_threshold_;
+}
+
+bool TairURI::isTlsEnabled() const {
+    return tls_enabled_;
+}
+
+const TlsConfig &TairURI::getTlsConfig() const {
+    return tls_config_;
+}
+
+bool TairURI::isLazyConnect() const {
+    return lazy_connect_;
+}
+
+int TairURI::getDatabase() const {
+    return database_;
+}
+
+bool TairURI::isFastOpen() const {
+    return fast_open_;
+}
+
+size_t TairURI::getReconnectBufferSize() const {
+    return reconnect_buffer_size_;
+}
+
+int TairURI::getReconnectBufferTimeoutMs() const {
+    return reconnect_buffer_timeout_ms_;
+}
+
+int TairURI::getHedgeBudgetPercent() const {
+    return hedge_budget_percent_;
+}
+
+const RequestLimits &TairURI::getRequestLimits() const {
+    return request_limits_;
+}
+
+const SlowLogConfig &TairURI::getSlowLogConfig() const {
+    return slow_log_config_;
+}
+
+const HotKeyConfig &TairURI::getHotKeyConfig() const {
+    return hot_key_config_;
+}
+
+const BigKeyConfig &TairURI::getBigKeyConfig() const {
+    return big_key_config_;
+}
+
+bool TairURI::isSlotLoad() const {
+    return slot_load_;
+}
+
 EventLoop *TairURI::getLoop() const {
     return loop_;
 }
@@ -110,6 +178,83 @@ TairURIBuilder &TairURIBuilder::autoReconnect(bool reconnect) {
     return *this;
 }
 
+TairURIBuilder &TairURIBuilder::connectionPoolSize(int size) {
+    uri_.connection_pool_size_ = size;
+    return *this;
+}
+
+TairURIBuilder &TairURIBuilder::poolSelectPolicy(PoolSelectPolicy policy) {
+    uri_.pool_select_policy_ = policy;
+    return *this;
+}
+
+TairURIBuilder &TairURIBuilder::releaseRequestAfterWrite(bool release) {
+    uri_.release_request_after_write_ = release;
+    return *this;
+}
+
+TairURIBuilder &TairURIBuilder::zeroCopyThreshold(size_t bytes) {
+    uri_.zerocopy_threshold_ = bytes;
+    return *this;
+}
+
+TairURIBuilder &TairURIBuilder::tls(TlsConfig config) {
+    uri_.tls_enabled_ = true;
+    uri_.tls_config_ = std::move(config);
+    return *this;
+}
+
+TairURIBuilder &TairURIBuilder::lazyConnect(bool lazy) {
+    uri_.lazy_connect_ = lazy;
+    return *this;
+}
+
+TairURIBuilder &TairURIBuilder::database(int db) {
+    uri_.database_ = db;
+    return *this;
+}
+
+TairURIBuilder &TairURIBuilder::fastOpen(bool on) {
+    uri_.fast_open_ = on;
+    return *this;
+}
+
+TairURIBuilder &TairURIBuilder::reconnectBuffer(size_t size, int timeout_ms) {
+    uri_.reconnect_buffer_size_ = size;
+    uri_.reconnect_buffer_timeout_ms_ = timeout_ms;
+    return *this;
+}
+
+TairURIBuilder &TairURIBuilder::hedgeBudgetPercent(int percent) {
+    uri_.hedge_budget_percent_ = percent;
+    return *this;
+}
+
+TairURIBuilder &TairURIBuilder::requestLimits(RequestLimits limits) {
+    uri_.request_limits_ = std::move(limits);
+    return *this;
+}
+
+TairURIBuilder &TairURIBuilder::slowLog(SlowLogConfig config) {
+    uri_.slow_log_config_ = config;
+    return *this;
+}
+
+TairURIBuilder &TairURIBuilder::hotKeys(HotKeyConfig config) {
+    uri_.hot_key_config_ = config;
+    return *this;
+}
+
+TairURIBuilder &TairURIBuilder::bigKeys(BigKeyConfig config) {
+    uri_.big_key_config_ = config;
+    return *this;
+}
+
+TairURIBuilder &TairURIBuilder::slotLoad(bool enable) {
+    uri_.slot_load_ = enable;
+    return *this;
+}
+
 TairURIBuilder &TairURIBuilder::user(std::string user) {
     uri_.user_ = std::move(user);
     return *this;
@@ -24,6 +24,9 @@
 #include <string>
 #include <vector>
 
+#include "network/TlsOptions.hpp"
+#include "client/TairClientDefine.hpp"
+
 namespace tair::network {
 class EventLoop;
 } // namespace tair::network
@@ -31,6 +34,7 @@ class EventLoop;
 namespace tair::client {
 
 using network::EventLoop;
+using network::TlsConfig;
 
 class TairURIBuilder;
 
@@ -48,6 +52,23 @@ public:
     int getReconnectIntervalMs() const;
     int getKeepAliveSeconds() const;
     bool isAutoReconnect() const;
+    int getConnectionPoolSize() const;
+    PoolSelectPolicy getPoolSelectPolicy() const;
+    bool isReleaseRequestAfterWrite() const;
+    size_t getZeroCopyThreshold() const;
+    bool isTlsEnabled() const;
+    const TlsConfig &getTlsConfig() const;
+    bool isLazyConnect() const;
+    int getDatabase() const;
+    bool isFastOpen() const;
+    size_t getReconnectBufferSize() const;
+    int getReconnectBufferTimeoutMs() const;
+    int getHedgeBudgetPercent() const;
+    const RequestLimits &getRequestLimits() const;
+    const SlowLogConfig &getSlowLogConfig() const;
+    const HotKeyConfig &getHotKeyConfig() const;
+    const BigKeyConfig &getBigKeyConfig() const;
+    bool isSlotLoad() const;
     const std::string &getUser() const;
     const std::string &getPassword() const;
     EventLoop *getLoop() const;
@@ -62,6 +83,23 @@ private:
     int reconnect_interval_ms_ = -1;
     int keepalive_seconds_ = 60;
     bool auto_reconnect_ = true;
+    int connection_pool_size_ = 1;
+    PoolSelectPolicy pool_select_policy_ = PoolSelectPolicy::LEAST_INFLIGHT;
+    bool release_request_after_write_ = false;
+    size_t zerocopy_threshold_ = 0;
+    bool tls_enabled_ = false;
+    TlsConfig tls_config_{};
+    bool lazy_connect_ = false;
+    int database_ = 0;
+    bool fast_open_ = false;
+    size_t reconnect_buffer_size_ = 4096;
+    int reconnect_buffer_timeout_ms_ = 2000;
+    int hedge_budget_percent_ = 0;
+    RequestLimits request_limits_{};
+    SlowLogConfig slow_log_config_{};
+    HotKeyConfig hot_key_config_{};
+    BigKeyConfig big_key_config_{};
+    bool slot_load_ = false;
     std::string user_;
     std::string password_;
     EventLoop *loop_ = nullptr;
@@ -79,6 +117,34 @@ public:
     TairURIBuilder &reconnectIntervalMs(int timeout_ms);
     TairURIBuilder &keepalive(int seconds);
     TairURIBuilder &autoReconnect(bool reconnect);
+    TairURIBuilder &connectionPoolSize(int size);
+    TairURIBuilder &poolSelectPolicy(PoolSelectPolicy policy);
+    // The req passed to reply callbacks is nullptr when enabled
+    TairURIBuilder &releaseRequestAfterWrite(bool release);
+    // Send values of at least bytes with MSG_ZEROCOPY, 0 disables
+    TairURIBuilder &zeroCopyThreshold(size_t bytes);
+    // Connect over TLS, the config builds a context of this client alone, shared by its connections
+    TairURIBuilder &tls(TlsConfig config);
+    // Connect each node on its first request instead of in init
+    TairURIBuilder &lazyConnect(bool lazy);
+    // Selected in the connection handshake, cluster nodes only accept 0
+    TairURIBuilder &database(int db);
+    // TCP Fast Open, saves the connect round trip on reconnects to a server that supports it
+    TairURIBuilder &fastOpen(bool on);
+    // Requests made while reconnecting wait for up to timeout_ms in a buffer of size entries, 0 fails them at once
+    TairURIBuilder &reconnectBuffer(size_t size, int timeout_ms);
+    // Resend slow reads on another pooled connection, at most percent extra reads, needs connectionPoolSize > 1
+    TairURIBuilder &hedgeBudgetPercent(int percent);
+    // Caps in-flight requests, in-flight bytes and qps per node, see RequestLimits
+    TairURIBuilder &requestLimits(RequestLimits limits);
+    // Keeps replies slower than config.threshold_us in a ring per node, read back with TairClient::getSlowLog
+    TairURIBuilder &slowLog(SlowLogConfig config);
+    // Samples request keys into per window top-K sketches per node, read back with TairClient::getHotKeys
+    TairURIBuilder &hotKeys(HotKeyConfig config);
+    // Flags requests and replies over the size thresholds and keeps the largest keys per node, read back with TairClient::getBigKeys
+    TairURIBuilder &bigKeys(BigKeyConfig config);
+    // Counts requests and bytes per slot on each node, read back with TairClient::getLoad
+    TairURIBuilder &slotLoad(bool enable);
     TairURIBuilder &user(std::string user);
     TairURIBuilder &password(std::string password);
     TairURIBuilder &eventloop(EventLoop *loop);
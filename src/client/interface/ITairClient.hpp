@@ -21,6 +21,7 @@
  */
 #pragma once
 
+#include "network/TlsOptions.hpp"
 #include "client/TairClientDefine.hpp"
 #include "client/TairResult.hpp"
 #include "client/params/ParamsAll.hpp"
@@ -28,6 +29,8 @@
 
 namespace tair::client {
 
+using network::TlsClientContext;
+
 class ITairClient {
 public:
     ITairClient() = default;
@@ -45,6 +48,28 @@ public:
     virtual void setReconnectIntervalMs(int timeout_ms) = 0;
     virtual void setAutoReconnect(bool reconnect) = 0;
     virtual void setKeepAliveSeconds(int seconds) = 0;
+    virtual void setConnectionPoolSize(int size) = 0;
+    virtual void setPoolSelectPolicy(PoolSelectPolicy policy) = 0;
+    virtual void setReleaseRequestAfterWrite(bool release) = 0;
+    virtual void setZeroCopyThreshold(size_t bytes) = 0;
+    virtual void setTls(std::shared_ptr<TlsClientContext> context) = 0;
+    virtual void setLazyConnect(bool lazy) = 0;
+    virtual void setDatabase(int db) = 0;
+    virtual void setFastOpen(bool on) = 0;
+    virtual void setReconnectBufferSize(size_t size) = 0;
+    virtual void setReconnectBufferTimeoutMs(int timeout_ms) = 0;
+    virtual void setHedgeBudgetPercent(int percent) = 0;
+    virtual void setRequestLimits(const RequestLimits &limits) = 0;
+
+    virtual TairClientStats getStats() const = 0;
+    virtual void setSlowLog(const SlowLogConfig &config) = 0;
+    virtual std::vector<SlowRequestEntry> getSlowLog(size_t count) const = 0;
+    virtual void setHotKeys(const HotKeyConfig &config) = 0;
+    virtual HotKeyReport getHotKeys() const = 0;
+    virtual void setBigKeys(const BigKeyConfig &config) = 0;
+    virtual BigKeyReport getBigKeys() const = 0;
+    virtual void setSlotLoad(bool enable) = 0;
+    virtual LoadReport getLoad() const = 0;
 
     // send command
     virtual void sendCommand(CommandArgv &&argv, const ResultPacketCallback &callback) = 0;
@@ -53,6 +78,9 @@ public:
     virtual void sendCommand(CommandArgv &&argv, const ResultPacketAndLatencyCallback &callback) = 0;
     virtual void sendCommand(const CommandArgv &argv, const ResultPacketAndLatencyCallback &callback) = 0;
 
+    virtual void sendCommand(CommandArgv &&argv, const ResultPacketAndTimingCallback &callback) = 0;
+    virtual void sendCommand(const CommandArgv &argv, const ResultPacketAndTimingCallback &callback) = 0;
+
     // generic
     virtual void del(const std::string &key, const ResultIntegerCallback &callback) = 0;
     virtual void del(InitializerList<std::string> keys, const ResultIntegerCallback &callback) = 0;
@@ -107,7 +135,10 @@ public:
     virtual void getset(const std::string &key, const std::string &value, const ResultStringPtrCallback &callback) = 0;
     virtual void set(const std::string &key, const std::string &value, const SetParams &params, const ResultStringCallback &callback) = 0;
     virtual void set(const std::string &key, const std::string &value, const ResultStringCallback &callback) = 0;
+    // The value is shared rather than copied into the request, a large one is written straight from it
+    virtual void set(const std::string &key, std::shared_ptr<const std::string> value, const ResultStringCallback &callback) = 0;
     virtual void get(const std::string &key, const ResultStringPtrCallback &callback) = 0;
+    virtual void getToSink(const std::string &key, const BulkStringSink &sink, const ResultIntegerPtrCallback &callback) = 0;
     virtual void incr(const std::string &key, const ResultIntegerCallback &callback) = 0;
     virtual void incrby(const std::string &key, int64_t increment, const ResultIntegerCallback &callback) = 0;
     virtual void incrbyfloat(const std::string &key, double increment, const ResultStringCallback &callback) = 0;
@@ -0,0 +1,161 @@
+/*
+ *  Copyright (c) 2023 Tair
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "common/Assert.hpp"
+
+namespace tair::common {
+
+template <typename Signature, size_t InlineSize = 48>
+class MoveOnlyFunction;
+
+// A move-only std::function replacement. Callables up to InlineSize bytes are stored
+// inline, so wrapping a lambda that captures a std::function and a pointer does not allocate.
+template <typename R, typename... Args, size_t InlineSize>
+class MoveOnlyFunction<R(Args...), InlineSize> {
+public:
+    MoveOnlyFunction() noexcept = default;
+    MoveOnlyFunction(std::nullptr_t) noexcept {}
+
+    template <typename F, typename FF = std::decay_t<F>,
+              typename = std::enable_if_t<!std::is_same_v<FF, MoveOnlyFunction> && std::is_invocable_r_v<R, FF &, Args...>>>
+    MoveOnlyFunction(F &&f) {
+        if constexpr (std::is_pointer_v<FF> || std::is_member_pointer_v<FF> || isStdFunction<FF>::value) {
+            if (!f) {
+                return;
+            }
+        }
+        if constexpr (storedInline<FF>()) {
+            ::new (static_cast<void *>(storage_)) FF(std::forward<F>(f));
+            ops_ = &inlineOps<FF>;
+        } else {
+            ::new (static_cast<void *>(storage_)) FF *(new FF(std::forward<F>(f)));
+            ops_ = &heapOps<FF>;
+        }
+    }
+
+    MoveOnlyFunction(MoveOnlyFunction &&other) noexcept {
+        moveFrom(other);
+    }
+
+    MoveOnlyFunction &operator=(MoveOnlyFunction &&other) noexcept {
+        if (this != &other) {
+            reset();
+            moveFrom(other);
+        }
+        return *this;
+    }
+
+    MoveOnlyFunction &operator=(std::nullptr_t) noexcept {
+        reset();
+        return *this;
+    }
+
+    MoveOnlyFunction(const MoveOnlyFunction &) = delete;
+    MoveOnlyFunction &operator=(const MoveOnlyFunction &) = delete;
+
+    ~MoveOnlyFunction() {
+        reset();
+    }
+
+    explicit operator bool() const noexcept {
+        return ops_ != nullptr;
+    }
+
+    R operator()(Args... args) const {
+        runtimeAssert(ops_ != nullptr);
+        return ops_->invoke(storage_, std::forward<Args>(args)...);
+    }
+
+    void reset() noexcept {
+        if (ops_) {
+            ops_->destroy(storage_);
+            ops_ = nullptr;
+        }
+    }
+
+    template <typename F>
+    constexpr static bool storedInline() {
+        return sizeof(F) <= InlineSize && alignof(std::max_align_t) % alignof(F) == 0
+               && std::is_nothrow_move_constructible_v<F>;
+    }
+
+private:
+    struct Ops {
+        R (*invoke)(void *storage, Args &&...args);
+        void (*move)(void *dst, void *src) noexcept;
+        void (*destroy)(void *storage) noexcept;
+    };
+
+    template <typename F>
+    struct isStdFunction : std::false_type {};
+    template <typename S>
+    struct isStdFunction<std::function<S>> : std::true_type {};
+
+    template <typename F>
+    constexpr static Ops inlineOps = {
+        [](void *storage, Args &&...args) -> R {
+            return std::invoke(*static_cast<F *>(storage), std::forward<Args>(args)...);
+        },
+        [](void *dst, void *src) noexcept {
+            ::new (dst) F(std::move(*static_cast<F *>(src)));
+            static_cast<F *>(src)->~F();
+        },
+        [](void *storage) noexcept {
+            static_cast<F *>(storage)->~F();
+        },
+    };
+
+    template <typename F>
+    constexpr static Ops heapOps = {
+        [](void *storage, Args &&...args) -> R {
+            return std::invoke(**static_cast<F **>(storage), std::forward<Args>(args)...);
+        },
+        [](void *dst, void *src) noexcept {
+            ::new (dst) F *(*static_cast<F **>(src));
+        },
+        [](void *storage) noexcept {
+            delete *static_cast<F **>(storage);
+        },
+    };
+
+    void moveFrom(MoveOnlyFunction &other) noexcept {
+        if (other.ops_) {
+            other.ops_->move(storage_, other.storage_);
+            ops_ = other.ops_;
+            other.ops_ = nullptr;
+        }
+    }
+
+private:
+    static_assert(InlineSize >= sizeof(void *), "inline storage must hold at least a pointer");
+    alignas(std::max_align_t) mutable unsigned char storage_[InlineSize];
+    const Ops *ops_ = nullptr;
+};
+
+} // namespace tair::common
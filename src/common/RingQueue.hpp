@@ -0,0 +1,125 @@
+/*
+ *  Copyright (c) 2023 Tair
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+#pragma once
+
+#include <memory>
+#include <new>
+#include <utility>
+
+#include "common/Assert.hpp"
+#include "common/Noncopyable.hpp"
+
+namespace tair::common {
+
+// A growable FIFO on one contiguous power-of-two array, elements are moved in and out
+// and the storage is reused, unlike std::deque which allocates and frees chunks.
+template <typename T>
+class RingQueue final : private Noncopyable {
+public:
+    explicit RingQueue(size_t capacity = 16) {
+        capacity_ = 1;
+        while (capacity_ < capacity) {
+            capacity_ <<= 1;
+        }
+        data_ = allocator_.allocate(capacity_);
+    }
+
+    ~RingQueue() {
+        clear();
+        allocator_.deallocate(data_, capacity_);
+    }
+
+    template <typename... Args>
+    T &emplace_back(Args &&...args) {
+        if (size_ == capacity_) {
+            grow();
+        }
+        T *slot = data_ + ((head_ + size_) & (capacity_ - 1));
+        ::new (static_cast<void *>(slot)) T(std::forward<Args>(args)...);
+        ++size_;
+        return *slot;
+    }
+
+    T &front() {
+        runtimeAssert(size_ > 0);
+        return data_[head_];
+    }
+
+    const T &front() const {
+        runtimeAssert(size_ > 0);
+        return data_[head_];
+    }
+
+    T &operator[](size_t index) {
+        return data_[(head_ + index) & (capacity_ - 1)];
+    }
+
+    void pop_front() {
+        runtimeAssert(size_ > 0);
+        data_[head_].~T();
+        head_ = (head_ + 1) & (capacity_ - 1);
+        --size_;
+    }
+
+    void clear() {
+        while (size_ > 0) {
+            pop_front();
+        }
+        head_ = 0;
+    }
+
+    size_t size() const {
+        return size_;
+    }
+
+    bool empty() const {
+        return size_ == 0;
+    }
+
+    size_t capacity() const {
+        return capacity_;
+    }
+
+private:
+    void grow() {
+        size_t new_capacity = capacity_ << 1;
+        T *new_data = allocator_.allocate(new_capacity);
+        for (size_t i = 0; i < size_; ++i) {
+            T *old = data_ + ((head_ + i) & (capacity_ - 1));
+            ::new (static_cast<void *>(new_data + i)) T(std::move(*old));
+            old->~T();
+        }
+        allocator_.deallocate(data_, capacity_);
+        data_ = new_data;
+        capacity_ = new_capacity;
+        head_ = 0;
+    }
+
+private:
+    std::allocator<T> allocator_;
+    T *data_ = nullptr;
+    size_t capacity_ = 0;
+    size_t head_ = 0;
+    size_t size_ = 0;
+};
+
+} // namespace tair::common
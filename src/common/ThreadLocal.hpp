@@ -22,6 +22,7 @@
 #pragma once
 
 #include <pthread.h>
+#include <functional>
 #include <unordered_set>
 
 #include "common/Assert.hpp"
@@ -33,7 +34,12 @@ namespace tair::common {
 template <typename T>
 class ThreadLocal : private Noncopyable {
 public:
-    ThreadLocal() {
+    ThreadLocal()
+        : ThreadLocal([] { return new T(); }) {}
+
+    // factory creates the value of each thread on its first access
+    explicit ThreadLocal(std::function<T *()> factory)
+        : factory_(std::move(factory)) {
         // we need store thread_local pointer to values_
         // so cannot use destructor arg of pthread_key_create to auto delete
         pthread_key_create(&pkey_, nullptr);
@@ -50,7 +56,7 @@ public:
     T *pointer() {
         T *value = static_cast<T *>(pthread_getspecific(pkey_));
         if (!value) {
-            T *newObj = new T();
+            T *newObj = factory_();
             pthread_setspecific(pkey_, newObj);
             value = newObj;
             LockGuard lock(mutex_);
@@ -66,6 +72,7 @@ public:
     }
 
 private:
+    std::function<T *()> factory_;
     Mutex mutex_;
     std::unordered_set<T *> values_ GUARDED_BY(mutex_);
     pthread_key_t pkey_;
@@ -62,6 +62,10 @@ void TokenBucket::refillTokens() {
     int64_t now = ClockTime::intervalMs();
     if (now > last_fill_time_ms_) {
         int64_t new_tokens = (now - last_fill_time_ms_) * tokens_per_sec_ / 1000;
+        if (new_tokens == 0) {
+            // Below 1000 tokens per second a millisecond earns nothing, keep counting from the old time
+            return;
+        }
         tokens_ += new_tokens;
         if (tokens_ > max_tokens_) {
             tokens_ = max_tokens_;
@@ -0,0 +1,250 @@
+/*
+ *  Copyright (c) 2023 Tair
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+#include "common/statistics/HdrHistogram.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace tair::common {
+
+namespace {
+
+constexpr std::string_view kMagic = "HDR1";
+
+void putVarint(std::string &out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+bool getVarint(std::string_view &in, uint64_t &value) {
+    value = 0;
+    for (int shift = 0; shift < 64 && !in.empty(); shift += 7) {
+        auto byte = static_cast<uint8_t>(in.front());
+        in.remove_prefix(1);
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void updateMin(std::atomic<uint64_t> &min, uint64_t value) {
+    uint64_t current = min.load(std::memory_order_relaxed);
+    while (value < current && !min.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+void updateMax(std::atomic<uint64_t> &max, uint64_t value) {
+    uint64_t current = max.load(std::memory_order_relaxed);
+    while (value > current && !max.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+} // namespace
+
+HdrHistogram::HdrHistogram(uint64_t highest_value, double precision)
+    : precision_(std::clamp(precision, 0.00001, 0.5)), highest_value_(std::max<uint64_t>(highest_value, 2)) {
+    // A bucket spans 1 / 2^(sub_bits - 1) of the lowest value it holds
+    sub_bits_ = static_cast<int>(std::ceil(std::log2(1 / precision_))) + 1;
+    sub_half_count_ = 1ULL << (sub_bits_ - 1);
+    bucket_count_ = indexOf(highest_value_) + 1;
+    counts_ = std::make_unique<std::atomic<uint64_t>[]>(bucket_count_);
+}
+
+size_t HdrHistogram::indexOf(uint64_t value) const {
+    value = std::min(value, highest_value_);
+    int pow = 63 - __builtin_clzll(value | ((sub_half_count_ << 1) - 1));
+    int shift = pow - (sub_bits_ - 1);
+    return shift * sub_half_count_ + (value >> shift);
+}
+
+uint64_t HdrHistogram::lowestOf(size_t index) const {
+    size_t shift = index < (sub_half_count_ << 1) ? 0 : index / sub_half_count_ - 1;
+    return (index - shift * sub_half_count_) << shift;
+}
+
+uint64_t HdrHistogram::lowestEquivalent(uint64_t value) const {
+    return lowestOf(indexOf(value));
+}
+
+uint64_t HdrHistogram::highestEquivalent(uint64_t value) const {
+    return lowestOf(indexOf(value) + 1) - 1;
+}
+
+void HdrHistogram::record(uint64_t value, uint64_t count) {
+    counts_[indexOf(value)].fetch_add(count, std::memory_order_relaxed);
+    total_count_.fetch_add(count, std::memory_order_relaxed);
+    sum_.fetch_add(value * count, std::memory_order_relaxed);
+    updateMin(min_, value);
+    updateMax(max_, value);
+}
+
+void HdrHistogram::recordSingleWriter(uint64_t value) {
+    auto &count = counts_[indexOf(value)];
+    count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    total_count_.store(total_count_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    sum_.store(sum_.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    if (value < min_.load(std::memory_order_relaxed)) {
+        min_.store(value, std::memory_order_relaxed);
+    }
+    if (value > max_.load(std::memory_order_relaxed)) {
+        max_.store(value, std::memory_order_relaxed);
+    }
+}
+
+bool HdrHistogram::merge(const HdrHistogram &other) {
+    if (other.sub_bits_ != sub_bits_ || other.bucket_count_ != bucket_count_) {
+        return false;
+    }
+    // The total is summed from the buckets, a concurrent writer may be ahead in its other counters
+    uint64_t total = 0;
+    for (size_t i = 0; i < bucket_count_; ++i) {
+        uint64_t count = other.counts_[i].load(std::memory_order_relaxed);
+        if (count) {
+            counts_[i].fetch_add(count, std::memory_order_relaxed);
+            total += count;
+        }
+    }
+    if (total == 0) {
+        return true;
+    }
+    total_count_.fetch_add(total, std::memory_order_relaxed);
+    sum_.fetch_add(other.getSum(), std::memory_order_relaxed);
+    updateMin(min_, other.min_.load(std::memory_order_relaxed));
+    updateMax(max_, other.getMax());
+    return true;
+}
+
+void HdrHistogram::reset() {
+    for (size_t i = 0; i < bucket_count_; ++i) {
+        counts_[i].store(0, std::memory_order_relaxed);
+    }
+    total_count_ = 0;
+    sum_ = 0;
+    min_ = UINT64_MAX;
+    max_ = 0;
+}
+
+uint64_t HdrHistogram::getMin() const {
+    return getCount() ? min_.load(std::memory_order_relaxed) : 0;
+}
+
+uint64_t HdrHistogram::getMean() const {
+    uint64_t count = getCount();
+    return count ? getSum() / count : 0;
+}
+
+uint64_t HdrHistogram::getValueAtPercentile(double perc) const {
+    uint64_t total = 0;
+    for (size_t i = 0; i < bucket_count_; ++i) {
+        total += counts_[i].load(std::memory_order_relaxed);
+    }
+    if (total == 0) {
+        return 0;
+    }
+    perc = std::clamp(perc, 0.0, 100.0);
+    auto target = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(perc / 100 * total)));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < bucket_count_; ++i) {
+        seen += counts_[i].load(std::memory_order_relaxed);
+        if (seen >= target) {
+            return std::min(lowestOf(i + 1) - 1, getMax());
+        }
+    }
+    return getMax();
+}
+
+std::string HdrHistogram::serialize() const {
+    std::string out(kMagic);
+    uint64_t precision_bits;
+    ::memcpy(&precision_bits, &precision_, sizeof(precision_bits));
+    putVarint(out, highest_value_);
+    putVarint(out, precision_bits);
+    putVarint(out, min_.load(std::memory_order_relaxed));
+    putVarint(out, getMax());
+    putVarint(out, getSum());
+    size_t last = 0;
+    for (size_t i = 0; i < bucket_count_; ++i) {
+        uint64_t count = counts_[i].load(std::memory_order_relaxed);
+        if (count) {
+            putVarint(out, i - last);
+            putVarint(out, count);
+            last = i;
+        }
+    }
+    return out;
+}
+
+std::unique_ptr<HdrHistogram> HdrHistogram::deserialize(std::string_view data) {
+    if (data.substr(0, kMagic.size()) != kMagic) {
+        return nullptr;
+    }
+    data.remove_prefix(kMagic.size());
+    uint64_t highest_value, precision_bits, min, max, sum;
+    if (!getVarint(data, highest_value) || !getVarint(data, precision_bits) || !getVarint(data, min)
+        || !getVarint(data, max) || !getVarint(data, sum)) {
+        return nullptr;
+    }
+    double precision;
+    ::memcpy(&precision, &precision_bits, sizeof(precision));
+    if (!(precision > 0 && precision < 1)) {
+        return nullptr;
+    }
+    auto histogram = std::make_unique<HdrHistogram>(highest_value, precision);
+    uint64_t index = 0, total = 0;
+    while (!data.empty()) {
+        uint64_t gap, count;
+        if (!getVarint(data, gap) || !getVarint(data, count)) {
+            return nullptr;
+        }
+        index += gap;
+        if (index >= histogram->bucket_count_) {
+            return nullptr;
+        }
+        histogram->counts_[index].store(count, std::memory_order_relaxed);
+        total += count;
+    }
+    histogram->total_count_ = total;
+    histogram->sum_ = sum;
+    histogram->min_ = min;
+    histogram->max_ = max;
+    return histogram;
+}
+
+ThreadLocalHdrHistogram::ThreadLocalHdrHistogram(uint64_t highest_value, double precision)
+    : highest_value_(highest_value), precision_(precision),
+      histograms_([highest_value, precision] { return new HdrHistogram(highest_value, precision); }) {}
+
+std::unique_ptr<HdrHistogram> ThreadLocalHdrHistogram::snapshot() {
+    auto merged = std::make_unique<HdrHistogram>(highest_value_, precision_);
+    for (auto *histogram : histograms_.getAllPointers()) {
+        merged->merge(*histogram);
+    }
+    return merged;
+}
+
+} // namespace tair::common
@@ -0,0 +1,110 @@
+/*
+ *  Copyright (c) 2023 Tair
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "common/Noncopyable.hpp"
+#include "common/ThreadLocal.hpp"
+
+namespace tair::common {
+
+// Log-linear histogram in the manner of HdrHistogram. Values below 2^sub_bits get a bucket each,
+// every power of two above is split into 2^(sub_bits-1) equal buckets, so no bucket is wider than
+// precision times the values it holds. Values over highest_value are counted in the last bucket.
+// Counters are relaxed atomics: record() is safe from any thread, readers may run concurrently
+class HdrHistogram : private Noncopyable {
+public:
+    constexpr static uint64_t kDefaultHighestValue = 3600UL * 1000 * 1000; // one hour in us
+
+    explicit HdrHistogram(uint64_t highest_value = kDefaultHighestValue, double precision = 0.01);
+    ~HdrHistogram() = default;
+
+    void record(uint64_t value, uint64_t count = 1);
+    // record() without read-modify-write instructions, for a histogram written by one thread only
+    void recordSingleWriter(uint64_t value);
+    // Adds the counts of other, false if its layout differs
+    bool merge(const HdrHistogram &other);
+    void reset();
+
+    uint64_t getCount() const { return total_count_.load(std::memory_order_relaxed); }
+    uint64_t getMin() const;
+    uint64_t getMax() const { return max_.load(std::memory_order_relaxed); }
+    uint64_t getSum() const { return sum_.load(std::memory_order_relaxed); }
+    uint64_t getMean() const;
+    // Highest value equivalent to the sample at perc percent, never more than getMax()
+    uint64_t getValueAtPercentile(double perc) const;
+
+    uint64_t getHighestValue() const { return highest_value_; }
+    double getPrecision() const { return precision_; }
+    size_t getBucketCount() const { return bucket_count_; }
+    // Range [lowest, highest] of the values sharing the bucket of value
+    uint64_t lowestEquivalent(uint64_t value) const;
+    uint64_t highestEquivalent(uint64_t value) const;
+
+    // Compact binary form for shipping snapshots between processes, only non empty buckets are kept
+    std::string serialize() const;
+    // nullptr if data is not a serialized histogram
+    static std::unique_ptr<HdrHistogram> deserialize(std::string_view data);
+
+private:
+    size_t indexOf(uint64_t value) const;
+    uint64_t lowestOf(size_t index) const;
+
+    double precision_;
+    uint64_t highest_value_;
+    int sub_bits_;
+    uint64_t sub_half_count_;
+    size_t bucket_count_;
+    std::unique_ptr<std::atomic<uint64_t>[]> counts_;
+    std::atomic<uint64_t> total_count_ = 0;
+    std::atomic<uint64_t> sum_ = 0;
+    std::atomic<uint64_t> min_ = UINT64_MAX;
+    std::atomic<uint64_t> max_ = 0;
+};
+
+// One HdrHistogram per recording thread, so recorders never contend on a cache line.
+// snapshot() merges the threads without stopping them
+class ThreadLocalHdrHistogram : private Noncopyable {
+public:
+    explicit ThreadLocalHdrHistogram(uint64_t highest_value = HdrHistogram::kDefaultHighestValue, double precision = 0.01);
+    ~ThreadLocalHdrHistogram() = default;
+
+    void record(uint64_t value) {
+        histograms_.pointer()->recordSingleWriter(value);
+    }
+
+    std::unique_ptr<HdrHistogram> snapshot();
+
+private:
+    uint64_t highest_value_;
+    double precision_;
+    ThreadLocal<HdrHistogram> histograms_;
+};
+
+} // namespace tair::common
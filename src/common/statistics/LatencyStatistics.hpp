@@ -24,7 +24,12 @@
 #include <array>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
 #include <ostream>
+#include <string>
+#include <vector>
 
 #include "common/ClockTime.hpp"
 #include "common/Mutex.hpp"
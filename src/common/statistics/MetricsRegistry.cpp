@@ -0,0 +1,196 @@
+/*
+ *  Copyright (c) 2023 Tair
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+#include "common/statistics/MetricsRegistry.hpp"
+
+#include <cmath>
+#include <iterator>
+
+#include "common/CPUStatistics.hpp"
+#include "common/Logger.hpp"
+#include "common/MemoryStat.hpp"
+#include "common/statistics/HdrHistogram.hpp"
+#include "common/statistics/LatencyStatistics.hpp"
+
+#include "fmt/format.h"
+
+namespace tair::common {
+
+static void appendValue(std::string &out, double value) {
+    if (std::isnan(value)) {
+        out += "NaN";
+    } else if (std::isinf(value)) {
+        out += value > 0 ? "+Inf" : "-Inf";
+    } else {
+        fmt::format_to(std::back_inserter(out), "{}", value);
+    }
+}
+
+static void appendEscaped(std::string &out, const std::string &value) {
+    for (char c : value) {
+        if (c == '\\' || c == '"') {
+            out += '\\';
+            out += c;
+        } else if (c == '\n') {
+            out += "\\n";
+        } else {
+            out += c;
+        }
+    }
+}
+
+MetricSet::Family *MetricSet::familyOf(const std::string &name, Type type, const std::string &help) {
+    auto [iter, inserted] = families_.try_emplace(name, Family{type, help, {}});
+    if (!inserted && iter->second.type != type) {
+        LOG_WARN("metric {} is registered with another type, sample dropped", name);
+        return nullptr;
+    }
+    return &iter->second;
+}
+
+void MetricSet::appendSample(std::string &out, const std::string &name, const MetricLabels &labels,
+                             const std::pair<std::string, std::string> *extra_label, double value) {
+    out += name;
+    if (!labels.empty() || extra_label) {
+        char sep = '{';
+        for (const auto &[key, label] : labels) {
+            out += sep;
+            out += key;
+            out += "=\"";
+            appendEscaped(out, label);
+            out += '"';
+            sep = ',';
+        }
+        if (extra_label) {
+            fmt::format_to(std::back_inserter(out), "{}{}=\"{}\"", sep, extra_label->first, extra_label->second);
+        }
+        out += '}';
+    }
+    out += ' ';
+    appendValue(out, value);
+    out += '\n';
+}
+
+void MetricSet::addCounter(const std::string &name, const std::string &help, const MetricLabels &labels, double value) {
+    if (auto *family = familyOf(name, Type::COUNTER, help)) {
+        appendSample(family->samples, name + "_total", labels, nullptr, value);
+    }
+}
+
+void MetricSet::addGauge(const std::string &name, const std::string &help, const MetricLabels &labels, double value) {
+    if (auto *family = familyOf(name, Type::GAUGE, help)) {
+        appendSample(family->samples, name, labels, nullptr, value);
+    }
+}
+
+void MetricSet::addSummary(const std::string &name, const std::string &help, const MetricLabels &labels,
+                           uint64_t count, double sum, const std::vector<std::pair<double, double>> &quantiles) {
+    auto *family = familyOf(name, Type::SUMMARY, help);
+    if (!family) {
+        return;
+    }
+    for (const auto &[quantile, value] : quantiles) {
+        std::pair<std::string, std::string> label("quantile", fmt::format("{}", quantile));
+        appendSample(family->samples, name, labels, &label, value);
+    }
+    appendSample(family->samples, name + "_sum", labels, nullptr, sum);
+    appendSample(family->samples, name + "_count", labels, nullptr, count);
+}
+
+void MetricSet::addLatencySummary(const std::string &name, const std::string &help, const MetricLabels &labels, const HdrHistogram &histogram) {
+    constexpr double kUsPerSecond = 1e6;
+    addSummary(name, help, labels, histogram.getCount(), histogram.getSum() / kUsPerSecond,
+               {{0.5, histogram.getValueAtPercentile(50) / kUsPerSecond},
+                {0.99, histogram.getValueAtPercentile(99) / kUsPerSecond},
+                {0.999, histogram.getValueAtPercentile(99.9) / kUsPerSecond}});
+}
+
+void MetricSet::addLatencySummary(const std::string &name, const std::string &help, const MetricLabels &labels, const LatencyMetric &metric) {
+    constexpr double kUsPerSecond = 1e6;
+    addSummary(name, help, labels, metric.getOpCount(), metric.getLatencyUsSum() / kUsPerSecond,
+               {{0.5, metric.getLatencyUsPerc(50) / kUsPerSecond},
+                {0.99, metric.getLatencyUsPerc(99) / kUsPerSecond},
+                {0.999, metric.getLatencyUsPerc(99.9) / kUsPerSecond}});
+}
+
+std::string MetricSet::toOpenMetrics() const {
+    static const char *kTypeNames[] = {"counter", "gauge", "summary"};
+    std::string out;
+    for (const auto &[name, family] : families_) {
+        fmt::format_to(std::back_inserter(out), "# TYPE {} {}\n", name, kTypeNames[static_cast<int>(family.type)]);
+        if (!family.help.empty()) {
+            out += "# HELP ";
+            out += name;
+            out += ' ';
+            appendEscaped(out, family.help);
+            out += '\n';
+        }
+        out += family.samples;
+    }
+    out += "# EOF\n";
+    return out;
+}
+
+int64_t MetricsRegistry::addCollector(Collector collector) {
+    LockGuard lock(mutex_);
+    int64_t id = next_id_++;
+    collectors_.emplace(id, std::move(collector));
+    return id;
+}
+
+void MetricsRegistry::removeCollector(int64_t id) {
+    LockGuard lock(mutex_);
+    collectors_.erase(id);
+}
+
+void MetricsRegistry::collect(MetricSet &metrics) const {
+    // Held during the scrape so a removed collector never runs late
+    LockGuard lock(mutex_);
+    for (const auto &[_, collector] : collectors_) {
+        collector(metrics);
+    }
+}
+
+std::string MetricsRegistry::render() const {
+    MetricSet metrics;
+    collect(metrics);
+    return metrics.toOpenMetrics();
+}
+
+void MetricsRegistry::collectProcessMetrics(MetricSet &metrics) {
+    MemoryStat::calcStatistics();
+    metrics.addGauge("tair_memory_rss_bytes", "Resident set size", {}, MemoryStat::getCachedRssMemorySize());
+    metrics.addGauge("tair_memory_allocated_bytes", "Bytes allocated by the allocator", {}, MemoryStat::getAllocatorAllocated());
+    metrics.addGauge("tair_memory_active_bytes", "Bytes in active allocator pages", {}, MemoryStat::getAllocatorActive());
+    metrics.addGauge("tair_memory_resident_bytes", "Bytes the allocator keeps resident", {}, MemoryStat::getAllocatorResident());
+    metrics.addGauge("tair_memory_peak_allocated_bytes", "Peak of the allocated bytes", {}, MemoryStat::getPeakMemorySize());
+    metrics.addGauge("tair_memory_system_bytes", "Memory of the host", {}, MemoryStat::getSystemMemorySize());
+
+    // Percentages cover the time since the previous scrape
+    static ProcessCPUStatistics cpu_statistics;
+    cpu_statistics.calcProcessUsage();
+    CPUStatInfo cpu = cpu_statistics.getLastStatistics();
+    metrics.addCounter("tair_process_cpu_seconds", "CPU time of the process", {{"mode", "system"}}, cpu.used_sys_ms / 1000);
+    metrics.addCounter("tair_process_cpu_seconds", "CPU time of the process", {{"mode", "user"}}, cpu.used_user_ms / 1000);
+    metrics.addGauge("tair_process_cpu_usage_percent", "CPU usage since the previous scrape", {}, cpu.usage_percent);
+}
+
+} // namespace tair::common
@@ -0,0 +1,110 @@
+/*
+ *  Copyright (c) 2023 Tair
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "common/Mutex.hpp"
+#include "common/Noncopyable.hpp"
+
+namespace tair::common {
+
+class HdrHistogram;
+class LatencyMetric;
+
+using MetricLabels = std::vector<std::pair<std::string, std::string>>;
+
+// Samples of one scrape grouped by metric family, rendered as OpenMetrics text.
+// Samples of a family may come from many collectors, the family is written once
+class MetricSet : private Noncopyable {
+public:
+    MetricSet() = default;
+    ~MetricSet() = default;
+
+    // name without the _total suffix, it is added to the sample
+    void addCounter(const std::string &name, const std::string &help, const MetricLabels &labels, double value);
+    void addGauge(const std::string &name, const std::string &help, const MetricLabels &labels, double value);
+    // quantiles are (quantile, value) pairs, quantile in [0, 1]
+    void addSummary(const std::string &name, const std::string &help, const MetricLabels &labels,
+                    uint64_t count, double sum, const std::vector<std::pair<double, double>> &quantiles);
+    // Microsecond samples as a summary in seconds with p50, p99 and p999
+    void addLatencySummary(const std::string &name, const std::string &help, const MetricLabels &labels, const HdrHistogram &histogram);
+    void addLatencySummary(const std::string &name, const std::string &help, const MetricLabels &labels, const LatencyMetric &metric);
+
+    size_t getFamilyCount() const { return families_.size(); }
+    std::string toOpenMetrics() const;
+
+private:
+    enum class Type {
+        COUNTER,
+        GAUGE,
+        SUMMARY,
+    };
+
+    struct Family {
+        Type type;
+        std::string help;
+        std::string samples;
+    };
+
+    // nullptr if name is taken by a family of another type
+    Family *familyOf(const std::string &name, Type type, const std::string &help);
+    static void appendSample(std::string &out, const std::string &name, const MetricLabels &labels,
+                             const std::pair<std::string, std::string> *extra_label, double value);
+
+    std::map<std::string, Family> families_;
+};
+
+// Collectors run on scrape only, so metrics are read from whatever the hot path already
+// keeps (atomics, histograms) and nothing is added to it. Singleton<MetricsRegistry>
+// serves as a process wide registry
+class MetricsRegistry : private Noncopyable {
+public:
+    using Collector = std::function<void(MetricSet &metrics)>;
+
+    MetricsRegistry() = default;
+    ~MetricsRegistry() = default;
+
+    // Returns an id for removeCollector. A collector must not add or remove collectors
+    int64_t addCollector(Collector collector) EXCLUDES(mutex_);
+    // Waits for a running scrape, the collector is not called once this returns
+    void removeCollector(int64_t id) EXCLUDES(mutex_);
+
+    // Runs every collector, safe from any thread
+    void collect(MetricSet &metrics) const EXCLUDES(mutex_);
+    std::string render() const;
+
+    // Memory of MemoryStat and CPU time of the process
+    static void collectProcessMetrics(MetricSet &metrics);
+
+private:
+    mutable Mutex mutex_;
+    int64_t next_id_ GUARDED_BY(mutex_) = 1;
+    std::map<int64_t, Collector> collectors_ GUARDED_BY(mutex_);
+};
+
+} // namespace tair::common
@@ -0,0 +1,104 @@
+/*
+ *  Copyright (c) 2023 Tair
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+#include "common/statistics/TopKSketch.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <limits>
+
+namespace tair::common {
+
+TopKSketch::TopKSketch(size_t k, size_t width, size_t depth)
+    : k_(k), width_(std::bit_ceil(std::max<size_t>(width, 1))), depth_(std::max<size_t>(depth, 1)), counters_(width_ * depth_, 0) {
+    top_.reserve(k_ + 1);
+}
+
+uint64_t TopKSketch::add(std::string_view key, uint64_t increment) {
+    uint64_t hash = std::hash<std::string_view>()(key);
+    uint64_t current = std::numeric_limits<uint64_t>::max();
+    for (size_t row = 0; row < depth_; ++row) {
+        current = std::min(current, counters_[indexOf(hash, row)]);
+    }
+    // Conservative update, only the counters at the minimum need to grow
+    uint64_t estimate = current + increment;
+    for (size_t row = 0; row < depth_; ++row) {
+        uint64_t &counter = counters_[indexOf(hash, row)];
+        counter = std::max(counter, estimate);
+    }
+    updateTop(key, estimate);
+    return estimate;
+}
+
+uint64_t TopKSketch::estimate(std::string_view key) const {
+    uint64_t hash = std::hash<std::string_view>()(key);
+    uint64_t estimate = std::numeric_limits<uint64_t>::max();
+    for (size_t row = 0; row < depth_; ++row) {
+        estimate = std::min(estimate, counters_[indexOf(hash, row)]);
+    }
+    return estimate;
+}
+
+void TopKSketch::updateTop(std::string_view key, uint64_t estimate) {
+    if (k_ == 0) {
+        return;
+    }
+    if (top_.size() == k_ && estimate <= top_min_) {
+        return;
+    }
+    if (auto iter = top_.find(key); iter != top_.end()) {
+        iter->second = estimate;
+        return;
+    }
+    if (top_.size() < k_) {
+        top_.emplace(key, estimate);
+        top_min_ = top_.size() == 1 ? estimate : std::min(top_min_, estimate);
+        return;
+    }
+    auto min_iter = std::min_element(top_.begin(), top_.end(), [](const auto &a, const auto &b) {
+        return a.second < b.second;
+    });
+    top_min_ = min_iter->second;
+    if (estimate <= top_min_) {
+        return;
+    }
+    top_.erase(min_iter);
+    top_.emplace(key, estimate);
+    top_min_ = std::min_element(top_.begin(), top_.end(), [](const auto &a, const auto &b) {
+                   return a.second < b.second;
+               })->second;
+}
+
+std::vector<std::pair<std::string, uint64_t>> TopKSketch::getTopK() const {
+    std::vector<std::pair<std::string, uint64_t>> top(top_.begin(), top_.end());
+    std::sort(top.begin(), top.end(), [](const auto &a, const auto &b) {
+        return a.second > b.second || (a.second == b.second && a.first < b.first);
+    });
+    return top;
+}
+
+void TopKSketch::clear() {
+    std::fill(counters_.begin(), counters_.end(), 0);
+    top_.clear();
+    top_min_ = 0;
+}
+
+} // namespace tair::common
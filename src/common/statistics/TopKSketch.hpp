@@ -0,0 +1,77 @@
+/*
+ *  Copyright (c) 2023 Tair
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "common/Noncopyable.hpp"
+
+namespace tair::common {
+
+// Count-min sketch with conservative update, estimates never fall below the true count.
+// The k keys with the highest estimates are tracked alongside, so memory is fixed at
+// width * depth counters plus k keys whatever the key space
+class TopKSketch : private Noncopyable {
+public:
+    // width is rounded up to a power of two
+    explicit TopKSketch(size_t k, size_t width = 1024, size_t depth = 4);
+    ~TopKSketch() = default;
+
+    // Returns the estimate of key after the add
+    uint64_t add(std::string_view key, uint64_t increment = 1);
+    uint64_t estimate(std::string_view key) const;
+
+    // Heaviest first
+    std::vector<std::pair<std::string, uint64_t>> getTopK() const;
+    void clear();
+
+private:
+    // Rows take h1 + i * h2 of one hash (Kirsch-Mitzenmacher)
+    size_t indexOf(uint64_t hash, size_t row) const {
+        uint64_t h2 = (hash >> 32) | 1;
+        return row * width_ + ((hash + row * h2) & (width_ - 1));
+    }
+    void updateTop(std::string_view key, uint64_t estimate);
+
+    // Lets top_ be searched by string_view
+    struct TransparentHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view key) const { return std::hash<std::string_view>()(key); }
+    };
+
+    size_t k_;
+    size_t width_;
+    size_t depth_;
+    std::vector<uint64_t> counters_;
+    std::unordered_map<std::string, uint64_t, TransparentHash, std::equal_to<>> top_;
+    // Lower bound of the smallest estimate in top_, exact after each eviction scan
+    uint64_t top_min_ = 0;
+};
+
+} // namespace tair::common
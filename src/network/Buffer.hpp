@@ -27,6 +27,7 @@
 #include "common/Copyable.hpp"
 #include "common/Endianconv.hpp"
 #include "common/StringUtil.hpp"
+#include "network/BufferPool.hpp"
 
 #include "fmt/format.h"
 
@@ -69,7 +70,7 @@ public:
           read_index_(reserved_prepend_size),
           write_index_(reserved_prepend_size),
           reserved_prepend_size_(reserved_prepend_size) {
-        buffer_ = new char[capacity_];
+        buffer_ = BufferPool::allocate(capacity_);
         runtimeAssert(length() == 0);
         runtimeAssert(writableBytes() == initial_size);
         runtimeAssert(prependableBytes() == reserved_prepend_size);
@@ -78,7 +79,7 @@ public:
 
     ~Buffer() {
         subBufferStatSize(buffer_);
-        delete[] buffer_;
+        BufferPool::deallocate(buffer_, capacity_);
         buffer_ = nullptr;
         capacity_ = 0;
         read_index_ = 0;
@@ -111,7 +112,7 @@ public:
         read_index_ = rhs.read_index_;
         write_index_ = rhs.write_index_;
         reserved_prepend_size_ = rhs.reserved_prepend_size_;
-        buffer_ = new char[capacity_];
+        buffer_ = BufferPool::allocate(capacity_);
         runtimeAssert(write_index_ >= read_index_);
         memcpy(buffer_ + read_index_, rhs.buffer_ + read_index_, write_index_ - read_index_);
         addBufferStatSize(buffer_);
@@ -122,13 +123,13 @@ public:
             return *this;
         }
         subBufferStatSize(buffer_);
-        delete[] buffer_;
+        BufferPool::deallocate(buffer_, capacity_);
         type_ = rhs.type_;
         capacity_ = rhs.capacity_;
         read_index_ = rhs.read_index_;
         write_index_ = rhs.write_index_;
         reserved_prepend_size_ = rhs.reserved_prepend_size_;
-        buffer_ = new char[capacity_];
+        buffer_ = BufferPool::allocate(capacity_);
         runtimeAssert(write_index_ >= read_index_);
         memcpy(buffer_ + read_index_, rhs.buffer_ + read_index_, write_index_ - read_index_);
         addBufferStatSize(buffer_);
@@ -151,12 +152,12 @@ public:
     // Reinit to empty buffer
     void reinit() {
         subBufferStatSize(buffer_);
-        delete[] buffer_;
+        BufferPool::deallocate(buffer_, capacity_);
         capacity_ = kInitialSize + kCheapPrependSize;
         read_index_ = kCheapPrependSize;
         write_index_ = kCheapPrependSize;
         reserved_prepend_size_ = kCheapPrependSize;
-        buffer_ = new char[capacity_];
+        buffer_ = BufferPool::allocate(capacity_);
         addBufferStatSize(buffer_);
     }
 
@@ -553,15 +554,16 @@ private:
     void grow(size_t len) {
         if (writableBytes() + prependableBytes() < len + reserved_prepend_size_) {
             // grow the capacity
-            size_t n = (capacity_ << 1) + len;
+            // round up to the pooled block size, the whole block is usable
+            size_t n = BufferPool::blockSize((capacity_ << 1) + len);
             size_t m = length();
-            char *new_buf = new char[n];
+            char *new_buf = BufferPool::allocate(n);
             memcpy(new_buf + reserved_prepend_size_, begin() + read_index_, m);
             write_index_ = m + reserved_prepend_size_;
             read_index_ = reserved_prepend_size_;
-            capacity_ = n;
             subBufferStatSize(buffer_);
-            delete[] buffer_;
+            BufferPool::deallocate(buffer_, capacity_);
+            capacity_ = n;
             buffer_ = new_buf;
             addBufferStatSize(buffer_);
         } else {
@@ -0,0 +1,129 @@
+/*
+ *  Copyright (c) 2023 Tair
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+#include "network/BufferPool.hpp"
+
+#include <sys/mman.h>
+
+#include <cstdlib>
+
+#include "common/Assert.hpp"
+#include "network/EventLoop.hpp"
+#include "network/NetworkStat.hpp"
+
+namespace tair::network {
+
+std::atomic<size_t> BufferPool::max_cached_bytes_per_class_ = kDefaultMaxCachedBytesPerClass;
+std::atomic<bool> BufferPool::use_huge_pages_ = false;
+
+BufferPool::~BufferPool() {
+    for (size_t i = 0; i < kClassNum; ++i) {
+        size_t block_size = kMinClassSize << i;
+        for (char *ptr : free_lists_[i]) {
+            NetworkStat::subBufferPoolCachedSize(block_size);
+            freeBlock(ptr, block_size);
+        }
+        free_lists_[i].clear();
+    }
+}
+
+BufferPool *BufferPool::local() {
+    if (!EventLoop::getSelfLoop()) {
+        return nullptr;
+    }
+    static thread_local BufferPool pool;
+    return &pool;
+}
+
+size_t BufferPool::blockSize(size_t size) {
+    if (size < kMinClassSize || size > kMaxClassSize) {
+        return size;
+    }
+    size_t block_size = kMinClassSize;
+    while (block_size < size) {
+        block_size <<= 1;
+    }
+    return block_size;
+}
+
+int BufferPool::sizeClass(size_t block_size) {
+    if (block_size < kMinClassSize || block_size > kMaxClassSize || (block_size & (block_size - 1)) != 0) {
+        return -1;
+    }
+    return __builtin_ctzll(block_size) - __builtin_ctzll(kMinClassSize);
+}
+
+char *BufferPool::allocateBlock(size_t block_size) {
+    void *ptr = nullptr;
+#if defined(MADV_HUGEPAGE)
+    if (use_huge_pages_ && block_size >= kHugePageSize && block_size % kHugePageSize == 0) {
+        ptr = std::aligned_alloc(kHugePageSize, block_size);
+        if (ptr) {
+            ::madvise(ptr, block_size, MADV_HUGEPAGE);
+        }
+    }
+#endif
+    if (!ptr) {
+        ptr = std::malloc(block_size);
+    }
+    runtimeAssert(ptr != nullptr);
+    return static_cast<char *>(ptr);
+}
+
+void BufferPool::freeBlock(char *ptr, size_t) {
+    std::free(ptr);
+}
+
+char *BufferPool::allocate(size_t size) {
+    size_t block_size = blockSize(size);
+    int index = sizeClass(block_size);
+    if (index >= 0) {
+        BufferPool *pool = local();
+        if (pool && !pool->free_lists_[index].empty()) {
+            char *ptr = pool->free_lists_[index].back();
+            pool->free_lists_[index].pop_back();
+            NetworkStat::subBufferPoolCachedSize(block_size);
+            NetworkStat::addBufferPoolHit(1);
+            return ptr;
+        }
+        NetworkStat::addBufferPoolMiss(1);
+    }
+    return allocateBlock(block_size);
+}
+
+void BufferPool::deallocate(char *ptr, size_t size) {
+    if (!ptr) {
+        return;
+    }
+    size_t block_size = blockSize(size);
+    int index = sizeClass(block_size);
+    if (index >= 0) {
+        BufferPool *pool = local();
+        if (pool && (pool->free_lists_[index].size() + 1) * block_size <= max_cached_bytes_per_class_) {
+            pool->free_lists_[index].push_back(ptr);
+            NetworkStat::addBufferPoolCachedSize(block_size);
+            return;
+        }
+    }
+    freeBlock(ptr, block_size);
+}
+
+} // namespace tair::network
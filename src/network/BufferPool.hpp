@@ -0,0 +1,82 @@
+/*
+ *  Copyright (c) 2023 Tair
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+#include "common/Noncopyable.hpp"
+
+namespace tair::network {
+
+using common::Noncopyable;
+
+// Size-classed free lists for Buffer storage. Each loop thread owns one pool, so
+// borrowing and returning blocks needs no lock. Storage is allocated normally on
+// threads without an event loop, and capacities outside the size classes are
+// never cached.
+class BufferPool : private Noncopyable {
+public:
+    static char *allocate(size_t size);
+    static void deallocate(char *ptr, size_t size);
+
+    // The block size that backs a buffer of this capacity
+    static size_t blockSize(size_t size);
+
+    // Upper limit of bytes cached by one size class in one loop
+    static void setMaxCachedBytesPerClass(size_t bytes) {
+        max_cached_bytes_per_class_ = bytes;
+    }
+
+    // Back blocks of at least kHugePageSize with transparent huge pages
+    static void setUseHugePages(bool enable) {
+        use_huge_pages_ = enable;
+    }
+
+    static bool isUseHugePages() {
+        return use_huge_pages_;
+    }
+
+    constexpr static size_t kMinClassSize = 16 * 1024;
+    constexpr static size_t kMaxClassSize = 8 * 1024 * 1024;
+    constexpr static size_t kClassNum = 10;
+    constexpr static size_t kHugePageSize = 2 * 1024 * 1024;
+    constexpr static size_t kDefaultMaxCachedBytesPerClass = 8 * 1024 * 1024;
+
+private:
+    BufferPool() = default;
+    ~BufferPool();
+
+    static BufferPool *local();
+    static int sizeClass(size_t block_size);
+    static char *allocateBlock(size_t block_size);
+    static void freeBlock(char *ptr, size_t block_size);
+
+private:
+    std::array<std::vector<char *>, kClassNum> free_lists_;
+    static std::atomic<size_t> max_cached_bytes_per_class_;
+    static std::atomic<bool> use_huge_pages_;
+};
+
+} // namespace tair::network
@@ -21,9 +21,13 @@
  */
 #include "network/Connector.hpp"
 
+#include <algorithm>
+#include <random>
+
 #include "common/Logger.hpp"
 #include "common/SystemUtil.hpp"
 #include "network/Channel.hpp"
+#include "network/DnsCache.hpp"
 #include "network/EventLoop.hpp"
 #include "network/EventWatcher.hpp"
 #include "network/Sockets.hpp"
@@ -34,6 +38,16 @@ using common::SystemUtil;
 
 const Duration Connector::kInitRetryDelayTime = Duration(500 * Duration::kMillisecond);
 const Duration Connector::kMaxRetryDelayTime = Duration(30 * Duration::kSecond);
+const Duration Connector::kAttemptDelayTime = Duration(250 * Duration::kMillisecond);
+
+// Equal jitter: half the backoff is fixed, the other half random, so clients dropped
+// together by one server restart do not all come back in the same instant
+static Duration jitter(const Duration &delay) {
+    static thread_local std::minstd_rand engine(std::random_device{}());
+    int64_t half = delay.nanoseconds() / 2;
+    std::uniform_int_distribution<int64_t> dist(0, half);
+    return Duration(half + dist(engine));
+}
 
 Connector::Connector(EventLoop *loop, const std::string &remote_ip_port, Duration connecting_timeout, bool need_retry)
     : status_(kDisconnected),
@@ -41,8 +55,6 @@ Connector::Connector(EventLoop *loop, const std::string &remote_ip_port, Duratio
       remote_ip_port_(remote_ip_port),
       connecting_timer_id_(0),
       connecting_timeout_(connecting_timeout),
-      fd_(-1),
-      own_fd_(false),
       need_retry_(need_retry),
       retry_delay_time_(kInitRetryDelayTime) {
     if (remote_ip_port.starts_with("tcp://") || remote_ip_port.starts_with("tls://")) {
@@ -51,20 +63,25 @@ Connector::Connector(EventLoop *loop, const std::string &remote_ip_port, Duratio
         }
         remote_ip_port_ = remote_ip_port.substr(6);
     }
-    remote_sockaddr_ = sockets::parseFromIPPort(remote_ip_port_.data());
+    if (!sockets::parseFromIPPort(remote_ip_port_.data(), remote_sockaddr_)) {
+        bool is_tls = false;
+        if (!sockets::splitTriadicAddress(remote_ip_port_.data(), is_tls, host_, port_)) {
+            host_.clear();
+        }
+    }
     LOG_TRACE("Connector() this: {}", (void *)this);
 }
 
 Connector::~Connector() {
     runtimeAssert(connecting_timer_id_ == 0);
-    runtimeAssert(!channel_ || channel_->isNoneEvent());
-    runtimeAssert(!own_fd_ && fd_ == -1);
+    runtimeAssert(attempt_timer_id_ == 0);
+    runtimeAssert(attempts_.empty());
     LOG_TRACE("~Connector() this: {}", (void *)this);
 }
 
 void Connector::start() {
     runtimeAssert(loop_->isInLoopThread());
-    if (!sockets::isZeroAddress(&remote_sockaddr_)) {
+    if (!host_.empty() || !sockets::isZeroAddress(&remote_sockaddr_)) {
         connect();
     } else {
         LOG_ERROR("Connector start failed, connect to wrong addr?");
@@ -81,71 +98,138 @@ void Connector::cancel() {
     need_retry_ = false;
     status_ = kDisconnected;
     closeTimer();
-    closeChannel();
-    closeFd();
+    closeAttempts();
 }
 
 void Connector::connect() {
     runtimeAssert(loop_->isInLoopThread());
-    runtimeAssert(fd_ == -1 && !own_fd_);
-    fd_ = sockets::createNonblockingSocket();
-    if (fd_ < 0) {
-        LOG_ERROR("create a nonblocking socket failed, errno: {}-> {}", errno, SystemUtil::errnoToString(errno));
-        handleError();
-        return;
-    }
-    own_fd_ = true;
+    runtimeAssert(attempts_.empty());
+    status_ = kConnecting;
+    uint64_t seq = ++connect_seq_;
 
-    // add connecting timeout timer
+    // add connecting timeout timer, it covers resolving and all attempts
     auto timeout_handler = [connector = shared_from_this()](EventLoop *) {
         connector->onConnectTimeout();
     };
     connecting_timer_id_ = loop_->runAfterTimer(connecting_timeout_, timeout_handler);
 
-    struct sockaddr *addr = sockets::sockaddr_cast(&remote_sockaddr_);
-    int rc = sockets::connectSocket(fd_, addr, sizeof(*addr));
-    if (rc != 0) {
-        if (!EVUTIL_ERR_CONNECT_RETRIABLE(errno)) {
-            handleError();
-            return;
-        }
+    if (host_.empty()) {
+        candidates_.assign(1, remote_sockaddr_);
+        next_candidate_ = 0;
+        startNextAttempt();
+        return;
     }
-    status_ = kConnecting;
-    channel_ = std::make_shared<Channel>(fd_);
-    channel_->setLoop(loop_);
-    channel_->setWriteCallback([connector = shared_from_this()]() {
-        connector->handleWrite();
+    // May call back right here when the answer is cached
+    DnsCache::instance().resolve(loop_, host_, connecting_timeout_, [weak_connector = weak_from_this(), seq](int errcode, const std::vector<std::string> &addrs) {
+        if (auto connector = weak_connector.lock()) {
+            connector->onResolved(seq, errcode, addrs);
+        }
     });
-    channel_->enableWriteEvent();
 }
 
-void Connector::handleWrite() {
+void Connector::onResolved(uint64_t seq, int errcode, const std::vector<std::string> &addrs) {
+    runtimeAssert(loop_->isInLoopThread());
+    if (seq != connect_seq_ || status_ != kConnecting || !attempts_.empty()) {
+        return;
+    }
+    candidates_.clear();
+    next_candidate_ = 0;
+    for (const auto &ip : addrs) {
+        struct sockaddr_storage ss;
+        if (sockets::parseFromIPPort((ip + ":" + std::to_string(port_)).data(), ss)) {
+            candidates_.push_back(ss);
+        }
+    }
+    if (candidates_.empty()) {
+        LOG_ERROR("Connector resolve host failed, host={} errcode={}", host_, errcode);
+        EVUTIL_SET_SOCKET_ERROR(EHOSTUNREACH);
+        handleError();
+        return;
+    }
+    startNextAttempt();
+}
+
+void Connector::startNextAttempt() {
+    if (attempt_timer_id_ != 0) {
+        loop_->cancelTimer(attempt_timer_id_);
+        attempt_timer_id_ = 0;
+    }
+    while (next_candidate_ < candidates_.size()) {
+        struct sockaddr *addr = sockets::sockaddr_cast(&candidates_[next_candidate_++]);
+        socket_t fd = sockets::createNonblockingSocket();
+        if (fd < 0) {
+            last_errno_ = errno;
+            LOG_ERROR("create a nonblocking socket failed, errno: {}-> {}", errno, SystemUtil::errnoToString(errno));
+            continue;
+        }
+        if (fast_open_) {
+            sockets::setFastOpenConnect(fd, true);
+        }
+        int rc = sockets::connectSocket(fd, addr, sizeof(*addr));
+        if (rc != 0 && !EVUTIL_ERR_CONNECT_RETRIABLE(errno)) {
+            last_errno_ = errno;
+            sockets::closeSocket(fd);
+            continue;
+        }
+        auto channel = std::make_shared<Channel>(fd);
+        channel->setLoop(loop_);
+        channel->setWriteCallback([connector = shared_from_this(), fd]() {
+            connector->handleWrite(fd);
+        });
+        channel->enableWriteEvent();
+        attempts_.push_back({fd, std::move(channel)});
+
+        if (next_candidate_ < candidates_.size()) {
+            attempt_timer_id_ = loop_->runAfterTimer(kAttemptDelayTime, [connector = shared_from_this()](EventLoop *) {
+                // timer auto removed by loop, just set id = 0
+                connector->attempt_timer_id_ = 0;
+                connector->startNextAttempt();
+            });
+        }
+        return;
+    }
+    if (attempts_.empty()) {
+        EVUTIL_SET_SOCKET_ERROR(last_errno_);
+        handleError();
+    }
+}
+
+void Connector::handleWrite(socket_t fd) {
     if (status_ == kDisconnected) {
         return;
     }
     runtimeAssert(status_ == kConnecting);
-    runtimeAssert(fd_ == channel_->fd());
-    int err = sockets::getSocketErrorCode(fd_);
-    if (err != 0) {
-        EVUTIL_SET_SOCKET_ERROR(err);
-        handleError();
+    auto iter = std::find_if(attempts_.begin(), attempts_.end(), [fd](const Attempt &attempt) {
+        return attempt.fd == fd;
+    });
+    if (iter == attempts_.end()) {
         return;
     }
-    LOG_TRACE("Connector success, now cancel timer and close write events");
-    status_ = kConnected;
-    closeTimer();
 
     // close channel will reset callback in channel, so we need hold myself
     // Avoid that the client has been deconstructed and myself will be deconstructed
     auto hold_myself = shared_from_this();
-    closeChannel();
+    Attempt attempt = std::move(*iter);
+    attempts_.erase(iter);
+    attempt.channel->closeEvent();
 
-    struct sockaddr_storage addr = sockets::getLocalAddr(fd_);
-    local_ip_port_ = sockets::toIPPort(&addr);
-    new_conn_callback_(fd_, local_ip_port_, remote_ip_port_, is_tls_);
+    int err = sockets::getSocketErrorCode(fd);
+    if (err != 0) {
+        last_errno_ = err;
+        sockets::closeSocket(fd);
+        // A failed address hands over to the next one right away, without waiting for the stagger
+        startNextAttempt();
+        return;
+    }
+    LOG_TRACE("Connector success, now cancel timer and close the losing attempts");
+    status_ = kConnected;
+    closeTimer();
+    closeAttempts();
 
-    own_fd_ = false; // move the ownership of the fd to TcpConnection
-    fd_ = -1;
+    struct sockaddr_storage addr = sockets::getLocalAddr(fd);
+    local_ip_port_ = sockets::toIPPort(&addr);
+    // move the ownership of the fd to TcpConnection
+    new_conn_callback_(fd, local_ip_port_, remote_ip_port_, is_tls_);
 }
 
 void Connector::handleError() {
@@ -153,15 +237,13 @@ void Connector::handleError() {
     status_ = kDisconnected;
 
     int saved_errno = errno;
-    LOG_ERROR("Connector error, status={} fd={} errno={} -> {}", statusToString(), fd_, saved_errno, SystemUtil::errnoToString(saved_errno));
+    LOG_ERROR("Connector error, status={} addr={} errno={} -> {}", statusToString(), remote_ip_port_, saved_errno, SystemUtil::errnoToString(saved_errno));
     closeTimer();
 
     // close channel will reset callback in channel, so we need hold myself
     // Avoid that the client has been deconstructed and myself will be deconstructed
     auto hold_myself = shared_from_this();
-    closeChannel();
-
-    closeFd();
+    closeAttempts();
 
     if (EVUTIL_ERR_CONNECT_REFUSED(saved_errno) || !need_retry_) {
         // notify error
@@ -169,7 +251,7 @@ void Connector::handleError() {
     }
 
     if (need_retry_) {
-        loop_->runAfterTimer(retry_delay_time_, [connector = shared_from_this()](EventLoop *) {
+        loop_->runAfterTimer(jitter(retry_delay_time_), [connector = shared_from_this()](EventLoop *) {
             connector->connect();
         });
         retry_delay_time_ *= 2;
@@ -181,7 +263,7 @@ void Connector::onConnectTimeout() {
     if (status_ == kConnected) {
         return;
     }
-    LOG_WARN("Connector::OnConnectTimeout status={} fd={} this={}", statusToString(), fd_, (void *)this);
+    LOG_WARN("Connector::OnConnectTimeout status={} attempts={} this={}", statusToString(), attempts_.size(), (void *)this);
     runtimeAssert(status_ == kConnecting);
 
     // timer auto removed by loop, just set id = 0
@@ -197,23 +279,20 @@ void Connector::closeTimer() {
         loop_->cancelTimer(connecting_timer_id_);
         connecting_timer_id_ = 0;
     }
-}
-
-void Connector::closeChannel() {
-    if (channel_) {
-        runtimeAssert(!channel_->hasReadableEvent());
-        runtimeAssert(channel_->hasWritableEvent());
-        channel_->closeEvent();
-        channel_.reset();
+    if (attempt_timer_id_ != 0) {
+        loop_->cancelTimer(attempt_timer_id_);
+        attempt_timer_id_ = 0;
     }
 }
 
-void Connector::closeFd() {
-    if (own_fd_ && fd_ != -1) {
-        sockets::closeSocket(fd_);
-        fd_ = -1;
-        own_fd_ = false;
+void Connector::closeAttempts() {
+    for (auto &attempt : attempts_) {
+        runtimeAssert(!attempt.channel->hasReadableEvent());
+        runtimeAssert(attempt.channel->hasWritableEvent());
+        attempt.channel->closeEvent();
+        sockets::closeSocket(attempt.fd);
     }
+    attempts_.clear();
 }
 
 std::string Connector::statusToString() const {
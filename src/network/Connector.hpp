@@ -23,6 +23,7 @@
 
 #include <string>
 #include <sys/socket.h>
+#include <vector>
 
 #include "common/Noncopyable.hpp"
 #include "network/Duration.hpp"
@@ -53,14 +54,21 @@ public:
         return status_ == kConnecting;
     }
 
+    // A fast open connect completes at once, so the first candidate wins without racing
+    void setFastOpen(bool on) {
+        fast_open_ = on;
+    }
+
 private:
     void connect();
-    void handleWrite();
+    void onResolved(uint64_t seq, int errcode, const std::vector<std::string> &addrs);
+    // Starts the next candidate and, if more remain, arms the stagger timer for the one after
+    void startNextAttempt();
+    void handleWrite(socket_t fd);
     void handleError();
     void onConnectTimeout();
     void closeTimer();
-    void closeChannel();
-    void closeFd();
+    void closeAttempts();
     std::string statusToString() const;
 
 private:
@@ -70,6 +78,14 @@ private:
 
     static const Duration kInitRetryDelayTime;
     static const Duration kMaxRetryDelayTime;
+    // Delay before racing the next resolved address, as in happy eyeballs (RFC 8305)
+    static const Duration kAttemptDelayTime;
+
+    // One in flight non-blocking connect, the Connector owns the fd until it wins
+    struct Attempt {
+        socket_t fd;
+        std::shared_ptr<Channel> channel;
+    };
 
     Status status_;
     EventLoop *loop_;
@@ -78,19 +94,25 @@ private:
     std::string local_ip_port_;
     std::string remote_ip_port_;
     struct sockaddr_storage remote_sockaddr_;
+    // Set when remote_ip_port_ names a host instead of an ip, resolved through DnsCache
+    std::string host_;
+    int port_ = 0;
 
     TimerId connecting_timer_id_;
+    TimerId attempt_timer_id_ = 0;
     Duration connecting_timeout_;
-    socket_t fd_;
 
-    // A flag indicate whether the Connector owns this fd
-    // If the Connector owns this fd, the Connector has responsibility to close this fd
-    bool own_fd_;
+    std::vector<struct sockaddr_storage> candidates_;
+    size_t next_candidate_ = 0;
+    std::vector<Attempt> attempts_;
+    int last_errno_ = 0;
+    // Bumped per connect(), drops resolve answers that belong to an older round
+    uint64_t connect_seq_ = 0;
 
     bool need_retry_;
     Duration retry_delay_time_;
+    bool fast_open_ = false;
 
-    std::shared_ptr<Channel> channel_;
     NewConnectionCallback new_conn_callback_;
 };
 
@@ -0,0 +1,127 @@
+/*
+ *  Copyright (c) 2023 Tair
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+#include "network/DnsCache.hpp"
+
+#include <event2/util.h>
+
+#include "common/ClockTime.hpp"
+#include "common/Logger.hpp"
+#include "network/DnsResolver.hpp"
+#include "network/EventLoop.hpp"
+
+namespace tair::network {
+
+using common::ClockTime;
+
+void DnsCache::resolve(EventLoop *loop, const std::string &host, Duration timeout, const ResolveCallback &callback) {
+    int64_t now = ClockTime::intervalMs();
+    bool answered = false;
+    bool need_lookup = false;
+    Entry answer;
+    {
+        LockGuard lock(mutex_);
+        bool running = inflight_.contains(host);
+        bool stale = false;
+        auto iter = entries_.find(host);
+        if (iter != entries_.end()) {
+            if (now < iter->second.expire_ms) {
+                answered = true;
+            } else if (iter->second.errcode == 0) {
+                answered = true;
+                stale = true;
+            }
+            if (answered) {
+                answer = iter->second;
+            }
+        }
+        if (!answered) {
+            inflight_[host].push_back({loop, callback});
+        } else if (stale && !running) {
+            inflight_.emplace(host, std::vector<Waiter>());
+        }
+        need_lookup = !running && (!answered || stale);
+    }
+    if (answered) {
+        loop->runInLoop([callback, answer = std::move(answer)](EventLoop *) {
+            callback(answer.errcode, answer.addrs);
+        });
+    }
+    if (need_lookup) {
+        startLookup(loop, host, timeout);
+    }
+}
+
+void DnsCache::startLookup(EventLoop *loop, const std::string &host, Duration timeout) {
+    lookup_count_++;
+    auto resolver = DnsResolver::createDnsResolver(loop, host, timeout, [host](int errcode, const std::vector<std::string> &addrs) {
+        DnsCache::instance().onLookupDone(host, errcode, addrs);
+    });
+    resolver->start();
+}
+
+void DnsCache::onLookupDone(const std::string &host, int errcode, const std::vector<std::string> &addrs) {
+    int64_t now = ClockTime::intervalMs();
+    std::vector<Waiter> waiters;
+    Entry answer;
+    {
+        LockGuard lock(mutex_);
+        auto inflight = inflight_.find(host);
+        if (inflight != inflight_.end()) {
+            waiters = std::move(inflight->second);
+            inflight_.erase(inflight);
+        }
+        auto &entry = entries_[host];
+        if (errcode == 0 && !addrs.empty()) {
+            entry = {0, addrs, now + ttl_ms_};
+        } else if (entry.errcode == 0 && !entry.addrs.empty()) {
+            // Refresh failed, keep serving the last good answer and retry later
+            entry.expire_ms = now + negative_ttl_ms_;
+        } else {
+            entry = {errcode != 0 ? errcode : EVUTIL_EAI_FAIL, {}, now + negative_ttl_ms_};
+        }
+        answer = entry;
+    }
+    LOG_DEBUG("DNS cache updated, host={} errcode={} addrs={}", host, answer.errcode, answer.addrs.size());
+    for (auto &waiter : waiters) {
+        waiter.loop->runInLoop([callback = std::move(waiter.callback), answer](EventLoop *) {
+            callback(answer.errcode, answer.addrs);
+        });
+    }
+}
+
+void DnsCache::setTtl(Duration ttl, Duration negative_ttl) {
+    LockGuard lock(mutex_);
+    ttl_ms_ = ttl.nanoseconds() / Duration::kMillisecond;
+    negative_ttl_ms_ = negative_ttl.nanoseconds() / Duration::kMillisecond;
+}
+
+void DnsCache::clear() {
+    LockGuard lock(mutex_);
+    entries_.clear();
+}
+
+size_t DnsCache::size() const {
+    LockGuard lock(mutex_);
+    return entries_.size();
+}
+
+} // namespace tair::network
@@ -0,0 +1,101 @@
+/*
+ *  Copyright (c) 2023 Tair
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "common/Mutex.hpp"
+#include "common/Noncopyable.hpp"
+#include "network/Duration.hpp"
+
+namespace tair::network {
+
+using common::LockGuard;
+using common::Mutex;
+using common::Noncopyable;
+
+class EventLoop;
+
+// Process wide host -> addresses cache shared by all Connectors, so a reconnect
+// storm costs one lookup per host instead of one per connection attempt.
+class DnsCache : private Noncopyable {
+public:
+    using ResolveCallback = std::function<void(int errcode, const std::vector<std::string> &addrs)>;
+
+    static DnsCache &instance() {
+        static DnsCache cache;
+        return cache;
+    }
+
+private:
+    DnsCache() = default;
+
+public:
+    ~DnsCache() = default;
+
+    // The callback runs in loop's thread, immediately when the answer is cached.
+    // Concurrent misses for one host share a single lookup. An expired positive
+    // entry is still answered right away while a refresh runs in the background,
+    // so connect latency after a failover does not wait on the resolver.
+    void resolve(EventLoop *loop, const std::string &host, Duration timeout, const ResolveCallback &callback) EXCLUDES(mutex_);
+
+    void setTtl(Duration ttl, Duration negative_ttl) EXCLUDES(mutex_);
+    void clear() EXCLUDES(mutex_);
+    size_t size() const EXCLUDES(mutex_);
+
+    uint64_t getLookupCount() const {
+        return lookup_count_;
+    }
+
+    constexpr static const int64_t DEFAULT_TTL_MS = 30 * 1000;
+    constexpr static const int64_t DEFAULT_NEGATIVE_TTL_MS = 5 * 1000;
+
+private:
+    struct Entry {
+        int errcode = 0;
+        std::vector<std::string> addrs;
+        int64_t expire_ms = 0;
+    };
+
+    struct Waiter {
+        EventLoop *loop;
+        ResolveCallback callback;
+    };
+
+    void startLookup(EventLoop *loop, const std::string &host, Duration timeout);
+    void onLookupDone(const std::string &host, int errcode, const std::vector<std::string> &addrs) EXCLUDES(mutex_);
+
+private:
+    mutable Mutex mutex_;
+    int64_t ttl_ms_ GUARDED_BY(mutex_) = DEFAULT_TTL_MS;
+    int64_t negative_ttl_ms_ GUARDED_BY(mutex_) = DEFAULT_NEGATIVE_TTL_MS;
+    std::unordered_map<std::string, Entry> entries_ GUARDED_BY(mutex_);
+    // A host present here has a lookup running, waiters are answered when it ends
+    std::unordered_map<std::string, std::vector<Waiter>> inflight_ GUARDED_BY(mutex_);
+    std::atomic<uint64_t> lookup_count_ = 0;
+};
+
+} // namespace tair::network
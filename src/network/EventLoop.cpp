@@ -94,22 +94,26 @@ void EventLoop::run() {
         LOG_CRITICAL("PipeEventWatcher init failed");
     }
     stopped_ = false;
-    if (before_sleep_call_back_) {
-        ::evwatch_prepare_new(
-            evbase_, [](struct evwatch *, const struct evwatch_prepare_cb_info *, void *arg) {
-                EventLoop *loop = (EventLoop *)arg;
+    // The user callbacks run on the busy side of the sleep
+    ::evwatch_prepare_new(
+        evbase_, [](struct evwatch *, const struct evwatch_prepare_cb_info *, void *arg) {
+            EventLoop *loop = (EventLoop *)arg;
+            if (loop->before_sleep_call_back_) {
                 loop->before_sleep_call_back_(loop);
-            },
-            this);
-    }
-    if (after_sleep_call_back_) {
-        ::evwatch_check_new(
-            evbase_, [](struct evwatch *, const struct evwatch_check_cb_info *, void *arg) {
-                EventLoop *loop = (EventLoop *)arg;
+            }
+            loop->monitor_.beforeSleep(ClockTime::intervalNs());
+        },
+        this);
+    ::evwatch_check_new(
+        evbase_, [](struct evwatch *, const struct evwatch_check_cb_info *, void *arg) {
+            EventLoop *loop = (EventLoop *)arg;
+            loop->monitor_.afterSleep(ClockTime::intervalNs());
+            if (loop->after_sleep_call_back_) {
                 loop->after_sleep_call_back_(loop);
-            },
-            this);
-    }
+            }
+        },
+        this);
+    monitor_.start(ClockTime::intervalNs());
     int rc = ::event_base_dispatch(evbase_);
     if (rc == 1) {
         LOG_ERROR("event_base_dispatch error: no event registered");
@@ -149,15 +153,38 @@ bool EventLoop::hasPendingTask() const {
     return !pending_functors_.empty() || do_pending_;
 }
 
+EventLoopStats EventLoop::getStats() const {
+    EventLoopStatsBuilder builder;
+    collectStats(builder);
+    return builder.build();
+}
+
+void EventLoop::collectStats(EventLoopStatsBuilder &builder) const {
+    size_t pending = 0;
+    int64_t oldest_age_us = 0;
+    {
+        LockGuard lock(mutex_);
+        pending = pending_functors_.size();
+        if (pending > 0) {
+            oldest_age_us = ClockTime::intervalUs() - pending_functors_.front().queue_us;
+        }
+    }
+    builder.add(monitor_, pending, oldest_age_us);
+}
+
 void EventLoop::doPendingFunctors() {
-    std::deque<std::pair<ExpectedLoopCallback, LoopTaskCallback>> functors, next_loop_functors;
+    std::deque<PendingFunctor> functors;
+    std::deque<std::pair<ExpectedLoopCallback, LoopTaskCallback>> next_loop_functors;
     {
         LockGuard lock(mutex_);
         functors.swap(pending_functors_);
         pending_notified_ = false;
         do_pending_ = true;
     }
-    for (auto &[expected_cb, task_cb] : functors) {
+    // One clock read per batch, a task's lag does not include the tasks run before it
+    int64_t now = functors.empty() ? 0 : ClockTime::intervalUs();
+    for (auto &[expected_cb, task_cb, queue_us] : functors) {
+        monitor_.recordTaskLag(now - queue_us);
         if (expected_cb) {
             auto expected_loop = expected_cb();
             // expected_cb return null, recheck in next loop
@@ -256,6 +283,9 @@ void EventLoop::cancelTimerInLoop(TimerId id) {
 
 void EventLoop::onTimerTriggered(TimerId id, bool periodic, const TimerHandler &callback) {
     runtimeAssert(isInLoopThread());
+    if (auto iter = timer_map_.find(id); iter != timer_map_.end()) {
+        monitor_.recordTimerSkew(iter->second->onFired(ClockTime::intervalUs()));
+    }
     callback(this);
     auto iter = timer_map_.find(id);
     if (iter == timer_map_.end()) {
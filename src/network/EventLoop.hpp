@@ -31,7 +31,9 @@
 #include <utility>
 
 #include "common/Assert.hpp"
+#include "common/ClockTime.hpp"
 #include "common/Mutex.hpp"
+#include "network/EventLoopStats.hpp"
 #include "network/EventWatcher.hpp"
 
 namespace tair::network {
@@ -39,6 +41,7 @@ namespace tair::network {
 using common::Noncopyable;
 using common::Mutex;
 using common::LockGuard;
+using common::ClockTime;
 
 class EventLoop final : private Noncopyable {
 public:
@@ -76,8 +79,7 @@ public:
     void queueInLoopMaybeRedir(EXPECTED &&expected_cb, TASK &&task_cb) {
         {
             LockGuard lock(mutex_);
-            auto callback_pair = std::make_pair(std::forward<EXPECTED>(expected_cb), std::forward<TASK>(task_cb));
-            pending_functors_.emplace_back(callback_pair);
+            pending_functors_.emplace_back(PendingFunctor{std::forward<EXPECTED>(expected_cb), std::forward<TASK>(task_cb), ClockTime::intervalUs()});
         }
         if (!pending_notified_) {
             if (pending_watcher_) {
@@ -114,6 +116,10 @@ public:
     size_t pendingQueueSize() const;
     bool hasPendingTask() const;
 
+    // Busy and idle time, pending tasks, task lag and timer skew since run()
+    EventLoopStats getStats() const;
+    void collectStats(EventLoopStatsBuilder &builder) const EXCLUDES(mutex_);
+
     inline struct event_base *getEventBase() const {
         return evbase_;
     }
@@ -174,11 +180,19 @@ private:
     EventLoopBeforeSleepCallBack before_sleep_call_back_;
     EventLoopAfterSleepCallBack after_sleep_call_back_;
 
+    struct PendingFunctor {
+        ExpectedLoopCallback expected_cb;
+        LoopTaskCallback task_cb;
+        int64_t queue_us; // monotonic
+    };
+
     std::unique_ptr<PipeEventWatcher> pending_watcher_;
     std::atomic<bool> pending_notified_;
     mutable Mutex mutex_;
     bool do_pending_ GUARDED_BY(mutex_);
-    std::deque<std::pair<ExpectedLoopCallback, LoopTaskCallback>> pending_functors_ GUARDED_BY(mutex_);
+    std::deque<PendingFunctor> pending_functors_ GUARDED_BY(mutex_);
+
+    EventLoopMonitor monitor_;
 
     std::atomic<TimerId> next_timer_id_;
     size_t timer_count_; // for debug get
@@ -0,0 +1,64 @@
+/*
+ *  Copyright (c) 2023 Tair
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+#include "network/EventLoopStats.hpp"
+
+#include <algorithm>
+
+namespace tair::network {
+
+static double busyShare(int64_t busy_ns, int64_t idle_ns) {
+    return busy_ns + idle_ns > 0 ? static_cast<double>(busy_ns) / static_cast<double>(busy_ns + idle_ns) : 0;
+}
+
+std::unique_ptr<HdrHistogram> EventLoopMonitor::newHistogram() {
+    return std::make_unique<HdrHistogram>(kHighestUs, 0.01);
+}
+
+void EventLoopStatsBuilder::add(const EventLoopMonitor &monitor, size_t pending_tasks, int64_t oldest_task_age_us) {
+    int64_t busy_ns = monitor.getBusyNs();
+    int64_t idle_ns = monitor.getIdleNs();
+    stats_.loops++;
+    stats_.iterations += monitor.getIterations();
+    stats_.busy_ns += busy_ns;
+    stats_.idle_ns += idle_ns;
+    stats_.max_utilization = std::max(stats_.max_utilization, busyShare(busy_ns, idle_ns));
+    stats_.pending_tasks += pending_tasks;
+    stats_.oldest_task_age_us = std::max(stats_.oldest_task_age_us, oldest_task_age_us);
+    task_lag_->merge(monitor.getTaskLag());
+    timer_skew_->merge(monitor.getTimerSkew());
+}
+
+EventLoopStats EventLoopStatsBuilder::build() const {
+    EventLoopStats stats = stats_;
+    stats.utilization = busyShare(stats.busy_ns, stats.idle_ns);
+    stats.tasks = task_lag_->getCount();
+    stats.task_lag_p50_us = task_lag_->getValueAtPercentile(50);
+    stats.task_lag_p99_us = task_lag_->getValueAtPercentile(99);
+    stats.task_lag_max_us = task_lag_->getMax();
+    stats.timers = timer_skew_->getCount();
+    stats.timer_skew_p50_us = timer_skew_->getValueAtPercentile(50);
+    stats.timer_skew_p99_us = timer_skew_->getValueAtPercentile(99);
+    stats.timer_skew_max_us = timer_skew_->getMax();
+    return stats;
+}
+
+} // namespace tair::network
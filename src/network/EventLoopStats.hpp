@@ -0,0 +1,126 @@
+/*
+ *  Copyright (c) 2023 Tair
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "common/Noncopyable.hpp"
+#include "common/statistics/HdrHistogram.hpp"
+
+namespace tair::network {
+
+using common::HdrHistogram;
+using common::Noncopyable;
+
+// Health of one or more loops since they started. Times are cumulative, the utilization of an
+// interval is the difference of busy_ns over that of busy_ns + idle_ns between two snapshots
+struct EventLoopStats {
+    size_t loops = 0;
+    uint64_t iterations = 0;
+    int64_t busy_ns = 0; // running handlers, tasks and timers
+    int64_t idle_ns = 0; // waiting for events
+    double utilization = 0;     // busy share over all loops
+    double max_utilization = 0; // busy share since start of the busiest loop, not of its last minute
+    size_t pending_tasks = 0;
+    int64_t oldest_task_age_us = 0; // of the tasks queued and not run yet, 0 when none
+    uint64_t tasks = 0;             // run from queueInLoop
+    uint64_t task_lag_p50_us = 0;   // from queueInLoop to the run of its batch
+    uint64_t task_lag_p99_us = 0;
+    uint64_t task_lag_max_us = 0;
+    uint64_t timers = 0;            // timer firings
+    uint64_t timer_skew_p50_us = 0; // late against the due time
+    uint64_t timer_skew_p99_us = 0;
+    uint64_t timer_skew_max_us = 0;
+};
+
+// Busy and idle time, task lag and timer skew of one loop. Written by the loop thread without
+// locking, two clock reads per iteration and one per queued task. Snapshots may be taken from any thread
+class EventLoopMonitor : private Noncopyable {
+public:
+    EventLoopMonitor() = default;
+    ~EventLoopMonitor() = default;
+
+    // Loop thread only
+    void start(int64_t now_ns) {
+        wake_ns_ = now_ns;
+    }
+    void beforeSleep(int64_t now_ns) {
+        add(busy_ns_, now_ns - wake_ns_);
+        sleep_ns_ = now_ns;
+    }
+    void afterSleep(int64_t now_ns) {
+        add(idle_ns_, now_ns - sleep_ns_);
+        add<uint64_t>(iterations_, 1);
+        wake_ns_ = now_ns;
+    }
+    void recordTaskLag(int64_t lag_us) {
+        task_lag_->recordSingleWriter(lag_us > 0 ? lag_us : 0);
+    }
+    void recordTimerSkew(int64_t skew_us) {
+        timer_skew_->recordSingleWriter(skew_us > 0 ? skew_us : 0);
+    }
+
+    uint64_t getIterations() const { return iterations_.load(std::memory_order_relaxed); }
+    int64_t getBusyNs() const { return busy_ns_.load(std::memory_order_relaxed); }
+    int64_t getIdleNs() const { return idle_ns_.load(std::memory_order_relaxed); }
+    const HdrHistogram &getTaskLag() const { return *task_lag_; }
+    const HdrHistogram &getTimerSkew() const { return *timer_skew_; }
+
+    // 1% precision up to a minute
+    static std::unique_ptr<HdrHistogram> newHistogram();
+
+private:
+    template <typename T>
+    static void add(std::atomic<T> &counter, T value) {
+        counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+
+    static constexpr uint64_t kHighestUs = 60UL * 1000 * 1000;
+
+    int64_t wake_ns_ = 0;
+    int64_t sleep_ns_ = 0;
+    std::atomic<uint64_t> iterations_ = 0;
+    std::atomic<int64_t> busy_ns_ = 0;
+    std::atomic<int64_t> idle_ns_ = 0;
+    std::unique_ptr<HdrHistogram> task_lag_ = newHistogram();
+    std::unique_ptr<HdrHistogram> timer_skew_ = newHistogram();
+};
+
+// Sums the monitors of several loops, percentiles come from the merged histograms
+class EventLoopStatsBuilder : private Noncopyable {
+public:
+    EventLoopStatsBuilder() = default;
+    ~EventLoopStatsBuilder() = default;
+
+    void add(const EventLoopMonitor &monitor, size_t pending_tasks, int64_t oldest_task_age_us);
+    EventLoopStats build() const;
+
+private:
+    EventLoopStats stats_;
+    std::unique_ptr<HdrHistogram> task_lag_ = EventLoopMonitor::newHistogram();
+    std::unique_ptr<HdrHistogram> timer_skew_ = EventLoopMonitor::newHistogram();
+};
+
+} // namespace tair::network
@@ -156,6 +156,15 @@ void EventLoopThreadPool::checkAndStopLoopThread() {
     }
 }
 
+EventLoop *EventLoopThreadPool::getNextLoop() {
+    ReadLockGuard rlock(rw_lock_);
+    if (stopped_ || available_thread_num_ == 0) {
+        return base_loop_;
+    }
+    size_t index = next_loop_index_.fetch_add(1) % available_thread_num_;
+    return loops_[index];
+}
+
 void EventLoopThreadPool::runInNextlLoop(const LoopTaskCallback &callback) {
     ReadLockGuard rlock(rw_lock_);
     if (stopped_ || available_thread_num_ == 0) {
@@ -245,4 +254,27 @@ void EventLoopThreadPool::runWithAllLoop(const AllLoopTaskCallback &callback) {
     callback(loops_, thread_num_, available_thread_num_);
 }
 
+EventLoopStats EventLoopThreadPool::getLoopStats() const {
+    EventLoopStatsBuilder builder;
+    ReadLockGuard rlock(rw_lock_);
+    for (auto *loop : loops_) {
+        if (loop) {
+            loop->collectStats(builder);
+        }
+    }
+    return builder.build();
+}
+
+std::vector<EventLoopStats> EventLoopThreadPool::getPerLoopStats() const {
+    std::vector<EventLoopStats> stats;
+    ReadLockGuard rlock(rw_lock_);
+    stats.reserve(loops_.size());
+    for (auto *loop : loops_) {
+        if (loop) {
+            stats.push_back(loop->getStats());
+        }
+    }
+    return stats;
+}
+
 } // namespace tair::network
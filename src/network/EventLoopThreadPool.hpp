@@ -83,6 +83,7 @@ public:
         return available_thread_num_;
     }
 
+    EventLoop *getNextLoop() EXCLUDES(rw_lock_);
     void runInNextlLoop(const LoopTaskCallback &callback) EXCLUDES(rw_lock_);
     void runInLoopByHash(size_t hash, const LoopTaskCallback &callback) EXCLUDES(rw_lock_);
 
@@ -93,6 +94,12 @@ public:
 
     void runWithAllLoop(const AllLoopTaskCallback &callback) EXCLUDES(rw_lock_);
 
+    // Summed over the IO threads, max_utilization and oldest_task_age_us point at the worst one
+    EventLoopStats getLoopStats() const EXCLUDES(rw_lock_);
+    // One entry per IO thread in loop order. Diff two snapshots for the busy share of an interval,
+    // a loop saturated lately after a long idle stretch barely moves its share since start
+    std::vector<EventLoopStats> getPerLoopStats() const EXCLUDES(rw_lock_);
+
     constexpr static const size_t MAX_THREAD_POOL_SIZE = 128;
 
 private:
@@ -0,0 +1,112 @@
+/*
+ *  Copyright (c) 2023 Tair
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+#include "network/MetricsHttpServer.hpp"
+
+#include <algorithm>
+#include <string_view>
+
+#include "common/Logger.hpp"
+#include "network/Buffer.hpp"
+#include "network/EventLoop.hpp"
+#include "network/TcpConnection.hpp"
+
+#include "fmt/format.h"
+
+namespace tair::network {
+
+MetricsHttpServer::MetricsHttpServer(EventLoop *loop, const std::string &listen_ip_port, const MetricsRegistry &registry)
+    : registry_(registry), server_(loop, listen_ip_port, 1, "metrics-http") {
+    server_.setMessageCallback([this](const TcpConnectionPtr &conn, Buffer *buf) {
+        onMessage(conn, buf);
+    });
+    // The response is the last thing written, close once it is out
+    server_.setWriteCompleteCallback([](const TcpConnectionPtr &conn) {
+        conn->loop()->queueInLoop([conn](EventLoop *) {
+            conn->close();
+        });
+    });
+    server_.setClosedCallback([this]() {
+        stopped_.countDown();
+    });
+}
+
+MetricsHttpServer::~MetricsHttpServer() {
+    stop();
+}
+
+bool MetricsHttpServer::start() {
+    started_ = server_.start();
+    return started_;
+}
+
+void MetricsHttpServer::stop() {
+    if (!started_) {
+        return;
+    }
+    started_ = false;
+    server_.stop();
+    stopped_.wait();
+}
+
+void MetricsHttpServer::onMessage(const TcpConnectionPtr &conn, Buffer *buf) {
+    constexpr size_t kMaxRequestBytes = 8192;
+    std::string_view request = buf->toStringView();
+    size_t header_end = request.find("\r\n\r\n");
+    if (header_end == std::string_view::npos) {
+        if (request.size() > kMaxRequestBytes) {
+            buf->retrieve(buf->length());
+            reply(conn, "431 Request Header Fields Too Large", "");
+        }
+        return;
+    }
+    // Request line: METHOD TARGET VERSION
+    std::string_view line = request.substr(0, request.find("\r\n"));
+    std::string_view method = line.substr(0, line.find(' '));
+    std::string_view target = line.substr(std::min(line.size(), method.size() + 1));
+    target = target.substr(0, target.find(' '));
+    target = target.substr(0, target.find('?'));
+    bool head_only = method == "HEAD";
+    if (method != "GET" && !head_only) {
+        reply(conn, "405 Method Not Allowed", "");
+    } else if (target != "/metrics") {
+        reply(conn, "404 Not Found", "");
+    } else {
+        reply(conn, "200 OK", registry_.render(), head_only);
+    }
+    // Anything pipelined behind is dropped with the connection
+    buf->retrieve(buf->length());
+}
+
+void MetricsHttpServer::reply(const TcpConnectionPtr &conn, const std::string &status, const std::string &body, bool head_only) {
+    std::string response = fmt::format("HTTP/1.1 {}\r\n"
+                                       "Content-Type: application/openmetrics-text; version=1.0.0; charset=utf-8\r\n"
+                                       "Content-Length: {}\r\n"
+                                       "Connection: close\r\n\r\n",
+                                       status, body.size());
+    if (!head_only) {
+        response += body;
+    }
+    LOG_TRACE("metrics request from {} answered with {}", conn->getRemoteIpPort(), status);
+    conn->send(std::move(response));
+}
+
+} // namespace tair::network
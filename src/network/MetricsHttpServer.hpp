@@ -0,0 +1,64 @@
+/*
+ *  Copyright (c) 2023 Tair
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+#pragma once
+
+#include <set>
+#include <string>
+
+#include "common/CountDownLatch.hpp"
+#include "common/Noncopyable.hpp"
+#include "common/statistics/MetricsRegistry.hpp"
+#include "network/TcpServer.hpp"
+#include "network/Types.hpp"
+
+namespace tair::network {
+
+using common::CountDownLatch;
+using common::MetricsRegistry;
+using common::Noncopyable;
+
+// A minimal HTTP endpoint answering GET /metrics with the OpenMetrics text of a registry.
+// Collectors run on its own IO thread, one response per connection
+class MetricsHttpServer final : private Noncopyable {
+public:
+    MetricsHttpServer(EventLoop *loop, const std::string &listen_ip_port, const MetricsRegistry &registry);
+    ~MetricsHttpServer();
+
+    bool start();
+    // Call from outside the thread of loop, returns once every connection is closed
+    void stop();
+
+    std::set<std::string> getRealListenIpPorts() const {
+        return server_.getRealListenIpPorts();
+    }
+
+private:
+    void onMessage(const TcpConnectionPtr &conn, Buffer *buf);
+    static void reply(const TcpConnectionPtr &conn, const std::string &status, const std::string &body, bool head_only = false);
+
+    const MetricsRegistry &registry_;
+    TcpServer server_;
+    CountDownLatch stopped_{1};
+    bool started_ = false;
+};
+
+} // namespace tair::network
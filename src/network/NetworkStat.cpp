@@ -0,0 +1,40 @@
+/*
+ *  Copyright (c) 2023 Tair
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+#include "network/NetworkStat.hpp"
+
+#include "common/statistics/MetricsRegistry.hpp"
+
+namespace tair::network {
+
+void NetworkStat::collectMetrics(common::MetricSet &metrics) {
+    metrics.addCounter("tair_network_input_bytes", "Bytes read from sockets", {}, getNetInputBytes());
+    metrics.addCounter("tair_network_output_bytes", "Bytes written to sockets", {}, getNetOutputBytes());
+    metrics.addGauge("tair_network_buffer_bytes", "Bytes held by connection buffers", {{"buffer", "general"}}, getGeneralBufferSize());
+    metrics.addGauge("tair_network_buffer_bytes", "Bytes held by connection buffers", {{"buffer", "input"}}, getNetInputBufferSize());
+    metrics.addGauge("tair_network_buffer_bytes", "Bytes held by connection buffers", {{"buffer", "output"}}, getNetOutputBufferSize());
+    metrics.addGauge("tair_network_moving_connections", "Connections moving between IO threads", {}, getMovingTcpConnCount());
+    metrics.addGauge("tair_network_buffer_pool_cached_bytes", "Bytes cached by the buffer pool", {}, getBufferPoolCachedSize());
+    metrics.addCounter("tair_network_buffer_pool_hits", "Buffers served from the pool", {}, getBufferPoolHit());
+    metrics.addCounter("tair_network_buffer_pool_misses", "Buffers the pool had to allocate", {}, getBufferPoolMiss());
+}
+
+} // namespace tair::network
@@ -23,6 +23,10 @@
 
 #include "common/statistics/AtomicStatistics.hpp"
 
+namespace tair::common {
+class MetricSet;
+} // namespace tair::common
+
 namespace tair::network {
 
 enum NetworkStatType : int {
@@ -32,6 +36,9 @@ enum NetworkStatType : int {
     NETWORK_STATS_TOTAL_NET_INPUT_BYTES,
     NETWORK_STATS_TOTAL_NET_OUTPUT_BYTES,
     NETWORK_STATS_TOTAL_MOVING_TCP_CONN_COUNT,
+    NETWORK_STATS_TOTAL_BUFFER_POOL_CACHED,
+    NETWORK_STATS_TOTAL_BUFFER_POOL_HIT,
+    NETWORK_STATS_TOTAL_BUFFER_POOL_MISS,
     NETWORK_STATS_COUNT,
 };
 
@@ -74,6 +81,9 @@ public:
         NetworkStatisticsHelper::calcStatistics();
     }
 
+    // For a MetricsRegistry collector, reads the totals only
+    static void collectMetrics(common::MetricSet &metrics);
+
     NETWORK_STAT_TOTAL_ADD_SUB_FUNC(GeneralBufferSize, NETWORK_STATS_TOTAL_NET_GENERAL_BUFFER)
     NETWORK_STAT_TOTAL_ADD_SUB_FUNC(NetInputBufferSize, NETWORK_STATS_TOTAL_NET_INPUT_BUFFER)
     NETWORK_STAT_TOTAL_ADD_SUB_FUNC(NetOutputBufferSize, NETWORK_STATS_TOTAL_NET_OUTPUT_BUFFER)
@@ -82,6 +92,10 @@ public:
     NETWORK_STAT_TOTAL_ADD_GET_FUNC(NetOutputBytes, NETWORK_STATS_TOTAL_NET_OUTPUT_BYTES)
 
     NETWORK_STAT_TOTAL_ADD_SUB_FUNC(MovingTcpConnCount, NETWORK_STATS_TOTAL_MOVING_TCP_CONN_COUNT)
+
+    NETWORK_STAT_TOTAL_ADD_SUB_FUNC(BufferPoolCachedSize, NETWORK_STATS_TOTAL_BUFFER_POOL_CACHED)
+    NETWORK_STAT_TOTAL_ADD_GET_FUNC(BufferPoolHit, NETWORK_STATS_TOTAL_BUFFER_POOL_HIT)
+    NETWORK_STAT_TOTAL_ADD_GET_FUNC(BufferPoolMiss, NETWORK_STATS_TOTAL_BUFFER_POOL_MISS)
 };
 
 } // namespace tair::network
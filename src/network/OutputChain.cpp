@@ -0,0 +1,114 @@
+/*
+ *  Copyright (c) 2023 Tair
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+#include "network/OutputChain.hpp"
+
+#include <algorithm>
+
+#include "common/Assert.hpp"
+
+namespace tair::network {
+
+void OutputChain::append(const char *data, size_t len) {
+    if (len == 0) {
+        return;
+    }
+    if (segments_.empty() || segments_.back().owner) {
+        segments_.emplace_back();
+    }
+    segments_.back().owned.append(data, len);
+    length_ += len;
+}
+
+void OutputChain::appendRef(const char *data, size_t len, std::shared_ptr<const void> owner) {
+    if (len == 0) {
+        return;
+    }
+    runtimeAssert(owner != nullptr);
+    auto &segment = segments_.emplace_back();
+    segment.owner = std::move(owner);
+    segment.ref_data = data;
+    segment.ref_len = len;
+    length_ += len;
+}
+
+void OutputChain::append(OutputChain &&other) {
+    if (segments_.empty()) {
+        segments_.swap(other.segments_);
+    } else {
+        for (auto &segment : other.segments_) {
+            segments_.emplace_back(std::move(segment));
+        }
+        other.segments_.clear();
+    }
+    length_ += other.length_;
+    other.length_ = 0;
+}
+
+int OutputChain::fillIovec(struct iovec *iov, int max_count, size_t stop_ref_len) const {
+    int count = 0;
+    for (auto it = segments_.begin(); it != segments_.end() && count < max_count; ++it) {
+        if (stop_ref_len > 0 && count > 0 && it->owner && it->remaining() >= stop_ref_len) {
+            break;
+        }
+        iov[count].iov_base = const_cast<char *>(it->data());
+        iov[count].iov_len = it->remaining();
+        count++;
+    }
+    return count;
+}
+
+std::shared_ptr<const void> OutputChain::frontRefOwner(size_t min_len) const {
+    if (segments_.empty() || !segments_.front().owner || segments_.front().remaining() < min_len) {
+        return nullptr;
+    }
+    return segments_.front().owner;
+}
+
+void OutputChain::skip(size_t n) {
+    runtimeAssert(n <= length_);
+    length_ -= n;
+    while (n > 0) {
+        auto &segment = segments_.front();
+        size_t step = std::min(n, segment.remaining());
+        segment.pos += step;
+        n -= step;
+        if (segment.remaining() == 0) {
+            segments_.pop_front();
+        }
+    }
+}
+
+void OutputChain::clear() {
+    segments_.clear();
+    length_ = 0;
+}
+
+std::string OutputChain::toString() const {
+    std::string str;
+    str.reserve(length_);
+    for (auto &segment : segments_) {
+        str.append(segment.data(), segment.remaining());
+    }
+    return str;
+}
+
+} // namespace tair::network
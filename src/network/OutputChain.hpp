@@ -0,0 +1,108 @@
+/*
+ *  Copyright (c) 2023 Tair
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <string>
+
+#include <sys/uio.h>
+
+#include "common/Copyable.hpp"
+
+namespace tair::network {
+
+using common::Copyable;
+
+// A chain of output segments flushed with writev. Small pieces (encoded headers)
+// are copied into owned segments, large payloads are referenced in place and kept
+// alive by a ref-counted owner until they are written.
+class OutputChain : public Copyable {
+public:
+    // Max iovec entries filled per write
+    static const int kMaxIovecCount = 64;
+
+    OutputChain() = default;
+    ~OutputChain() = default;
+
+    // Copy bytes, merged into the tail segment when it is owned
+    void append(const char *data, size_t len);
+
+    void append(const std::string &str) {
+        append(str.data(), str.size());
+    }
+
+    // Reference caller memory without copying, owner keeps it valid
+    void appendRef(const char *data, size_t len, std::shared_ptr<const void> owner);
+
+    // Move all segments of other to the tail, other is left empty
+    void append(OutputChain &&other);
+
+    size_t length() const {
+        return length_;
+    }
+
+    bool empty() const {
+        return length_ == 0;
+    }
+
+    size_t segmentCount() const {
+        return segments_.size();
+    }
+
+    // Fill iov from the head of the chain, returns the number of entries filled.
+    // With stop_ref_len > 0, stops before a later referenced segment of at least that size.
+    int fillIovec(struct iovec *iov, int max_count, size_t stop_ref_len = 0) const;
+
+    // Owner of the head segment if it is referenced and at least min_len bytes remain
+    std::shared_ptr<const void> frontRefOwner(size_t min_len) const;
+
+    // Drop n written bytes from the head, releasing referenced blocks
+    void skip(size_t n);
+
+    void clear();
+
+    // Copy the whole chain into one string, for transports without writev
+    std::string toString() const;
+
+private:
+    struct Segment {
+        std::string owned;
+        std::shared_ptr<const void> owner; // set for referenced segments
+        const char *ref_data = nullptr;
+        size_t ref_len = 0;
+        size_t pos = 0; // bytes already written
+
+        const char *data() const {
+            return (owner ? ref_data : owned.data()) + pos;
+        }
+
+        size_t remaining() const {
+            return (owner ? ref_len : owned.size()) - pos;
+        }
+    };
+
+    std::deque<Segment> segments_;
+    size_t length_ = 0;
+};
+
+} // namespace tair::network
@@ -26,6 +26,10 @@
 #include <ifaddrs.h>
 #include <net/if.h>
 #include <netinet/tcp.h>
+#ifdef __linux__
+#include <linux/errqueue.h>
+#endif
+#include <sys/uio.h>
 #include <unistd.h>
 
 #include "common/Assert.hpp"
@@ -90,6 +94,10 @@ int writeToSocket(socket_t fd, const void *buf, size_t len) {
     return ::write(fd, buf, len);
 }
 
+int writeVToSocket(socket_t fd, const struct iovec *vec, int iovcnt) {
+    return ::writev(fd, vec, iovcnt);
+}
+
 int getSocketErrorCode(socket_t fd) {
     int status = 0;
     socklen_t slen = sizeof(status);
@@ -195,6 +203,75 @@ void setTcpNoDelay(socket_t fd, bool on) {
     }
 }
 
+bool setFastOpenConnect(socket_t fd, bool on) {
+#if defined(TCP_FASTOPEN_CONNECT)
+    int optval = on ? 1 : 0;
+    int rc = ::setsockopt(fd, IPPROTO_TCP, TCP_FASTOPEN_CONNECT, (const void *)&optval, sizeof(optval));
+    if (rc != 0) {
+        LOG_WARN("setsockopt(TCP_FASTOPEN_CONNECT) failed, errno: {} -> {}", errno, SystemUtil::errnoToString(errno));
+        return false;
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool setZeroCopy(socket_t fd, bool on) {
+#if defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY)
+    int optval = on ? 1 : 0;
+    int rc = ::setsockopt(fd, SOL_SOCKET, SO_ZEROCOPY, (const void *)&optval, sizeof(optval));
+    if (rc != 0) {
+        LOG_WARN("setsockopt(SO_ZEROCOPY) failed, errno: {} -> {}", errno, SystemUtil::errnoToString(errno));
+        return false;
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+int sendZeroCopyToSocket(socket_t fd, const struct iovec *vec, int iovcnt) {
+#if defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY)
+    struct msghdr msg = {};
+    msg.msg_iov = const_cast<struct iovec *>(vec);
+    msg.msg_iovlen = iovcnt;
+    return ::sendmsg(fd, &msg, MSG_ZEROCOPY | MSG_NOSIGNAL);
+#else
+    errno = EOPNOTSUPP;
+    return -1;
+#endif
+}
+
+int recvZeroCopyCompletion(socket_t fd, uint32_t *lo, uint32_t *hi) {
+#if defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY)
+    char control[CMSG_SPACE(sizeof(struct sock_extended_err)) + 64];
+    struct msghdr msg = {};
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+    if (::recvmsg(fd, &msg, MSG_ERRQUEUE | MSG_DONTWAIT) < 0) {
+        return (errno == EAGAIN || errno == EWOULDBLOCK) ? 0 : -1;
+    }
+    for (struct cmsghdr *cm = CMSG_FIRSTHDR(&msg); cm; cm = CMSG_NXTHDR(&msg, cm)) {
+        bool is_recverr = (cm->cmsg_level == SOL_IP && cm->cmsg_type == IP_RECVERR)
+                          || (cm->cmsg_level == SOL_IPV6 && cm->cmsg_type == IPV6_RECVERR);
+        if (!is_recverr) {
+            continue;
+        }
+        auto *serr = reinterpret_cast<struct sock_extended_err *>(CMSG_DATA(cm));
+        if (serr->ee_errno != 0 || serr->ee_origin != SO_EE_ORIGIN_ZEROCOPY) {
+            continue;
+        }
+        *lo = serr->ee_info;
+        *hi = serr->ee_data;
+        return 1;
+    }
+    return -1;
+#else
+    return 0;
+#endif
+}
+
 uint32_t ip2Number(const char *address) {
     struct in_addr addr;
     return ::inet_aton(address, &addr) != 0 ? addr.s_addr : -1;
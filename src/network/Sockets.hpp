@@ -42,6 +42,7 @@ void closeSocket(socket_t fd);
 int readVFromSocket(socket_t fd, const struct iovec *vec, int iovcnt);
 int readFromSocket(socket_t fd, void *buf, int len);
 int writeToSocket(socket_t fd, const void *buf, size_t len);
+int writeVToSocket(socket_t fd, const struct iovec *vec, int iovcnt);
 
 int getSocketErrorCode(socket_t fd);
 
@@ -49,6 +50,14 @@ void setKeepAlive(socket_t fd, bool on, int seconds);
 void setReuseAddr(socket_t fd);
 void setReusePort(socket_t fd);
 void setTcpNoDelay(socket_t fd, bool on);
+// TCP_FASTOPEN_CONNECT, Linux 4.11+ only: connect returns at once and the first write rides the SYN
+bool setFastOpenConnect(socket_t fd, bool on);
+// MSG_ZEROCOPY support, Linux 4.14+ only
+bool setZeroCopy(socket_t fd, bool on);
+int sendZeroCopyToSocket(socket_t fd, const struct iovec *vec, int iovcnt);
+// Read one completion from the error queue: 1 with the completed send id range [lo, hi],
+// 0 if none is pending, -1 on error
+int recvZeroCopyCompletion(socket_t fd, uint32_t *lo, uint32_t *hi);
 int setNonBlocking(socket_t fd);
 int setCloseOnExec(socket_t fd);
 void setTimeout(socket_t fd, uint32_t timeout_ms);
@@ -82,6 +82,7 @@ void TcpClient::connectInLoop() {
     LOG_DEBUG("connect this={} remote_addr={}", (void *)this, remote_ip_port_);
     runtimeAssert(loop_->isInLoopThread());
     connector_ = std::make_shared<Connector>(loop_, remote_ip_port_, connecting_timeout_, auto_reconnect_);
+    connector_->setFastOpen(fast_open_);
     connector_->setNewConnectionCallback([weak_client = weak_from_this()](socket_t fd, const std::string &local_ip_port, const std::string &remote_ip_port, bool is_tls) {
         auto client = weak_client.lock();
         if (client) {
@@ -126,8 +127,9 @@ void TcpClient::onNewConnection(socket_t fd, const std::string &local_ip_port, c
     TcpConnectionPtr conn = nullptr;
     if (!is_tls) {
         conn = std::make_shared<TcpConnection>(fd, local_ip_port, remote_ip_port);
+        conn->setZeroCopyThreshold(zerocopy_threshold_);
     } else {
-        conn = std::make_shared<TlsConnection>(fd, local_ip_port, remote_ip_port, TlsConnection::kClient);
+        conn = std::make_shared<TlsConnection>(fd, local_ip_port, remote_ip_port, TlsConnection::kClient, tls_context_);
     }
     conn->setConnectionCallback(connection_callback_);
     conn->setMessageCallback(message_callback_);
@@ -29,6 +29,7 @@
 #include "common/WeakCallback.hpp"
 #include "network/Duration.hpp"
 #include "network/TcpConnection.hpp"
+#include "network/TlsOptions.hpp"
 #include "network/Types.hpp"
 
 namespace tair::network {
@@ -63,6 +64,21 @@ public:
         keepalive_seconds_ = seconds;
     }
 
+    // See TcpConnection::setZeroCopyThreshold, plain tcp connections only
+    void setZeroCopyThreshold(size_t bytes) {
+        zerocopy_threshold_ = bytes;
+    }
+
+    // TCP Fast Open, the first request goes out in the SYN once the server has handed out a cookie
+    void setFastOpen(bool on) {
+        fast_open_ = on;
+    }
+
+    // Used by tls:// connections, see TlsClientContext
+    void setTlsContext(std::shared_ptr<TlsClientContext> context) {
+        tls_context_ = std::move(context);
+    }
+
     void setConnectingTimeout(Duration timeout) {
         connecting_timeout_ = timeout;
     }
@@ -107,6 +123,9 @@ private:
     EventLoop *loop_;
     std::string remote_ip_port_;
     int keepalive_seconds_ = 0;
+    size_t zerocopy_threshold_ = 0;
+    bool fast_open_ = false;
+    std::shared_ptr<TlsClientContext> tls_context_;
 
     ConnectorPtr connector_;                      // always used in loop thread
     Duration connecting_timeout_ = Duration(3.0); // default 3 seconds
@@ -158,6 +158,25 @@ void TcpConnection::send(const std::string_view &strv) {
     }
 }
 
+void TcpConnection::send(OutputChain &&chain) {
+    if (status_ != kConnected) {
+        LOG_DEBUG("TcpConnection isn't connected, send failed");
+        return;
+    }
+    if (loop_->isInLoopThread()) {
+        sendInLoop(chain);
+    } else {
+        // Shared so that queued task copies never copy the segments
+        auto mchain = std::make_shared<OutputChain>(std::move(chain));
+        auto expected_cb = [conn = shared_from_this()]() {
+            return conn->loop();
+        };
+        loop_->queueInLoopMaybeRedir(expected_cb, [conn = shared_from_this(), mchain](EventLoop *) {
+            conn->sendInLoop(*mchain);
+        });
+    }
+}
+
 void TcpConnection::sendInLoop(const void *data, size_t len) {
     runtimeAssert(loop_->isInLoopThread());
     if (status_ != kConnected) {
@@ -172,7 +191,7 @@ void TcpConnection::sendInLoop(const void *data, size_t len) {
     size_t remaining = len;
 
     // if no data in output queue, writing directly
-    if (!channel_->hasWritableEvent() && output_buffer_.empty()) {
+    if (!channel_->hasWritableEvent() && output_buffer_.empty() && output_chain_.empty()) {
         nwritten = sockets::writeToSocket(channel_->fd(), static_cast<const char *>(data), len);
         if (nwritten >= 0) {
             NetworkStat::addNetOutputBytes(nwritten);
@@ -180,8 +199,8 @@ void TcpConnection::sendInLoop(const void *data, size_t len) {
                 after_write_event_callback_(self, nwritten);
             }
             remaining = len - nwritten;
-            if (remaining == 0 && write_complete_callback_) {
-                write_complete_callback_(self);
+            if (remaining == 0) {
+                notifyWriteComplete(self);
             }
         } else {
             nwritten = 0;
@@ -196,17 +215,147 @@ void TcpConnection::sendInLoop(const void *data, size_t len) {
     }
     runtimeAssert(remaining <= len);
     if (remaining > 0) {
-        size_t old_len = output_buffer_.length();
-        size_t current_size = old_len + remaining;
-        if (current_size >= high_water_mark_ && old_len < high_water_mark_) {
-            LOG_TRACE("Connection high water, current size: {}", current_size);
-            if (high_water_mark_callback_) {
-                high_water_mark_callback_(self, old_len + remaining);
+        queueOutput((char *)data + nwritten, remaining);
+    }
+}
+
+void TcpConnection::sendInLoop(OutputChain &chain) {
+    runtimeAssert(loop_->isInLoopThread());
+    if (status_ != kConnected) {
+        LOG_WARN("TcpConnection disconnected, give up writing");
+        return;
+    }
+    auto self = shared_from_this();
+    if (before_write_event_callback_ && !before_write_event_callback_(self)) {
+        return;
+    }
+    // if no data in output queue, writing directly
+    if (!channel_->hasWritableEvent() && output_buffer_.empty() && output_chain_.empty()) {
+        ssize_t nwritten = writeChain(chain, nullptr);
+        if (nwritten >= 0) {
+            NetworkStat::addNetOutputBytes(nwritten);
+            if (after_write_event_callback_) {
+                after_write_event_callback_(self, nwritten);
+            }
+            if (chain.empty()) {
+                notifyWriteComplete(self);
+            }
+        } else {
+            if (!EVUTIL_ERR_RW_RETRIABLE(errno)) {
+                LOG_DEBUG("SendInLoop writev failed, errno: {} -> {}", errno, SystemUtil::errnoToString(errno));
+                if (errno == EPIPE || errno == ECONNRESET) {
+                    handleError();
+                    return;
+                }
             }
         }
-        output_buffer_.append((char *)data + nwritten, remaining);
-        if (!channel_->hasWritableEvent()) {
-            channel_->enableWriteEvent();
+    }
+    if (!chain.empty()) {
+        queueOutput(chain);
+    }
+}
+
+void TcpConnection::queueOutput(const void *data, size_t len) {
+    size_t old_len = output_buffer_.length() + output_chain_.length();
+    size_t current_size = old_len + len;
+    if (current_size >= high_water_mark_ && old_len < high_water_mark_) {
+        LOG_TRACE("Connection high water, current size: {}", current_size);
+        if (high_water_mark_callback_) {
+            high_water_mark_callback_(shared_from_this(), current_size);
+        }
+    }
+    if (output_chain_.empty()) {
+        output_buffer_.append((char *)data, len);
+    } else {
+        // Bytes sent after a chain must stay behind it
+        output_chain_.append((const char *)data, len);
+    }
+    if (!channel_->hasWritableEvent()) {
+        channel_->enableWriteEvent();
+    }
+}
+
+void TcpConnection::queueOutput(OutputChain &chain) {
+    size_t old_len = output_buffer_.length() + output_chain_.length();
+    size_t current_size = old_len + chain.length();
+    if (current_size >= high_water_mark_ && old_len < high_water_mark_) {
+        LOG_TRACE("Connection high water, current size: {}", current_size);
+        if (high_water_mark_callback_) {
+            high_water_mark_callback_(shared_from_this(), current_size);
+        }
+    }
+    output_chain_.append(std::move(chain));
+    if (!channel_->hasWritableEvent()) {
+        channel_->enableWriteEvent();
+    }
+}
+
+ssize_t TcpConnection::writeChain(OutputChain &chain, Buffer *head) {
+    struct iovec iov[OutputChain::kMaxIovecCount];
+    if (zerocopy_threshold_ > 0 && (!head || head->empty())) {
+        auto owner = chain.frontRefOwner(zerocopy_threshold_);
+        if (owner && !zerocopy_enabled_ && !(zerocopy_enabled_ = sockets::setZeroCopy(fd_, true))) {
+            // Not supported by this kernel or socket
+            zerocopy_threshold_ = 0;
+            owner.reset();
+        }
+        if (owner) {
+            chain.fillIovec(iov, 1);
+            ssize_t nwritten = sockets::sendZeroCopyToSocket(fd_, iov, 1);
+            if (nwritten > 0) {
+                // The kernel reads the pages later, hold them until the completion arrives
+                zerocopy_pending_.push_back({zerocopy_next_id_++, std::move(owner)});
+                chain.skip(nwritten);
+                return nwritten;
+            }
+            if (errno != ENOBUFS) {
+                return nwritten;
+            }
+            // Out of optmem for notifications, fall back to a copying write
+        }
+    }
+    int count = 0;
+    if (head && !head->empty()) {
+        iov[count].iov_base = const_cast<char *>(head->data());
+        iov[count].iov_len = head->length();
+        count++;
+    }
+    count += chain.fillIovec(iov + count, OutputChain::kMaxIovecCount - count, zerocopy_threshold_);
+    ssize_t nwritten = sockets::writeVToSocket(fd_, iov, count);
+    if (nwritten > 0) {
+        size_t head_len = head ? std::min((size_t)nwritten, head->length()) : 0;
+        if (head_len > 0) {
+            head->skip(head_len);
+        }
+        chain.skip(nwritten - head_len);
+    }
+    return nwritten;
+}
+
+void TcpConnection::notifyWriteComplete(const TcpConnectionPtr &self) {
+    if (!zerocopy_pending_.empty()) {
+        // Reported once the kernel has released every zero-copy buffer
+        zerocopy_write_complete_ = true;
+        return;
+    }
+    if (write_complete_callback_) {
+        write_complete_callback_(self);
+    }
+}
+
+void TcpConnection::handleZeroCopyCompletions() {
+    uint32_t lo = 0;
+    uint32_t hi = 0;
+    while (!zerocopy_pending_.empty() && sockets::recvZeroCopyCompletion(fd_, &lo, &hi) > 0) {
+        std::erase_if(zerocopy_pending_, [lo, hi](const ZeroCopyPending &pending) {
+            // Ids are 32 bits and wrap around
+            return pending.id - lo <= hi - lo;
+        });
+    }
+    if (zerocopy_pending_.empty() && zerocopy_write_complete_ && output_buffer_.empty() && output_chain_.empty()) {
+        zerocopy_write_complete_ = false;
+        if (write_complete_callback_) {
+            write_complete_callback_(shared_from_this());
         }
     }
 }
@@ -214,9 +363,9 @@ void TcpConnection::sendInLoop(const void *data, size_t len) {
 void TcpConnection::sendOutputBuffer() {
     runtimeAssert(loop_->isInLoopThread());
     auto self = shared_from_this();
-    if (!output_buffer_.empty() && isConnected()) {
+    if ((!output_buffer_.empty() || !output_chain_.empty()) && isConnected()) {
         handleWrite();
-        if (!output_buffer_.empty() && isConnected()) {
+        if ((!output_buffer_.empty() || !output_chain_.empty()) && isConnected()) {
             if (before_write_event_callback_ && !before_write_event_callback_(self)) {
                 return;
             }
@@ -289,6 +438,10 @@ void TcpConnection::attachToNewLoop(EventLoop *new_loop) {
 void TcpConnection::handleRead() {
     runtimeAssert(loop_->isInLoopThread());
     auto self = shared_from_this();
+    if (!zerocopy_pending_.empty()) {
+        // Completions on the error queue wake up the read event too
+        handleZeroCopyCompletions();
+    }
     if (before_read_event_callback_ && !before_read_event_callback_(self)) {
         return;
     }
@@ -322,24 +475,32 @@ void TcpConnection::handleRead() {
 void TcpConnection::handleWrite() {
     runtimeAssert(loop_->isInLoopThread());
     auto self = shared_from_this();
+    if (!zerocopy_pending_.empty()) {
+        handleZeroCopyCompletions();
+    }
     if (before_write_event_callback_ && !before_write_event_callback_(self)) {
         return;
     }
-    ssize_t nwritten = sockets::writeToSocket(fd_, output_buffer_.data(), output_buffer_.length());
+    ssize_t nwritten = 0;
+    if (output_chain_.empty()) {
+        nwritten = sockets::writeToSocket(fd_, output_buffer_.data(), output_buffer_.length());
+        if (nwritten > 0) {
+            output_buffer_.skip(nwritten);
+        }
+    } else {
+        nwritten = writeChain(output_chain_, &output_buffer_);
+    }
     if (nwritten > 0) {
         NetworkStat::addNetOutputBytes(nwritten);
-        output_buffer_.skip(nwritten);
         if (after_write_event_callback_) {
             after_write_event_callback_(self, nwritten);
         }
-        if (output_buffer_.empty()) {
+        if (output_buffer_.empty() && output_chain_.empty()) {
             if (output_buffer_.capacity() > EMPTY_BUFFER_MAX_CAPACITY) {
                 output_buffer_.reinit();
             }
             channel_->disableWriteEvent();
-            if (write_complete_callback_) {
-                write_complete_callback_(self);
-            }
+            notifyWriteComplete(self);
         }
     } else {
         if (!EVUTIL_ERR_RW_RETRIABLE(errno)) {
@@ -23,11 +23,13 @@
 
 #include <any>
 #include <atomic>
+#include <deque>
 #include <future>
 #include <string>
 
 #include "common/Noncopyable.hpp"
 #include "network/Buffer.hpp"
+#include "network/OutputChain.hpp"
 #include "network/Types.hpp"
 
 namespace tair::network {
@@ -73,6 +75,9 @@ public:
 
     void send(const std::string_view &str);
 
+    // Referenced segments are written straight from their owner's memory with writev
+    void send(OutputChain &&chain);
+
     // in order to support the merge resp in one write
     void sendOutputBuffer();
 
@@ -120,6 +125,21 @@ public:
         return false;
     }
 
+    // Send referenced chain segments of at least bytes with MSG_ZEROCOPY, 0 disables.
+    // Falls back to copying writes where the kernel does not support it.
+    void setZeroCopyThreshold(size_t bytes) {
+        zerocopy_threshold_ = bytes;
+    }
+
+    size_t getZeroCopyThreshold() const {
+        return zerocopy_threshold_;
+    }
+
+    // Zero-copy sends whose buffers the kernel has not released yet
+    size_t getZeroCopyPendingCount() const {
+        return zerocopy_pending_.size();
+    }
+
     bool isConnected() const {
         return status_ == kConnected;
     }
@@ -246,6 +266,16 @@ protected:
     }
 
     virtual void sendInLoop(const void *data, size_t len);
+    virtual void sendInLoop(OutputChain &chain);
+
+    // Queue unwritten bytes behind everything already pending, keeps write order
+    void queueOutput(const void *data, size_t len);
+    void queueOutput(OutputChain &chain);
+    // Write head (if any) followed by chain in one writev, or the leading large referenced
+    // segment with MSG_ZEROCOPY. Written bytes are dropped from both.
+    ssize_t writeChain(OutputChain &chain, Buffer *head);
+    void notifyWriteComplete(const TcpConnectionPtr &self);
+    void handleZeroCopyCompletions();
 
     void moveToNewLoopInLoop(EventLoop *new_loop, const Callback &success_cb, const Callback &fail_cb);
     void detachFromLoopAndReset();
@@ -270,6 +300,18 @@ protected:
     std::shared_ptr<Channel> channel_;
     Buffer input_buffer_;
     Buffer output_buffer_;
+    // Pending segments queued after output_buffer_, only used by chain sends
+    OutputChain output_chain_;
+
+    struct ZeroCopyPending {
+        uint32_t id;
+        std::shared_ptr<const void> owner;
+    };
+    size_t zerocopy_threshold_ = 0;
+    bool zerocopy_enabled_ = false;
+    bool zerocopy_write_complete_ = false;
+    uint32_t zerocopy_next_id_ = 0;
+    std::deque<ZeroCopyPending> zerocopy_pending_;
 
     size_t high_water_mark_ = 128 * 1024 * 1024; // Default 128MB
 
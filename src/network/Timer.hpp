@@ -21,6 +21,7 @@
  */
 #pragma once
 
+#include "common/ClockTime.hpp"
 #include "network/Duration.hpp"
 #include "network/EventWatcher.hpp"
 #include "network/Types.hpp"
@@ -43,9 +44,23 @@ public:
     }
 
     void start() {
+        due_us_ = common::ClockTime::intervalUs() + static_cast<int64_t>(timer_watcher_->timeout().microseconds());
         timer_watcher_->start();
     }
 
+    // How late it fired, then the due time of the next firing, as libevent reschedules a persistent timer
+    int64_t onFired(int64_t now_us) {
+        int64_t skew_us = now_us - due_us_;
+        if (isPeriodic()) {
+            int64_t interval_us = static_cast<int64_t>(timer_watcher_->timeout().microseconds());
+            due_us_ += interval_us;
+            if (due_us_ < now_us) {
+                due_us_ = now_us + interval_us;
+            }
+        }
+        return skew_us;
+    }
+
     void cancel() {
         timer_watcher_->cancel();
     }
@@ -64,6 +79,7 @@ public:
 
 private:
     TimerId id_;
+    int64_t due_us_ = 0; // monotonic
     std::unique_ptr<TimerEventWatcher> timer_watcher_;
 };
 
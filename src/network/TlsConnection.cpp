@@ -37,12 +37,28 @@ namespace tair::network {
 using common::SystemUtil;
 
 TlsConnection::TlsConnection(socket_t sockfd, const std::string &local_ip_port,
-                             const std::string &remote_ip_port, TlsConnection::Type type)
-    : TcpConnection(sockfd, local_ip_port, remote_ip_port) {
-    auto ssl_ctx = TlsOptions::instance().getSslContext();
-    ssl_ = SSL_new(ssl_ctx.get());
+                             const std::string &remote_ip_port, TlsConnection::Type type,
+                             std::shared_ptr<TlsClientContext> client_context)
+    : TcpConnection(sockfd, local_ip_port, remote_ip_port), client_context_(std::move(client_context)) {
+    if (client_context_) {
+        ssl_ = SSL_new(client_context_->getSslContext());
+    } else {
+        ssl_ = SSL_new(TlsOptions::instance().getSslContext().get());
+    }
     SSL_set_fd(ssl_, sockfd);
     type_ = type;
+    if (type_ == kClient && client_context_) {
+        // Lets the new session callback file tickets under this peer
+        SSL_set_app_data(ssl_, &remote_ip_port_);
+        if (auto session = client_context_->getSession(remote_ip_port_)) {
+            SSL_set_session(ssl_, session.get());
+        }
+        const auto &server_name = client_context_->getServerName();
+        if (!server_name.empty()) {
+            SSL_set_tlsext_host_name(ssl_, server_name.data());
+            SSL_set1_host(ssl_, server_name.data());
+        }
+    }
     LOG_TRACE("TlsConnection() this: {}", (void *)this);
 }
 
@@ -110,7 +126,10 @@ void TlsConnection::handleWrite() {
         ssl_read_want_write_ = false;
         sslRead();
     }
-    if (ssl_status_ == kConnected) {
+    if (ssl_status_ == kConnected && ktls_send_) {
+        // Anything queued during the handshake is still plaintext, the kernel encrypts it
+        TcpConnection::handleWrite();
+    } else if (ssl_status_ == kConnected) {
         ssl_write_want_read_ = false;
         sslWrite();
     }
@@ -126,6 +145,11 @@ void TlsConnection::handleError() {
 // @override
 void TlsConnection::handleClose() {
     runtimeAssert(loop_->isInLoopThread());
+    if (ssl_status_ == kConnected) {
+        // Best effort close_notify. Without it OpenSSL treats the session as truncated
+        // and marks it not resumable when the SSL is freed.
+        SSL_shutdown(ssl_);
+    }
     SSL_free(ssl_);
     ssl_ = nullptr;
     ssl_status_ = kDisconnected;
@@ -172,7 +196,7 @@ void TlsConnection::sslAccept() {
     if (ret <= 0) {
         sslError(ret);
     } else {
-        ssl_status_ = kConnected;
+        onHandshakeDone();
     }
 }
 
@@ -184,10 +208,24 @@ void TlsConnection::sslConnect() {
     if (ret <= 0) {
         sslError(ret);
     } else {
-        ssl_status_ = kConnected;
+        onHandshakeDone();
     }
 }
 
+void TlsConnection::onHandshakeDone() {
+    ssl_status_ = kConnected;
+#if !defined(OPENSSL_NO_KTLS) && defined(BIO_get_ktls_send)
+    // Only the send side leaves OpenSSL: reads still go through SSL_read, which has to
+    // handle post-handshake records (tickets, key updates) the kernel hands back as control messages.
+    ktls_send_ = BIO_get_ktls_send(SSL_get_wbio(ssl_));
+#endif
+    LOG_DEBUG("TlsConnection handshake done, addr={} reused={} ktls_send={}", remote_ip_port_, isSessionReused(), ktls_send_);
+}
+
+bool TlsConnection::isSessionReused() const {
+    return ssl_ && SSL_session_reused(ssl_) == 1;
+}
+
 void TlsConnection::sslRead() {
     auto self = shared_from_this(); // Holds shared_ptr, avoid being destroyed in the callback function.
 
@@ -274,6 +312,10 @@ void TlsConnection::sendInLoop(const void *data, size_t len) {
     if (len == 0) return;                                // should not call SSL_write() with num=0, it will return an error.
     if (ssl_status_ == kDisconnected) return;            // conn may be closed.
     runtimeAssert(status_ == TcpConnection::kConnected); // if ssl_status != disconnected, then status == connected.
+    if (ktls_send_) {
+        TcpConnection::sendInLoop(data, len);
+        return;
+    }
 
     int nwritten = 0;
     size_t remaining = len;
@@ -315,6 +357,25 @@ void TlsConnection::sendInLoop(const void *data, size_t len) {
     }
 }
 
+// SSL_write has no scatter-gather form, so segments are written one by one,
+// unless the kernel does the encryption and the plain writev path applies
+void TlsConnection::sendInLoop(OutputChain &chain) {
+    if (ktls_send_ && ssl_status_ == kConnected) {
+        TcpConnection::sendInLoop(chain);
+        return;
+    }
+    struct iovec iov[OutputChain::kMaxIovecCount];
+    while (!chain.empty() && ssl_status_ != kDisconnected) {
+        int count = chain.fillIovec(iov, OutputChain::kMaxIovecCount);
+        size_t filled = 0;
+        for (int i = 0; i < count; ++i) {
+            sendInLoop(iov[i].iov_base, iov[i].iov_len);
+            filled += iov[i].iov_len;
+        }
+        chain.skip(filled);
+    }
+}
+
 bool TlsConnection::isTLSConnection() const {
     return true;
 }
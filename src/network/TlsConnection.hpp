@@ -37,11 +37,20 @@ public:
         kClient = 1,
     };
 
+    // Client connections without a context fall back to the server one of TlsOptions
     TlsConnection(socket_t sockfd, const std::string &local_ip_port,
-                  const std::string &remote_ip_port, Type type);
+                  const std::string &remote_ip_port, Type type,
+                  std::shared_ptr<TlsClientContext> client_context = nullptr);
 
     ~TlsConnection() override = default;
 
+    // True when the handshake resumed a cached session instead of doing a full one
+    bool isSessionReused() const;
+    // True when the kernel encrypts outgoing records, writes then bypass SSL_write
+    bool isKernelTlsSend() const {
+        return ktls_send_;
+    }
+
 private:
     enum SSL_STATUS {
         kNone = 0,
@@ -63,18 +72,22 @@ private:
     void sslRead();
     void sslWrite();
     int sslError(int ret_code);
+    void onHandshakeDone();
 
     void sendInLoop(const void *data, size_t len) override;
+    void sendInLoop(OutputChain &chain) override;
 
     bool isTLSConnection() const override;
 
 private:
     SSL *ssl_ = nullptr;
     Type type_ = kServer;
+    std::shared_ptr<TlsClientContext> client_context_; // outlives ssl_, see TlsClientContext::create
     SSL_STATUS ssl_status_ = kNone;
     bool ssl_write_want_read_ = false;
     bool ssl_read_want_write_ = false;
     bool has_pending_read_in_loop_ = false;
+    bool ktls_send_ = false;
 };
 
 } // namespace tair::network
@@ -21,6 +21,9 @@
  */
 #include "network/TlsOptions.hpp"
 
+#include <algorithm>
+#include <ctime>
+
 #include "common/Logger.hpp"
 
 #include <openssl/err.h>
@@ -28,30 +31,39 @@
 
 namespace tair::network {
 
-bool TlsOptions::configure(const TlsConfig &config) {
+// Client connections put a pointer to their remote ip:port into the SSL app data,
+// their TlsClientContext is the app data of the SSL_CTX
+static int newClientSessionCallback(SSL *ssl, SSL_SESSION *session) {
+    auto *ip_port = static_cast<const std::string *>(SSL_get_app_data(ssl));
+    auto *context = static_cast<TlsClientContext *>(SSL_CTX_get_app_data(SSL_get_SSL_CTX(ssl)));
+    if (!ip_port || !context || !SSL_SESSION_is_resumable(session)) {
+        return 0;
+    }
+    context->storeSession(*ip_port, session);
+    return 1; // we hold the reference now
+}
+
+std::shared_ptr<SSL_CTX> TlsOptions::createContext(const TlsConfig &config, bool is_client) {
     // using OpenSSL 1.1.0 or above
     runtimeAssert(OPENSSL_VERSION_NUMBER >= 0x10101000L);
 
     int protocols = 0;
     char errbuf[512] = {};
 
-    if (config.tls_cert_file.empty()) {
-        LOG_ERROR("No tls-cert-file configured!");
-        return false;
-    }
-    if (config.tls_key_file.empty()) {
-        LOG_ERROR("No tls-key-file configured!");
-        return false;
-    }
-
     std::shared_ptr<SSL_CTX> ctx(SSL_CTX_new(TLS_method()), [](SSL_CTX *ssl_ctx) { ::SSL_CTX_free(ssl_ctx); });
 
     SSL_CTX_set_options(ctx.get(), SSL_OP_ALL);
     if (config.tls_session_caching != 0) {
-        SSL_CTX_set_session_cache_mode(ctx.get(), SSL_SESS_CACHE_SERVER);
-        SSL_CTX_sess_set_cache_size(ctx.get(), config.tls_session_cache_size);
+        if (is_client) {
+            // OpenSSL's internal cache is server only, client sessions are kept by ip:port
+            SSL_CTX_set_session_cache_mode(ctx.get(), SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+            SSL_CTX_sess_set_new_cb(ctx.get(), newClientSessionCallback);
+        } else {
+            SSL_CTX_set_session_cache_mode(ctx.get(), SSL_SESS_CACHE_SERVER);
+            SSL_CTX_sess_set_cache_size(ctx.get(), config.tls_session_cache_size);
+            SSL_CTX_set_session_id_context(ctx.get(), (unsigned char *)"Tair", 4);
+        }
         SSL_CTX_set_timeout(ctx.get(), config.tls_session_cache_timeout);
-        SSL_CTX_set_session_id_context(ctx.get(), (unsigned char *)"Tair", 4);
     } else {
         SSL_CTX_set_session_cache_mode(ctx.get(), SSL_SESS_CACHE_OFF);
     }
@@ -59,7 +71,7 @@ bool TlsOptions::configure(const TlsConfig &config) {
     protocols = parseProtocolsConfig(config.tls_protocols);
     if (protocols == 0) {
         LOG_ERROR("Wrong tls_protocols: {}", config.tls_protocols);
-        return false;
+        return nullptr;
     }
     /*
      *  Clients should avoid creating "holes" in the set of protocols
@@ -90,26 +102,57 @@ bool TlsOptions::configure(const TlsConfig &config) {
         SSL_CTX_set_options(ctx.get(), SSL_OP_CIPHER_SERVER_PREFERENCE);
     }
 
+    if (config.tls_ktls) {
+#if defined(SSL_OP_ENABLE_KTLS) && !defined(OPENSSL_NO_KTLS)
+        // Silently stays in user space if the kernel has no tls ULP or the cipher is unsupported
+        SSL_CTX_set_options(ctx.get(), SSL_OP_ENABLE_KTLS);
+#else
+        LOG_WARN("kTLS requested but this OpenSSL build does not support it");
+#endif
+    }
+
     SSL_CTX_set_mode(ctx.get(), SSL_MODE_ENABLE_PARTIAL_WRITE | SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER | SSL_MODE_AUTO_RETRY);
 
     // load cert file.
-    if (SSL_CTX_use_certificate_chain_file(ctx.get(), config.tls_cert_file.data()) <= 0) {
+    if (!config.tls_cert_file.empty() && SSL_CTX_use_certificate_chain_file(ctx.get(), config.tls_cert_file.data()) <= 0) {
         ERR_error_string_n(ERR_get_error(), errbuf, sizeof(errbuf));
         LOG_ERROR("Failed to load certificate: {}: {}", config.tls_cert_file.data(), errbuf);
-        return false;
+        return nullptr;
     }
 
     // load key file.
-    if (SSL_CTX_use_PrivateKey_file(ctx.get(), config.tls_key_file.data(), SSL_FILETYPE_PEM) <= 0) {
+    if (!config.tls_key_file.empty() && SSL_CTX_use_PrivateKey_file(ctx.get(), config.tls_key_file.data(), SSL_FILETYPE_PEM) <= 0) {
         ERR_error_string_n(ERR_get_error(), errbuf, sizeof(errbuf));
         LOG_ERROR("Failed to load private key: {}: {}", config.tls_key_file, errbuf);
-        return false;
+        return nullptr;
     }
 
     // load ca file.
-    if (config.tls_auth_clients && SSL_CTX_load_verify_locations(ctx.get(), config.tls_ca_file.data(), nullptr) <= 0) {
+    bool need_ca = is_client ? config.tls_verify_peer : config.tls_auth_clients;
+    if (need_ca && SSL_CTX_load_verify_locations(ctx.get(), config.tls_ca_file.data(), nullptr) <= 0) {
         ERR_error_string_n(ERR_get_error(), errbuf, sizeof(errbuf));
         LOG_ERROR("Failed to configure CA certificate(s) file/directory: {}", errbuf);
+        return nullptr;
+    }
+    if (is_client) {
+        SSL_CTX_set_verify(ctx.get(), config.tls_verify_peer ? SSL_VERIFY_PEER : SSL_VERIFY_NONE, nullptr);
+    }
+
+    return ctx;
+}
+
+bool TlsOptions::configure(const TlsConfig &config) {
+    if (config.tls_cert_file.empty()) {
+        LOG_ERROR("No tls-cert-file configured!");
+        return false;
+    }
+    if (config.tls_key_file.empty()) {
+        LOG_ERROR("No tls-key-file configured!");
+        return false;
+    }
+
+    auto ctx = createContext(config, false);
+    if (!ctx) {
         return false;
     }
 
@@ -120,6 +163,59 @@ bool TlsOptions::configure(const TlsConfig &config) {
     return true;
 }
 
+std::shared_ptr<TlsClientContext> TlsClientContext::create(const TlsConfig &config) {
+    if (config.tls_cert_file.empty() != config.tls_key_file.empty()) {
+        LOG_ERROR("tls-cert-file and tls-key-file must be configured together!");
+        return nullptr;
+    }
+
+    auto ctx = TlsOptions::createContext(config, true);
+    if (!ctx) {
+        return nullptr;
+    }
+
+    std::shared_ptr<TlsClientContext> context = std::make_shared<EnableMakeShared<TlsClientContext>>();
+    context->ssl_ctx_ = ctx;
+    context->server_name_ = config.tls_server_name;
+    context->session_cache_size_ = config.tls_session_caching ? std::max<int64_t>(config.tls_session_cache_size, 1) : 0;
+    // Connections hold the context, so it outlives every SSL that can call back into it
+    SSL_CTX_set_app_data(ctx.get(), context.get());
+
+    return context;
+}
+
+std::shared_ptr<SSL_SESSION> TlsClientContext::getSession(const std::string &ip_port) {
+    LockGuard lock(mutex_);
+    auto iter = sessions_.find(ip_port);
+    if (iter == sessions_.end()) {
+        return nullptr;
+    }
+    SSL_SESSION *session = iter->second.get();
+    if (SSL_SESSION_get_time(session) + SSL_SESSION_get_timeout(session) < (long)time(nullptr)) {
+        sessions_.erase(iter);
+        return nullptr;
+    }
+    return iter->second;
+}
+
+void TlsClientContext::storeSession(const std::string &ip_port, SSL_SESSION *session) {
+    std::shared_ptr<SSL_SESSION> holder(session, [](SSL_SESSION *s) { ::SSL_SESSION_free(s); });
+    LockGuard lock(mutex_);
+    if (session_cache_size_ == 0) {
+        return;
+    }
+    auto iter = sessions_.find(ip_port);
+    if (iter != sessions_.end()) {
+        iter->second = std::move(holder);
+        return;
+    }
+    if (sessions_.size() >= session_cache_size_) {
+        // Any victim will do, a missing entry only costs one full handshake
+        sessions_.erase(sessions_.begin());
+    }
+    sessions_.emplace(ip_port, std::move(holder));
+}
+
 int TlsOptions::parseProtocolsConfig(const std::string &str) {
     if (str.empty()) {
         return REDIS_TLS_PROTO_DEFAULT;
@@ -23,18 +23,22 @@
 
 #include <memory>
 #include <string>
+#include <unordered_map>
 
 #include "common/Assert.hpp"
+#include "common/EnableMakeShared.hpp"
 #include "common/Mutex.hpp"
 #include "common/Noncopyable.hpp"
 
 typedef struct ssl_ctx_st SSL_CTX;
+typedef struct ssl_session_st SSL_SESSION;
 
 namespace tair::network {
 
 using common::Mutex;
 using common::LockGuard;
 using common::Noncopyable;
+using common::EnableMakeShared;
 
 #define REDIS_TLS_PROTO_TLSv1   (1 << 0)
 #define REDIS_TLS_PROTO_TLSv1_1 (1 << 1)
@@ -56,6 +60,10 @@ struct TlsConfig {
     int64_t tls_session_cache_size;
     long tls_session_cache_timeout;
     bool tls_prefer_server_ciphers;
+
+    bool tls_verify_peer = false;  // client, verify server cert against tls_ca_file
+    std::string tls_server_name;   // client, SNI and hostname to verify
+    bool tls_ktls = false;         // both, hand record crypto to the kernel when available
 };
 
 class TlsOptions : private Noncopyable {
@@ -91,7 +99,9 @@ public:
     }
 
 private:
+    friend class TlsClientContext;
     static int parseProtocolsConfig(const std::string &str);
+    static std::shared_ptr<SSL_CTX> createContext(const TlsConfig &config, bool is_client);
 
 private:
     mutable Mutex mutex_;
@@ -99,4 +109,42 @@ private:
     bool tls_auth_clients_ GUARDED_BY(mutex_) = false;
 };
 
+// Outgoing connections of one client. Every client builds its own, so the SNI name,
+// peer verification and cached sessions of one server never reach another
+class TlsClientContext : private Noncopyable {
+public:
+    // Cert and key are optional here, nullptr if the config is unusable
+    static std::shared_ptr<TlsClientContext> create(const TlsConfig &config);
+
+protected:
+    TlsClientContext() = default;
+
+public:
+    ~TlsClientContext() = default;
+
+    SSL_CTX *getSslContext() const {
+        return ssl_ctx_.get();
+    }
+
+    const std::string &getServerName() const {
+        return server_name_;
+    }
+
+    // Sessions keyed by remote ip:port, reused on reconnect to skip the full handshake
+    std::shared_ptr<SSL_SESSION> getSession(const std::string &ip_port) EXCLUDES(mutex_);
+    void storeSession(const std::string &ip_port, SSL_SESSION *session) EXCLUDES(mutex_);
+    size_t getSessionCount() const EXCLUDES(mutex_) {
+        LockGuard lock(mutex_);
+        return sessions_.size();
+    }
+
+private:
+    std::shared_ptr<SSL_CTX> ssl_ctx_;
+    std::string server_name_;
+    size_t session_cache_size_ = 0;
+
+    mutable Mutex mutex_;
+    std::unordered_map<std::string, std::shared_ptr<SSL_SESSION>> sessions_ GUARDED_BY(mutex_);
+};
+
 } // namespace tair::network
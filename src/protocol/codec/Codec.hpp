@@ -26,6 +26,7 @@
 
 #include "common/Noncopyable.hpp"
 #include "network/Buffer.hpp"
+#include "network/OutputChain.hpp"
 #include "protocol/codec/CodecType.hpp"
 #include "protocol/packet/Packet.hpp"
 
@@ -33,6 +34,7 @@ namespace tair::protocol {
 
 using common::Noncopyable;
 using network::Buffer;
+using network::OutputChain;
 
 class Codec;
 using CodecPtr = std::shared_ptr<Codec>;
@@ -50,6 +52,19 @@ public:
     virtual DState encodeRequest(Buffer *buf, Packet *packet) = 0;
     virtual DState decodeResponse(Buffer *buf, PacketUniqPtr &packet) = 0;
 
+    // Whether encodeRequestToChain can reference payloads of packet instead of copying them
+    virtual bool hasLargePayload(Packet *packet) const {
+        return false;
+    }
+
+    // Encode into an output chain, large payloads stay owned by packet until written
+    virtual DState encodeRequestToChain(OutputChain *chain, const PacketPtr &packet) {
+        Buffer buf;
+        auto dstate = encodeRequest(&buf, packet.get());
+        chain->append(buf.data(), buf.length());
+        return dstate;
+    }
+
     CodecType getCodecType() const {
         return codec_ver_;
     }
@@ -60,8 +75,22 @@ public:
 
     const std::any &getContext() { return context_; };
 
+    // After DState::AGAIN, the buffer length the pending packet needs before decoding
+    // can make progress, 0 if unknown. Readers may reserve it once and skip decode attempts.
+    size_t getExpectedBytes() const {
+        return expected_bytes_;
+    }
+
+    // Stream the body of the next response into sink when it is a bulk string,
+    // dropped otherwise. Must be set before that response starts decoding.
+    void setResponseSink(BulkStringSink &&sink) {
+        response_sink_ = std::move(sink);
+    }
+
 protected:
     CodecType codec_ver_ = CodecType::NONE;
+    size_t expected_bytes_ = 0;
+    BulkStringSink response_sink_;
     std::string err_;
     std::any context_;
 };
@@ -23,6 +23,7 @@
 
 #include "protocol/ProtocolOptions.hpp"
 #include "protocol/packet/resp/ArrayPacket.hpp"
+#include "protocol/packet/resp/BulkStringPacket.hpp"
 #include "protocol/packet/resp/RESPPacketFactory.hpp"
 
 namespace tair::protocol {
@@ -88,11 +89,13 @@ DState RESP2Codec::processMultibulk(Buffer *buf, PacketUniqPtr &packet) {
     }
     auto pre_size = buf->size();
     auto dstate = req_packet_->decodeRESP2(buf);
+    expected_bytes_ = 0;
     if (dstate == DState::SUCCESS) {
         req_packet_->addPacketSize(pre_size - buf->size());
         packet = std::move(req_packet_);
     } else if (dstate == DState::AGAIN) {
         req_packet_->addPacketSize(pre_size - buf->size());
+        expected_bytes_ = req_packet_->getDecodeExpectedBytes();
     } else if (dstate == DState::ERROR) {
         err_ = req_packet_->getDecodeErr();
     }
@@ -101,10 +104,72 @@ DState RESP2Codec::processMultibulk(Buffer *buf, PacketUniqPtr &packet) {
 
 // ---- for client ----
 
+void RESP2Codec::attachResponseSink() {
+    if (!response_sink_) {
+        return;
+    }
+    auto *bulk = resp_packet_->packet_cast<BulkStringPacket>();
+    if (bulk) {
+        bulk->setDecodeSink(std::move(response_sink_));
+    }
+    response_sink_ = nullptr;
+}
+
 DState RESP2Codec::encodeRequest(Buffer *buf, Packet *packet) {
     return packet->encodeRESP2(buf);
 }
 
+static bool isLargeBulk(Packet *packet) {
+    auto *bulk = packet->packet_cast<BulkStringPacket>();
+    return bulk && bulk->getType() == PacketType::TYPE_COMMON
+           && bulk->getValue().size() >= ProtocolOptions::PROTO_RESP_MBULK_BIG_ARG;
+}
+
+bool RESP2Codec::hasLargePayload(Packet *packet) const {
+    auto *array = packet->packet_cast<ArrayPacket>();
+    if (!array || array->getType() != PacketType::TYPE_COMMON) {
+        return false;
+    }
+    for (auto *item : array->getPacketArray()) {
+        if (isLargeBulk(item)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+DState RESP2Codec::encodeRequestToChain(OutputChain *chain, const PacketPtr &packet) {
+    if (!hasLargePayload(packet.get())) {
+        return Codec::encodeRequestToChain(chain, packet);
+    }
+    // Headers and small items are batched in buf, large bulks are referenced in place
+    auto *array = packet->packet_cast<ArrayPacket>();
+    Buffer buf;
+    buf.appendInt8(ARRAY_PACKET_MAGIC);
+    buf.appendNumberToStr(array->getPacketArray().size());
+    buf.appendCRLF();
+    for (auto *item : array->getPacketArray()) {
+        if (!isLargeBulk(item)) {
+            if (codec_ver_ == CodecType::RESP3) {
+                item->encodeRESP3(&buf);
+            } else {
+                item->encodeRESP2(&buf);
+            }
+            continue;
+        }
+        const std::string &value = item->packet_cast<BulkStringPacket>()->getValue();
+        buf.appendInt8(BULK_STRING_PACKET_MAGIC);
+        buf.appendNumberToStr(value.size());
+        buf.appendCRLF();
+        chain->append(buf.data(), buf.length());
+        buf.reset();
+        chain->appendRef(value.data(), value.size(), packet);
+        buf.appendCRLF();
+    }
+    chain->append(buf.data(), buf.length());
+    return DState::SUCCESS;
+}
+
 DState RESP2Codec::decodeResponse(Buffer *buf, PacketUniqPtr &packet) {
     err_.clear();
     if (buf->empty()) {
@@ -118,14 +183,17 @@ DState RESP2Codec::decodeResponse(Buffer *buf, PacketUniqPtr &packet) {
             err_ = fmt::format("Protocol error: unknown type '{}'", out);
             return DState::ERROR;
         }
+        attachResponseSink();
     }
     auto pre_size = buf->size();
     auto dstate = resp_packet_->decodeRESP2(buf);
+    expected_bytes_ = 0;
     if (dstate == DState::SUCCESS) {
         resp_packet_->addPacketSize(pre_size - buf->size());
         packet = std::move(resp_packet_);
     } else if (dstate == DState::AGAIN) {
         resp_packet_->addPacketSize(pre_size - buf->size());
+        expected_bytes_ = resp_packet_->getDecodeExpectedBytes();
     } else if (dstate == DState::ERROR) {
         err_ = resp_packet_->getDecodeErr();
     }
@@ -39,10 +39,15 @@ public:
     DState encodeRequest(Buffer *buf, Packet *packet) override;
     DState decodeResponse(Buffer *buf, PacketUniqPtr &packet) override;
 
+    bool hasLargePayload(Packet *packet) const override;
+    DState encodeRequestToChain(OutputChain *chain, const PacketPtr &packet) override;
+
 protected:
     // for request decode
     DState processInline(Buffer *buf, PacketUniqPtr &packet);
     DState processMultibulk(Buffer *buf, PacketUniqPtr &packet);
+    // for response decode
+    void attachResponseSink();
 
 protected:
     PacketUniqPtr req_packet_;
@@ -59,14 +59,17 @@ DState RESP3Codec::decodeResponse(Buffer *buf, PacketUniqPtr &packet) {
             err_ = fmt::format("Protocol error: unknown type '{}'", out);
             return DState::ERROR;
         }
+        attachResponseSink();
     }
     auto pre_size = buf->size();
     auto dstate = resp_packet_->decodeRESP3(buf);
+    expected_bytes_ = 0;
     if (dstate == DState::SUCCESS) {
         resp_packet_->addPacketSize(pre_size - buf->size());
         packet = std::move(resp_packet_);
     } else if (dstate == DState::AGAIN) {
         resp_packet_->addPacketSize(pre_size - buf->size());
+        expected_bytes_ = resp_packet_->getDecodeExpectedBytes();
     } else if (dstate == DState::ERROR) {
         err_ = resp_packet_->getDecodeErr();
     }
@@ -21,6 +21,7 @@
  */
 #pragma once
 
+#include <functional>
 #include <memory>
 
 #include "common/Compiler.hpp"
@@ -38,6 +39,9 @@ class Packet;
 using PacketPtr = std::shared_ptr<Packet>;
 using PacketUniqPtr = std::unique_ptr<Packet>;
 
+// Receives a bulk string body chunk by chunk as it is decoded, return false to stop receiving
+using BulkStringSink = std::function<bool(const char *data, size_t len)>;
+
 enum class PacketType : uint8_t {
     TYPE_COMMON = 0,
     TYPE_NULL = 1,
@@ -71,6 +75,12 @@ public:
         packet_size_ += packet_size;
     }
 
+    // Bytes that must be readable before an unfinished decode can make progress,
+    // 0 if unknown. Known once a length header like $<len> has been parsed.
+    virtual size_t getDecodeExpectedBytes() const {
+        return 0;
+    }
+
 private:
     size_t packet_size_ = 0;
 };
@@ -190,6 +190,10 @@ public:
         context_ = context;
     }
 
+    size_t getDecodeExpectedBytes() const override {
+        return curr_parse_packet_ ? curr_parse_packet_->getDecodeExpectedBytes() : 0;
+    }
+
     size_t getRESP2EncodeSize() const override {
         return getEncode2Size();
     }
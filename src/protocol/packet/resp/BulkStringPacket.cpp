@@ -21,6 +21,8 @@
  */
 #include "protocol/packet/resp/BulkStringPacket.hpp"
 
+#include <algorithm>
+
 #include "absl/strings/numbers.h"
 
 #include "common/Compiler.hpp"
@@ -34,7 +36,8 @@ using absl::string_view;
 size_t BulkStringPacket::getEncodeSize() const {
     if (type_ == PacketType::TYPE_COMMON) {
         // $ and len and \r\n and data and \r\n
-        return 1 + fmt::formatted_size("{}", bulk_str_.size()) + 2 + bulk_str_.size() + 2;
+        const std::string &value = getValue();
+        return 1 + fmt::formatted_size("{}", value.size()) + 2 + value.size() + 2;
     } else {
         // $ -1 \r\n
         return 1 + 2 + 2;
@@ -44,9 +47,10 @@ size_t BulkStringPacket::getEncodeSize() const {
 DState BulkStringPacket::encode(Buffer *buf, uint8_t packet_magic) {
     buf->appendInt8(packet_magic);
     if (type_ == PacketType::TYPE_COMMON) {
-        buf->appendNumberToStr(bulk_str_.size());
+        const std::string &value = getValue();
+        buf->appendNumberToStr(value.size());
         buf->appendCRLF();
-        buf->append(bulk_str_);
+        buf->append(value);
     } else {
         buf->append("-1", 2);
     }
@@ -89,12 +93,16 @@ DState BulkStringPacket::decode(Buffer *buf, uint8_t packet_magic) {
             type_ = PacketType::TYPE_NULL;
             return DState::SUCCESS;
         }
-        if (decode_bulk_len_ >= (int64_t)ProtocolOptions::PROTO_RESP_MBULK_BIG_ARG) {
+        // Reserve a big bulk in one step, a no-op once the reader did it, see Codec::getExpectedBytes
+        if (!decode_sink_ && decode_bulk_len_ >= (int64_t)ProtocolOptions::PROTO_RESP_MBULK_BIG_ARG) {
             if ((int64_t)buf->length() <= decode_bulk_len_ + 2) {
                 buf->ensureWritableBytes(decode_bulk_len_ + 2 - buf->length());
             }
         }
     }
+    if (decode_sink_) {
+        return decodeToSink(buf);
+    }
     if ((int64_t)buf->length() < decode_bulk_len_ + 2) {
         // Not enough data (+2 for trailing \r\n)
         return DState::AGAIN;
@@ -105,4 +113,27 @@ DState BulkStringPacket::decode(Buffer *buf, uint8_t packet_magic) {
     return DState::SUCCESS;
 }
 
+DState BulkStringPacket::decodeToSink(Buffer *buf) {
+    size_t body_len = decode_bulk_len_;
+    if (streamed_len_ < body_len) {
+        size_t n = std::min(buf->length(), body_len - streamed_len_);
+        if (n > 0 && !sink_aborted_ && !decode_sink_(buf->data(), n)) {
+            sink_aborted_ = true;
+        }
+        buf->skip(n);
+        streamed_len_ += n;
+        if (streamed_len_ < body_len) {
+            return DState::AGAIN;
+        }
+    }
+    if (buf->length() < 2) {
+        // Wait for trailing \r\n
+        return DState::AGAIN;
+    }
+    buf->skip(2);
+    decode_bulk_len_ = NOT_SET_SIZE;
+    decode_sink_ = nullptr;
+    return DState::SUCCESS;
+}
+
 } // namespace tair::protocol
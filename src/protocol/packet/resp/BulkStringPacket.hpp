@@ -21,6 +21,10 @@
  */
 #pragma once
 
+#include <memory>
+#include <string>
+#include <type_traits>
+
 #include "protocol/packet/Packet.hpp"
 
 namespace tair::protocol {
@@ -28,11 +32,16 @@ namespace tair::protocol {
 class BulkStringPacket : public Packet {
 public:
     template <typename T>
+        requires std::is_constructible_v<std::string, T>
     BulkStringPacket(T &&t)
         : bulk_str_(std::forward<T>(t)) {}
 
     explicit BulkStringPacket(const std::string *str)
         : bulk_str_(*str) {}
+    // Shares the caller's value instead of copying it, the packet keeps it alive until it is
+    // written. Large values are then sent straight from it, see RESP2Codec::encodeRequestToChain
+    explicit BulkStringPacket(std::shared_ptr<const std::string> str)
+        : shared_str_(std::move(str)) {}
     explicit BulkStringPacket(PacketType type)
         : type_(type) {}
 
@@ -44,11 +53,38 @@ public:
     }
 
     const std::string &getValue() const {
-        return bulk_str_;
+        return shared_str_ ? *shared_str_ : bulk_str_;
     }
 
     std::string moveBulkStr() {
-        return std::move(bulk_str_);
+        return shared_str_ ? *shared_str_ : std::move(bulk_str_);
+    }
+
+    // Stream the body into sink instead of bulk_str_, must be set before decoding starts
+    void setDecodeSink(BulkStringSink &&sink) {
+        decode_sink_ = std::move(sink);
+    }
+
+    bool hasDecodeSink() const {
+        return (bool)decode_sink_;
+    }
+
+    size_t getStreamedLength() const {
+        return streamed_len_;
+    }
+
+    // The sink returned false, the remaining body was read and dropped
+    bool isSinkAborted() const {
+        return sink_aborted_;
+    }
+
+    size_t getDecodeExpectedBytes() const override {
+        if (decode_bulk_len_ < 0 || decode_sink_) {
+            // Streamed bodies never need the whole payload buffered
+            return 0;
+        }
+        // +2 for trailing \r\n
+        return decode_bulk_len_ + 2;
     }
 
     size_t getRESP2EncodeSize() const override {
@@ -79,11 +115,16 @@ protected:
     size_t getEncodeSize() const;
     DState encode(Buffer *buf, uint8_t packet_magic);
     DState decode(Buffer *buf, uint8_t packet_magic);
+    DState decodeToSink(Buffer *buf);
 
 protected:
     PacketType type_ = PacketType::TYPE_COMMON;
     int64_t decode_bulk_len_ = NOT_SET_SIZE;
     std::string bulk_str_;
+    std::shared_ptr<const std::string> shared_str_; // encode only, replaces bulk_str_ when set
+    BulkStringSink decode_sink_;
+    size_t streamed_len_ = 0;
+    bool sink_aborted_ = false;
 };
 
 } // namespace tair::protocol
@@ -145,6 +145,10 @@ public:
         packet_array_.emplace_back(std::make_pair(key, value));
     }
 
+    size_t getDecodeExpectedBytes() const override {
+        return curr_parse_packet_ ? curr_parse_packet_->getDecodeExpectedBytes() : 0;
+    }
+
     size_t getRESP2EncodeSize() const override {
         return getEncode2Size();
     }
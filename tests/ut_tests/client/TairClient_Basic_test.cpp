@@ -21,30 +21,53 @@
  */
 #include "gtest/gtest.h"
 
+#include <cstdio>
+#include <set>
+#include <thread>
+#include <unistd.h>
+
 #include "common/CountDownLatch.hpp"
+#include "common/KeyHash.hpp"
 #include "common/Logger.hpp"
+#include "network/TcpServer.hpp"
 #include "protocol/packet/resp/ArrayPacket.hpp"
 #include "protocol/packet/resp/ErrorPacket.hpp"
 #include "protocol/packet/resp/VerbatimStringPacket.hpp"
 #include "client/TairAsyncClient.hpp"
 #include "client/TairBaseClient.hpp"
 #include "client/TairClient.hpp"
+#include "client/TairClientMetrics.hpp"
+#include "client/TairLoopPool.hpp"
+#include "client/TairSink.hpp"
 #include "client/TairSubscribeClient.hpp"
 
 #include "TairClient_Standalone_Server.hpp"
 
+using tair::common::ClockTime;
 using tair::common::CountDownLatch;
+using tair::common::KeyHash;
+using tair::common::MetricSet;
 using tair::client::TairBaseClient;
 using tair::client::TairAsyncClient;
 using tair::client::TairClientWrapper;
+using tair::client::TairLoopPool;
+using tair::client::TairSink;
 using tair::client::TairSubscribeClient;
 using tair::client::PubSubCount;
 using tair::client::SubMessage;
 using tair::client::PSubMessage;
 using tair::client::TairClient;
+using tair::client::TairClientMetrics;
+using tair::client::TairLoadTracker;
 using tair::client::TairResult;
 using tair::client::TairURI;
+using tair::client::CommandArgv;
+using tair::client::PoolSelectPolicy;
+using tair::client::RequestLimits;
+using tair::network::EventLoop;
 using tair::network::EventLoopThread;
+using tair::network::Buffer;
+using tair::network::TcpServer;
 using tair::network::TcpConnectionPtr;
 using tair::network::Duration;
 using tair::protocol::PacketPtr;
@@ -61,6 +84,396 @@ TEST_F(StandAloneTest, CONN_FAILED_TEST) {
     ASSERT_TRUE(!client->connect().get().isSuccess());
 }
 
+TEST(TairLoopPoolTest, SHARED_LOOP_TEST) {
+    auto &pool = TairLoopPool::instance();
+    size_t thread_num = pool.getThreadNum();
+    std::set<EventLoop *> loops;
+    for (size_t i = 0; i < thread_num * 2; ++i) {
+        auto *loop = pool.getNextLoop();
+        ASSERT_TRUE(loop);
+        loops.insert(loop);
+    }
+    ASSERT_EQ(thread_num, loops.size());
+    // Thread num can not be changed once the pool is started
+    ASSERT_FALSE(pool.setThreadNum(thread_num + 1));
+
+    // Clients without a loop attach to the shared pool, no thread is created
+    std::vector<std::unique_ptr<TairAsyncClient>> clients;
+    for (int i = 0; i < 64; ++i) {
+        clients.emplace_back(std::make_unique<TairAsyncClient>());
+    }
+    clients.clear();
+}
+
+TEST(TairLoopPoolTest, DESTROY_WITH_QUEUED_REQUESTS_TEST) {
+    // The shared loop outlives the clients, what they queued fails before they are gone
+    std::atomic<int> failed = 0;
+    for (int i = 0; i < 64; ++i) {
+        auto client = std::make_unique<TairAsyncClient>();
+        client->setServerAddr("127.0.0.1:1");
+        client->setLazyConnect(i % 2 == 0);
+        for (int j = 0; j < 4; ++j) {
+            client->sendCommand({"get", "key"}, [&failed](auto *, auto &, auto &resp) {
+                if (!resp) {
+                    failed++;
+                }
+            });
+        }
+    }
+    ASSERT_EQ(64 * 4, failed);
+}
+
+// Splits whole RESP commands off buf, a partial one stays for the next read
+static std::vector<CommandArgv> parseCommands(Buffer *buf) {
+    std::vector<CommandArgv> commands;
+    std::string data(buf->data(), buf->length());
+    size_t pos = 0;
+    while (pos < data.size() && data[pos] == '*') {
+        size_t end = data.find("\r\n", pos);
+        if (end == std::string::npos) {
+            break;
+        }
+        size_t count = std::stoul(data.substr(pos + 1, end - pos - 1));
+        size_t next = end + 2;
+        CommandArgv argv;
+        for (size_t i = 0; i < count; ++i) {
+            end = data.find("\r\n", next);
+            if (end == std::string::npos) {
+                break;
+            }
+            size_t len = std::stoul(data.substr(next + 1, end - next - 1));
+            if (end + 2 + len + 2 > data.size()) {
+                break;
+            }
+            argv.emplace_back(data.substr(end + 2, len));
+            next = end + 2 + len + 2;
+        }
+        if (argv.size() != count) {
+            break;
+        }
+        commands.push_back(std::move(argv));
+        pos = next;
+    }
+    buf->skip(pos);
+    return commands;
+}
+
+TEST(TairReconnectTest, REPLAY_READ_TEST) {
+    EventLoopThread loop_thread;
+    loop_thread.start();
+    TcpServer server(loop_thread.loop(), "tcp://127.0.0.1:0", 1, "fake-redis");
+    // The first connection dies right after reading the get, the read must be replayed on the next one
+    std::atomic_int get_count = 0;
+    server.setMessageCallback([&get_count](const TcpConnectionPtr &conn, Buffer *buf) {
+        for (auto &argv : parseCommands(buf)) {
+            if (argv[0] == "set") {
+                conn->close();
+                return;
+            } else if (argv[0] != "get") {
+                conn->send("+OK\r\n");
+            } else if (get_count++ == 0) {
+                conn->close();
+                return;
+            } else {
+                conn->send("$5\r\nvalue\r\n");
+            }
+        }
+    });
+    CountDownLatch stopped;
+    server.setClosedCallback([&stopped]() {
+        stopped.countDown();
+    });
+    ASSERT_TRUE(server.start());
+
+    auto client = std::make_unique<TairAsyncClient>();
+    client->setServerAddr(*server.getRealListenIpPorts().begin());
+    ASSERT_TRUE(client->connect().get().isSuccess());
+
+    CountDownLatch latch;
+    client->sendCommand({"get", "key"}, [&latch](auto *, auto &, auto &resp) {
+        ASSERT_TRUE(resp);
+        auto *value = resp->template packet_cast<BulkStringPacket>();
+        ASSERT_TRUE(value);
+        ASSERT_EQ("value", value->getValue());
+        latch.countDown();
+    });
+    latch.wait();
+    ASSERT_EQ(2, get_count);
+
+    // Writes are not replayed, their callback sees the drop
+    std::atomic_bool set_failed = false;
+    CountDownLatch set_latch;
+    client->sendCommand({"set", "key", "value"}, [&set_failed, &set_latch](auto *, auto &, auto &resp) {
+        set_failed = !resp;
+        set_latch.countDown();
+    });
+    set_latch.wait();
+    ASSERT_TRUE(set_failed);
+
+    client->destroy();
+    server.stop();
+    stopped.wait();
+}
+
+TEST(TairReconnectTest, BUFFER_DEADLINE_TEST) {
+    auto client = std::make_unique<TairAsyncClient>();
+    client->setServerAddr("127.0.0.1:2001");
+    client->setReconnectBufferTimeoutMs(100);
+    ASSERT_FALSE(client->connect().get().isSuccess());
+
+    // Nobody listens, the request waits for a reconnect until its deadline
+    CountDownLatch latch;
+    int64_t start_ms = ClockTime::intervalMs();
+    client->sendCommand({"get", "key"}, [&latch](auto *, auto &, auto &resp) {
+        ASSERT_FALSE(resp);
+        latch.countDown();
+    });
+    latch.wait();
+    ASSERT_GE(ClockTime::intervalMs() - start_ms, 90);
+
+    // A zero sized buffer fails at once
+    client->setReconnectBufferSize(0);
+    CountDownLatch fail_latch;
+    client->sendCommand({"get", "key"}, [&fail_latch](auto *, auto &, auto &resp) {
+        ASSERT_FALSE(resp);
+        fail_latch.countDown();
+    });
+    fail_latch.wait();
+    client->destroy();
+}
+
+TEST(TairHedgeTest, HEDGED_READ_TEST) {
+    EventLoopThread loop_thread;
+    loop_thread.start();
+    TcpServer server(loop_thread.loop(), "tcp://127.0.0.1:0", 1, "fake-redis");
+    // Only the first read of the slow key stalls, its hedge on the other connection answers at once
+    std::atomic_bool stalled = false;
+    CountDownLatch stall_done;
+    server.setMessageCallback([&](const TcpConnectionPtr &conn, Buffer *buf) {
+        for (auto &argv : parseCommands(buf)) {
+            if (argv[0] != "get") {
+                conn->send("+OK\r\n");
+            } else if (argv[1] == "slow" && !stalled.exchange(true)) {
+                conn->loop()->runAfterTimer(Duration(300 * Duration::kMillisecond), [conn, &stall_done](EventLoop *) {
+                    conn->send("$4\r\nlate\r\n");
+                    stall_done.countDown();
+                });
+            } else {
+                conn->send("$5\r\nvalue\r\n");
+            }
+        }
+    });
+    CountDownLatch stopped;
+    server.setClosedCallback([&stopped]() {
+        stopped.countDown();
+    });
+    ASSERT_TRUE(server.start());
+
+    auto client = std::make_unique<TairAsyncClient>();
+    client->setServerAddr(*server.getRealListenIpPorts().begin());
+    client->setConnectionPoolSize(2);
+    client->setHedgeBudgetPercent(100);
+    ASSERT_TRUE(client->connect().get().isSuccess());
+
+    // Warm up the latency window so a p95 exists
+    CountDownLatch warm_latch(512);
+    for (int i = 0; i < 512; ++i) {
+        client->sendCommand({"get", "key"}, [&warm_latch](auto *, auto &, auto &) {
+            warm_latch.countDown();
+        });
+    }
+    warm_latch.wait();
+
+    CountDownLatch latch;
+    std::string value;
+    int64_t latency_us = 0;
+    client->sendCommand({"get", "slow"}, [&](auto *, auto &, auto &resp, int64_t latency) {
+        if (resp && resp->template packet_cast<BulkStringPacket>()) {
+            value = resp->template packet_cast<BulkStringPacket>()->getValue();
+        }
+        latency_us = latency;
+        latch.countDown();
+    });
+    latch.wait();
+    ASSERT_EQ("value", value);
+    ASSERT_LT(latency_us, 300 * 1000);
+    ASSERT_GE(client->getHedgeCount(), 1U);
+
+    stall_done.wait();
+    client->destroy();
+    server.stop();
+    stopped.wait();
+}
+
+TEST(TairLimiterTest, LIMIT_REJECT_ON_LOOP_TEST) {
+    EventLoopThread loop_thread;
+    loop_thread.start();
+    TcpServer server(loop_thread.loop(), "tcp://127.0.0.1:0", 1, "fake-redis");
+    // Reads are never answered, so the first one holds the only inflight slot
+    server.setMessageCallback([](const TcpConnectionPtr &conn, Buffer *buf) {
+        for (auto &argv : parseCommands(buf)) {
+            if (argv[0] != "get") {
+                conn->send("+OK\r\n");
+            }
+        }
+    });
+    CountDownLatch stopped;
+    server.setClosedCallback([&stopped]() {
+        stopped.countDown();
+    });
+    ASSERT_TRUE(server.start());
+
+    auto client = std::make_unique<TairAsyncClient>();
+    client->setServerAddr(*server.getRealListenIpPorts().begin());
+    RequestLimits limits;
+    limits.max_inflight = 1;
+    client->setRequestLimits(limits);
+    ASSERT_TRUE(client->connect().get().isSuccess());
+
+    client->sendCommand({"get", "key"}, [](auto *, auto &, auto &) {});
+    // The reject comes back on the loop thread like any other reply
+    CountDownLatch latch;
+    std::string error;
+    bool caller_thread = true;
+    auto caller_id = std::this_thread::get_id();
+    client->sendCommand({"get", "key"}, [&](auto *, auto &, auto &resp) {
+        caller_thread = std::this_thread::get_id() == caller_id;
+        if (resp && resp->template packet_cast<ErrorPacket>()) {
+            error = resp->template packet_cast<ErrorPacket>()->getValue();
+        }
+        latch.countDown();
+    });
+    latch.wait();
+    ASSERT_FALSE(caller_thread);
+    ASSERT_EQ("ERR client side request limit reached", error);
+
+    client->destroy();
+    server.stop();
+    stopped.wait();
+}
+
+TEST(TairTimingTest, REQUEST_TIMING_TEST) {
+    EventLoopThread loop_thread;
+    loop_thread.start();
+    TcpServer server(loop_thread.loop(), "tcp://127.0.0.1:0", 1, "fake-redis");
+    // The reply starts after 50ms and its second half follows 30ms later
+    server.setMessageCallback([&](const TcpConnectionPtr &conn, Buffer *buf) {
+        for (auto &argv : parseCommands(buf)) {
+            if (argv[0] != "get") {
+                conn->send("+OK\r\n");
+                continue;
+            }
+            conn->loop()->runAfterTimer(Duration(50 * Duration::kMillisecond), [conn](EventLoop *loop) {
+                conn->send("$5\r\nva");
+                loop->runAfterTimer(Duration(30 * Duration::kMillisecond), [conn](EventLoop *) {
+                    conn->send("lue\r\n");
+                });
+            });
+        }
+    });
+    CountDownLatch stopped;
+    server.setClosedCallback([&stopped]() {
+        stopped.countDown();
+    });
+    ASSERT_TRUE(server.start());
+
+    auto client = std::make_unique<TairAsyncClient>();
+    client->setServerAddr(*server.getRealListenIpPorts().begin());
+    ASSERT_TRUE(client->connect().get().isSuccess());
+
+    CountDownLatch latch;
+    std::string value;
+    int64_t latency_us = 0;
+    tair::client::RequestTiming timing;
+    client->sendCommand({"get", "key"}, [&](auto *, auto &, auto &resp, int64_t latency, const tair::client::RequestTiming &t) {
+        if (resp && resp->template packet_cast<BulkStringPacket>()) {
+            value = resp->template packet_cast<BulkStringPacket>()->getValue();
+        }
+        latency_us = latency;
+        timing = t;
+        latch.countDown();
+    });
+    latch.wait();
+    ASSERT_EQ("value", value);
+    ASSERT_EQ(latency_us, timing.total_us);
+    ASSERT_EQ(timing.total_us, timing.queue_us + timing.network_us + timing.decode_us);
+    ASSERT_LT(timing.queue_us, 40 * 1000);
+    ASSERT_GE(timing.network_us, 45 * 1000);
+    ASSERT_GE(timing.decode_us, 25 * 1000);
+
+    // The handshake is not counted
+    auto stats = client->getStats();
+    ASSERT_EQ(1U, stats.phases.network.count);
+    ASSERT_EQ(1U, stats.node_phases.size());
+    ASSERT_GE(stats.phases.decode.max_us, 25 * 1000U);
+
+    client->destroy();
+    server.stop();
+    stopped.wait();
+}
+
+TEST(TairSlowLogTest, SLOW_LOG_TEST) {
+    EventLoopThread loop_thread;
+    loop_thread.start();
+    TcpServer server(loop_thread.loop(), "tcp://127.0.0.1:0", 1, "fake-redis");
+    server.setMessageCallback([&](const TcpConnectionPtr &conn, Buffer *buf) {
+        for (auto &argv : parseCommands(buf)) {
+            if (argv.size() > 1 && argv[1] == "slow") {
+                conn->loop()->runAfterTimer(Duration(40 * Duration::kMillisecond), [conn](EventLoop *) {
+                    conn->send("$5\r\nvalue\r\n");
+                });
+            } else {
+                conn->send("+OK\r\n");
+            }
+        }
+    });
+    CountDownLatch stopped;
+    server.setClosedCallback([&stopped]() {
+        stopped.countDown();
+    });
+    ASSERT_TRUE(server.start());
+
+    auto client = std::make_unique<TairAsyncClient>();
+    client->setServerAddr(*server.getRealListenIpPorts().begin());
+    client->setSlowLog({.threshold_us = 20 * 1000, .capacity = 2, .log = true});
+    ASSERT_TRUE(client->connect().get().isSuccess());
+
+    // Replies come in order, so the fast ones are sent first to stay fast
+    CountDownLatch latch(13);
+    for (int i = 0; i < 10; ++i) {
+        client->sendCommand({"set", "fast", "value"}, [&latch](auto *, auto &, auto &) {
+            latch.countDown();
+        });
+    }
+    for (int i = 0; i < 3; ++i) {
+        client->sendCommand({"GET", "slow"}, [&latch](auto *, auto &, auto &) {
+            latch.countDown();
+        });
+    }
+    latch.wait();
+
+    auto entries = client->getSlowLog(10);
+    ASSERT_EQ(2U, entries.size());
+    ASSERT_EQ(2U, entries[0].id);
+    ASSERT_EQ(1U, entries[1].id);
+    auto &entry = entries[0];
+    ASSERT_EQ("get", entry.command);
+    ASSERT_EQ("slow", entry.key);
+    ASSERT_EQ(KeyHash::keyHashSlot(std::string("slow")), entry.slot);
+    ASSERT_EQ(*server.getRealListenIpPorts().begin(), entry.node);
+    ASSERT_GT(entry.request_bytes, 0U);
+    ASSERT_EQ(11U, entry.reply_bytes);
+    ASSERT_LE(entry.submit_us, entry.write_us);
+    ASSERT_LE(entry.write_us, entry.first_byte_us);
+    ASSERT_LE(entry.first_byte_us, entry.callback_us);
+    ASSERT_GE(entry.callback_us - entry.submit_us, 20 * 1000);
+    ASSERT_EQ(1U, client->getSlowLog(1).size());
+
+    client->destroy();
+    server.stop();
+    stopped.wait();
+}
+
 TEST_F(StandAloneTest, ASYNC_SEND_COMMAND_TEST) {
     auto client = std::make_unique<TairAsyncClient>();
     client->setServerAddr(STANDALONE_ADDR);
@@ -133,6 +546,353 @@ TEST_F(StandAloneTest, ASYNC_API_TEST) {
     latch.wait();
 }
 
+TEST_F(StandAloneTest, CONNECTION_POOL_TEST) {
+    for (auto policy : {PoolSelectPolicy::LEAST_INFLIGHT, PoolSelectPolicy::ROUND_ROBIN, PoolSelectPolicy::KEY_STICKY}) {
+        auto client = std::make_unique<TairAsyncClient>();
+        client->setServerAddr(STANDALONE_ADDR);
+        client->setConnectionPoolSize(4);
+        client->setPoolSelectPolicy(policy);
+        ASSERT_TRUE(client->connect().get().isSuccess());
+        ASSERT_TRUE(client->isConnected());
+
+        const int count = 100;
+        CountDownLatch latch(count);
+        for (int i = 0; i < count; ++i) {
+            client->incr("pool_key", [&latch](auto &result) {
+                ASSERT_TRUE(result.isSuccess());
+                latch.countDown();
+            });
+        }
+        latch.wait();
+
+        auto promise = std::make_shared<std::promise<TairResult<std::shared_ptr<std::string>>>>();
+        client->getdel("pool_key", [promise](auto &result) {
+            promise->set_value(result);
+        });
+        auto result = promise->get_future().get();
+        ASSERT_TRUE(result.isSuccess());
+        ASSERT_EQ(std::to_string(count), *result.getValue());
+        client->disconnect();
+        ASSERT_FALSE(client->isConnected());
+    }
+}
+
+TEST_F(StandAloneTest, RELEASE_REQUEST_AFTER_WRITE_TEST) {
+    auto client = std::make_unique<TairAsyncClient>();
+    client->setServerAddr(STANDALONE_ADDR);
+    client->setReleaseRequestAfterWrite(true);
+    ASSERT_TRUE(client->connect().get().isSuccess());
+
+    CountDownLatch latch;
+    client->sendCommand({"set", "key", std::string(1024 * 1024, 'v')}, [&latch](auto *, auto &req, auto &resp) {
+        ASSERT_FALSE(req);
+        ASSERT_TRUE(resp);
+        ASSERT_TRUE(resp->template packet_cast<SimpleStringPacket>());
+        latch.countDown();
+    });
+    latch.wait();
+}
+
+TEST_F(StandAloneTest, LATENCY_STATS_TEST) {
+    auto client = std::make_unique<TairAsyncClient>();
+    client->setServerAddr(STANDALONE_ADDR);
+    client->setConnectionPoolSize(2);
+    client->setReleaseRequestAfterWrite(true);
+    ASSERT_TRUE(client->connect().get().isSuccess());
+    ASSERT_EQ(0U, client->getStats().total.count);
+
+    CountDownLatch latch(150);
+    for (int i = 0; i < 50; ++i) {
+        client->sendCommand({"set", "key", "value"}, [&latch](auto *, auto &, auto &) {
+            latch.countDown();
+        });
+    }
+    for (int i = 0; i < 100; ++i) {
+        // Names are merged case insensitively
+        client->sendCommand({i % 2 ? "GET" : "get", "key"}, [&latch](auto *, auto &, auto &) {
+            latch.countDown();
+        });
+    }
+    latch.wait();
+
+    auto stats = client->getStats();
+    ASSERT_EQ(150U, stats.total.count);
+    ASSERT_EQ(2U, stats.commands.size());
+    ASSERT_EQ(50U, stats.commands["set"].count);
+    ASSERT_EQ(100U, stats.commands["get"].count);
+    ASSERT_EQ(150U, stats.nodes[STANDALONE_ADDR].count);
+    auto &get = stats.commands["get"];
+    ASSERT_LE(get.p50_us, get.p99_us);
+    ASSERT_LE(get.p99_us, get.p999_us);
+    ASSERT_LE(get.p999_us, (double)get.max_us);
+    ASSERT_LE(get.avg_us, get.max_us);
+    ASSERT_GE(get.sum_us, get.avg_us * get.count);
+    ASSERT_LT(get.sum_us, (get.avg_us + 1) * get.count);
+
+    auto &counters = stats.counters[STANDALONE_ADDR];
+    ASSERT_GE(counters.requests, 150U);
+    ASSERT_EQ(0U, counters.errors);
+    ASSERT_EQ(0U, counters.inflight);
+    MetricSet metrics;
+    TairClientMetrics::collect("test", stats, metrics);
+    std::string text = metrics.toOpenMetrics();
+    ASSERT_NE(std::string::npos, text.find(fmt::format("tair_client_requests_total{{client=\"test\",node=\"{}\"}} {}\n", STANDALONE_ADDR, counters.requests)));
+    ASSERT_NE(std::string::npos, text.find("tair_client_command_latency_seconds_count{client=\"test\",command=\"get\"} 100\n"));
+    client->destroy();
+}
+
+TEST_F(StandAloneTest, HOT_KEY_TEST) {
+    auto client = std::make_unique<TairAsyncClient>();
+    client->setServerAddr(STANDALONE_ADDR);
+    client->setReleaseRequestAfterWrite(true);
+    client->setHotKeys({.sample_rate = 2, .top_k = 4, .window_ms = 60 * 1000});
+    ASSERT_TRUE(client->connect().get().isSuccess());
+    ASSERT_TRUE(client->getHotKeys().by_count.empty());
+
+    // A key longer than the reported 128 bytes still reports the slot of all of it
+    std::string warm(200, 'w');
+    CountDownLatch latch(210);
+    for (int i = 0; i < 100; ++i) {
+        client->sendCommand({"get", "hot"}, [&latch](auto *, auto &, auto &) {
+            latch.countDown();
+        });
+    }
+    for (int i = 0; i < 60; ++i) {
+        client->sendCommand({"get", warm}, [&latch](auto *, auto &, auto &) {
+            latch.countDown();
+        });
+    }
+    for (int i = 0; i < 50; ++i) {
+        client->sendCommand({"get", "cold" + std::to_string(i)}, [&latch](auto *, auto &, auto &) {
+            latch.countDown();
+        });
+    }
+    latch.wait();
+
+    auto report = client->getHotKeys();
+    ASSERT_EQ(4U, report.by_count.size());
+    ASSERT_LE(report.window_start_us, report.window_end_us);
+    // Every other request is sampled, counts are scaled back
+    auto &hot = report.by_count[0];
+    ASSERT_EQ("hot", hot.key);
+    ASSERT_EQ(100U, hot.count);
+    ASSERT_EQ(KeyHash::keyHashSlot(std::string("hot")), hot.slot);
+    ASSERT_EQ(STANDALONE_ADDR, hot.node);
+    ASSERT_GT(hot.bytes, 100U * 20);
+    // The long key carries the most bytes
+    ASSERT_EQ("hot", report.by_bytes[1].key);
+    ASSERT_EQ(hot.bytes, report.by_bytes[1].bytes);
+    ASSERT_EQ(warm.substr(0, 128), report.by_count[1].key);
+    ASSERT_EQ(60U, report.by_count[1].count);
+    ASSERT_EQ(KeyHash::keyHashSlot(warm), report.by_count[1].slot);
+    ASSERT_EQ(report.by_count[1].key, report.by_bytes[0].key);
+    ASSERT_EQ(report.by_count[1].slot, report.by_bytes[0].slot);
+    ASSERT_LE(report.by_count[2].count, 2U * 2);
+    client->destroy();
+}
+
+TEST_F(StandAloneTest, BIG_KEY_TEST) {
+    auto client = std::make_unique<TairAsyncClient>();
+    client->setServerAddr(STANDALONE_ADDR);
+    client->setReleaseRequestAfterWrite(true);
+    client->setBigKeys({.reply_threshold_bytes = 1024, .request_threshold_bytes = 1024, .sample_rate = 1, .top_k = 2});
+    ASSERT_TRUE(client->connect().get().isSuccess());
+    ASSERT_TRUE(client->getBigKeys().largest.empty());
+
+    // Reported cut at 128 bytes, with the slot of the whole key
+    std::string medium(200, 'm');
+    CountDownLatch latch(5);
+    auto done = [&latch](auto *, auto &, auto &) {
+        latch.countDown();
+    };
+    client->sendCommand({"set", "big", std::string(4096, 'b')}, done);
+    client->sendCommand({"set", medium, std::string(2048, 'm')}, done);
+    client->sendCommand({"set", "small", "s"}, done);
+    client->sendCommand({"get", "big"}, done);
+    client->sendCommand({"get", "small"}, done);
+    latch.wait();
+
+    auto report = client->getBigKeys();
+    auto &set = report.commands["set"];
+    ASSERT_EQ(3U, set.count);
+    ASSERT_GT(set.max_request_bytes, 2048U);
+    ASSERT_EQ(2U, set.big_requests);
+    ASSERT_EQ(0U, set.big_replies);
+    auto &get = report.commands["get"];
+    ASSERT_EQ(2U, get.count);
+    ASSERT_GT(get.max_reply_bytes, 4096U);
+    ASSERT_LT(get.max_request_bytes, 1024U);
+    ASSERT_EQ(1U, get.big_replies);
+    // The set of "big" carries more bytes than its get, "small" never made it in
+    ASSERT_EQ(2U, report.largest.size());
+    ASSERT_EQ("big", report.largest[0].key);
+    ASSERT_EQ("set", report.largest[0].command);
+    ASSERT_EQ(STANDALONE_ADDR, report.largest[0].node);
+    ASSERT_EQ(KeyHash::keyHashSlot(std::string("big")), report.largest[0].slot);
+    ASSERT_GT(report.largest[0].request_bytes, 4096U);
+    ASSERT_EQ(5U, report.largest[0].reply_bytes); // +OK
+    ASSERT_EQ(medium.substr(0, 128), report.largest[1].key);
+    ASSERT_EQ(KeyHash::keyHashSlot(medium), report.largest[1].slot);
+    ASSERT_EQ("set", report.largest[1].command);
+    client->destroy();
+}
+
+TEST_F(StandAloneTest, SLOT_LOAD_TEST) {
+    auto client = std::make_unique<TairAsyncClient>();
+    client->setServerAddr(STANDALONE_ADDR);
+    client->setReleaseRequestAfterWrite(true);
+    client->setSlotLoad(true);
+    ASSERT_TRUE(client->connect().get().isSuccess());
+
+    CountDownLatch latch(31);
+    auto done = [&latch](auto *, auto &, auto &) {
+        latch.countDown();
+    };
+    for (int i = 0; i < 20; ++i) {
+        client->sendCommand({"get", "load_a"}, done);
+    }
+    for (int i = 0; i < 10; ++i) {
+        client->sendCommand({"get", "load_b"}, done);
+    }
+    client->sendCommand({"ping"}, done);
+    latch.wait();
+
+    auto report = client->getLoad();
+    int slot_a = KeyHash::keyHashSlot(std::string("load_a"));
+    int slot_b = KeyHash::keyHashSlot(std::string("load_b"));
+    // Keyless commands are left out of the slots
+    ASSERT_EQ(2U, report.slots.size());
+    auto &a = report.slots[slot_a < slot_b ? 0 : 1];
+    auto &b = report.slots[slot_a < slot_b ? 1 : 0];
+    ASSERT_EQ(slot_a, a.slot);
+    ASSERT_EQ(STANDALONE_ADDR, a.node);
+    ASSERT_EQ(20U, a.requests);
+    ASSERT_GT(a.request_bytes, 20U * 20);
+    ASSERT_GT(a.reply_bytes, 0U);
+    ASSERT_EQ(10U, b.requests);
+    auto &node = report.nodes[STANDALONE_ADDR];
+    ASSERT_GE(node.requests, 31U);
+    ASSERT_GT(node.qps, 0);
+    ASSERT_EQ(0, node.error_rate);
+    ASSERT_GT(report.interval_us, 0);
+    std::string dump = TairLoadTracker::dump(report);
+    ASSERT_NE(std::string::npos, dump.find(fmt::format("node {} {} 0 ", STANDALONE_ADDR, node.requests)));
+    ASSERT_NE(std::string::npos, dump.find(fmt::format("slot {} {} 20 {} {}\n", slot_a, STANDALONE_ADDR, a.request_bytes, a.reply_bytes)));
+
+    // Nothing sent since, rates drop while the totals stay
+    report = client->getLoad();
+    ASSERT_EQ(0, report.nodes[STANDALONE_ADDR].qps);
+    ASSERT_EQ(20U, report.slots[slot_a < slot_b ? 0 : 1].requests);
+    client->destroy();
+}
+
+TEST_F(StandAloneTest, LAZY_CONNECT_TEST) {
+    auto lazy_client = std::make_unique<TairClient>();
+    TairURI uri = TairURI::create()
+                      .type(TairURI::STANDALONE)
+                      .serverAddrs({STANDALONE_ADDR})
+                      .lazyConnect(true)
+                      .build();
+    ASSERT_TRUE(lazy_client->init(uri).isSuccess());
+
+    // The first request opens the connection, the second one queues behind it
+    auto wrapper = lazy_client->getFutureWrapper();
+    auto set_future = wrapper.set("lazy_key", "value");
+    auto get_future = wrapper.get("lazy_key");
+    ASSERT_TRUE(set_future.get().isSuccess());
+    auto result = get_future.get();
+    ASSERT_TRUE(result.isSuccess());
+    ASSERT_EQ("value", *result.getValue());
+    ASSERT_TRUE(wrapper.del("lazy_key").get().isSuccess());
+    lazy_client->destroy();
+}
+
+TEST_F(StandAloneTest, HANDSHAKE_TEST) {
+    auto client = std::make_unique<TairAsyncClient>();
+    client->setServerAddr(STANDALONE_ADDR);
+    client->setDatabase(1);
+    client->setFastOpen(true);
+    ASSERT_EQ(-1, client->getConnectLatencyUs());
+    auto set = [](TairAsyncClient &async_client, const std::string &value) {
+        auto promise = std::make_shared<std::promise<TairResult<std::string>>>();
+        async_client.set("handshake_key", value, [promise](auto &result) { promise->set_value(result); });
+        return promise->get_future();
+    };
+    // Sent while the handshake is still in flight, so it must wait for SELECT
+    auto connect_future = client->connect();
+    auto set_future = set(*client, "db1");
+    ASSERT_TRUE(connect_future.get().isSuccess());
+    ASSERT_GT(client->getConnectLatencyUs(), 0);
+    ASSERT_TRUE(set_future.get().isSuccess());
+
+    auto promise = std::make_shared<std::promise<TairResult<std::shared_ptr<std::string>>>>();
+    client->get("handshake_key", [promise](auto &result) { promise->set_value(result); });
+    auto result = promise->get_future().get();
+    ASSERT_TRUE(result.isSuccess());
+    ASSERT_EQ("db1", *result.getValue());
+    auto db0 = this->client->getFutureWrapper();
+    result = db0.get("handshake_key").get();
+    ASSERT_TRUE(result.isSuccess());
+    ASSERT_FALSE(result.getValue());
+    client->destroy();
+
+    // A rejected SELECT fails connect() and the requests held for it, nothing runs against db 0
+    auto bad_client = std::make_unique<TairAsyncClient>();
+    bad_client->setServerAddr(STANDALONE_ADDR);
+    bad_client->setDatabase(100000);
+    auto bad_connect = bad_client->connect();
+    auto held = set(*bad_client, "db0");
+    ASSERT_FALSE(bad_connect.get().isSuccess());
+    ASSERT_FALSE(held.get().isSuccess());
+    ASSERT_FALSE(set(*bad_client, "db0").get().isSuccess());
+    ASSERT_FALSE(bad_client->isConnected());
+    ASSERT_FALSE(db0.get("handshake_key").get().getValue());
+    bad_client->destroy();
+}
+
+TEST_F(StandAloneTest, GET_TO_SINK_TEST) {
+    auto wrapper = client->getFutureWrapper();
+    std::string value(4 * 1024 * 1024, 'v');
+    ASSERT_TRUE(wrapper.set("key", value).get().isSuccess());
+
+    std::string received;
+    auto result = wrapper.getToSink("key", [&received](const char *data, size_t len) {
+                             received.append(data, len);
+                             return true;
+                         })
+                      .get();
+    ASSERT_TRUE(result.isSuccess());
+    ASSERT_EQ((int64_t)value.size(), *result.getValue());
+    ASSERT_EQ(value, received);
+
+    std::vector<char> small(1024);
+    result = wrapper.getToSink("key", TairSink::toBuffer(small.data(), small.size())).get();
+    ASSERT_FALSE(result.isSuccess());
+    // The connection stays usable after the sink gives up
+    auto result_get = wrapper.get("key").get();
+    ASSERT_TRUE(result_get.isSuccess());
+    ASSERT_EQ(value, *result_get.getValue());
+
+    FILE *file = tmpfile();
+    ASSERT_TRUE(file);
+    result = wrapper.getToSink("key", TairSink::toFd(fileno(file))).get();
+    ASSERT_TRUE(result.isSuccess());
+    ASSERT_EQ((off_t)value.size(), lseek(fileno(file), 0, SEEK_END));
+    fclose(file);
+    // A pipe could block the shared IO thread, so it is refused
+    int fds[2];
+    ASSERT_EQ(0, pipe(fds));
+    result = wrapper.getToSink("key", TairSink::toFd(fds[1])).get();
+    ASSERT_FALSE(result.isSuccess());
+    close(fds[0]);
+    close(fds[1]);
+
+    ASSERT_TRUE(wrapper.del("key").get().isSuccess());
+    result = wrapper.getToSink("key", TairSink::toBuffer(small.data(), small.size())).get();
+    ASSERT_TRUE(result.isSuccess());
+    ASSERT_FALSE(result.getValue());
+}
+
 TEST_F(StandAloneTest, SYNC_API_TEST) {
     auto wrapper = client->getFutureWrapper();
 
@@ -144,6 +904,13 @@ TEST_F(StandAloneTest, SYNC_API_TEST) {
     ASSERT_TRUE(result_get.isSuccess());
     ASSERT_EQ("value", *(result_get.getValue()));
 
+    // Large enough to be written from the shared value itself
+    auto shared_value = std::make_shared<const std::string>(1024 * 1024, 'v');
+    ASSERT_TRUE(wrapper.set("key", shared_value).get().isSuccess());
+    result_get = wrapper.get("key").get();
+    ASSERT_TRUE(result_get.isSuccess());
+    ASSERT_EQ(*shared_value, *(result_get.getValue()));
+
     auto result_del = wrapper.del("key").get();
     ASSERT_TRUE(result_del.isSuccess());
     ASSERT_EQ(1, result_del.getValue());
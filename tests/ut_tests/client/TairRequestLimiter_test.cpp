@@ -0,0 +1,131 @@
+/*
+ *  Copyright (c) 2023 Tair
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "common/ClockTime.hpp"
+#include "client/TairRequestLimiter.hpp"
+
+using tair::common::ClockTime;
+using tair::client::LimitPolicy;
+using tair::client::RequestLimits;
+using tair::client::TairRequestLimiter;
+
+TEST(REQUEST_LIMITER_TEST, FAIL_FAST_TEST) {
+    RequestLimits limits;
+    limits.max_inflight = 2;
+    limits.max_inflight_bytes = 100;
+    TairRequestLimiter limiter(limits);
+    ASSERT_TRUE(limiter.acquire(10, true));
+    ASSERT_TRUE(limiter.acquire(10, true));
+    ASSERT_FALSE(limiter.acquire(10, true));
+    limiter.release(10, 0);
+    ASSERT_EQ(1U, limiter.getInflight());
+
+    // The byte cap lets one oversized request through alone, not next to others
+    ASSERT_FALSE(limiter.acquire(200, true));
+    limiter.release(10, 0);
+    ASSERT_TRUE(limiter.acquire(200, true));
+    ASSERT_FALSE(limiter.acquire(1, true));
+    limiter.release(200, 0);
+    ASSERT_EQ(0U, limiter.getInflight());
+}
+
+TEST(REQUEST_LIMITER_TEST, BLOCK_TEST) {
+    RequestLimits limits;
+    limits.max_inflight = 1;
+    limits.policy = LimitPolicy::BLOCK;
+    TairRequestLimiter limiter(limits);
+    ASSERT_TRUE(limiter.acquire(0, true));
+    // The loop thread never waits
+    ASSERT_FALSE(limiter.acquire(0, false));
+
+    std::atomic_bool admitted = false;
+    std::thread waiter([&]() {
+        admitted = limiter.acquire(0, true);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    ASSERT_FALSE(admitted);
+    limiter.release(0, 0);
+    waiter.join();
+    ASSERT_TRUE(admitted);
+    limiter.release(0, 0);
+}
+
+TEST(REQUEST_LIMITER_TEST, BACKPRESSURE_TEST) {
+    std::vector<bool> events;
+    RequestLimits limits;
+    limits.max_inflight = 1;
+    limits.policy = LimitPolicy::BACKPRESSURE;
+    limits.backpressure_callback = [&events](bool overloaded) {
+        events.push_back(overloaded);
+    };
+    TairRequestLimiter limiter(limits);
+    ASSERT_TRUE(limiter.acquire(0, true));
+    ASSERT_TRUE(limiter.acquire(0, true));
+    ASSERT_TRUE(limiter.acquire(0, true));
+    ASSERT_EQ(std::vector<bool>({true}), events);
+    limiter.release(0, 0);
+    limiter.release(0, 0);
+    // Still at the cap, room opens only with the last release
+    ASSERT_EQ(std::vector<bool>({true}), events);
+    limiter.release(0, 0);
+    ASSERT_EQ(std::vector<bool>({true, false}), events);
+}
+
+TEST(REQUEST_LIMITER_TEST, QPS_TEST) {
+    RequestLimits limits;
+    limits.max_qps = 100;
+    limits.policy = LimitPolicy::BLOCK;
+    TairRequestLimiter limiter(limits);
+    // The first second of tokens is a burst, the next 20 requests are paced at 100/s
+    int64_t start_ms = ClockTime::intervalMs();
+    for (int i = 0; i < 120; ++i) {
+        ASSERT_TRUE(limiter.acquire(0, true));
+        limiter.release(0, 0);
+    }
+    ASSERT_GE(ClockTime::intervalMs() - start_ms, 150);
+}
+
+TEST(REQUEST_LIMITER_TEST, AIMD_TEST) {
+    RequestLimits limits;
+    limits.max_inflight = 100;
+    limits.target_latency_us = 1000;
+    TairRequestLimiter limiter(limits);
+    ASSERT_EQ(100U, limiter.getConcurrencyLimit());
+    // Slow replies cut the cap, at most once per round trip
+    ASSERT_TRUE(limiter.acquire(0, true));
+    limiter.release(0, 5000);
+    ASSERT_EQ(90U, limiter.getConcurrencyLimit());
+    ASSERT_TRUE(limiter.acquire(0, true));
+    limiter.release(0, 5000);
+    ASSERT_EQ(90U, limiter.getConcurrencyLimit());
+    // Fast replies grow it back by about one per window
+    for (int i = 0; i < 200; ++i) {
+        ASSERT_TRUE(limiter.acquire(0, true));
+        limiter.release(0, 100);
+    }
+    ASSERT_EQ(92U, limiter.getConcurrencyLimit());
+}
@@ -0,0 +1,130 @@
+/*
+ *  Copyright (c) 2023 Tair
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "common/statistics/HdrHistogram.hpp"
+
+using tair::common::HdrHistogram;
+using tair::common::ThreadLocalHdrHistogram;
+
+TEST(HDR_HISTOGRAM_TEST, BUCKET_TEST) {
+    HdrHistogram histogram(3600UL * 1000 * 1000, 0.01);
+    // Small values are exact
+    for (uint64_t v = 0; v < 256; ++v) {
+        ASSERT_EQ(v, histogram.lowestEquivalent(v));
+        ASSERT_EQ(v, histogram.highestEquivalent(v));
+    }
+    // Above that a bucket never spans more than 1% of its values
+    for (uint64_t v = 256; v < 100000000; v = v * 3 / 2 + 7) {
+        uint64_t lowest = histogram.lowestEquivalent(v);
+        uint64_t highest = histogram.highestEquivalent(v);
+        ASSERT_LE(lowest, v);
+        ASSERT_GE(highest, v);
+        ASSERT_LE(highest - lowest + 1, lowest / 100 + 1);
+        ASSERT_EQ(highest + 1, histogram.lowestEquivalent(highest + 1));
+    }
+}
+
+TEST(HDR_HISTOGRAM_TEST, PERCENTILE_TEST) {
+    HdrHistogram histogram;
+    for (uint64_t v = 1; v <= 100000; ++v) {
+        histogram.record(v);
+    }
+    ASSERT_EQ(100000U, histogram.getCount());
+    ASSERT_EQ(1U, histogram.getMin());
+    ASSERT_EQ(100000U, histogram.getMax());
+    ASSERT_EQ(50000U, histogram.getMean());
+    ASSERT_NEAR(50000, histogram.getValueAtPercentile(50), 500);
+    ASSERT_NEAR(99000, histogram.getValueAtPercentile(99), 990);
+    ASSERT_NEAR(99900, histogram.getValueAtPercentile(99.9), 999);
+    ASSERT_EQ(100000U, histogram.getValueAtPercentile(100));
+
+    // Out of range values land in the last bucket but keep the exact max
+    histogram.record(UINT64_MAX / 4);
+    ASSERT_EQ(UINT64_MAX / 4, histogram.getMax());
+
+    histogram.reset();
+    ASSERT_EQ(0U, histogram.getCount());
+    ASSERT_EQ(0U, histogram.getMin());
+    ASSERT_EQ(0U, histogram.getValueAtPercentile(99));
+}
+
+TEST(HDR_HISTOGRAM_TEST, MERGE_TEST) {
+    HdrHistogram a, b;
+    a.record(10, 3);
+    b.recordSingleWriter(1000);
+    b.recordSingleWriter(5);
+    ASSERT_TRUE(a.merge(b));
+    ASSERT_EQ(5U, a.getCount());
+    ASSERT_EQ(5U, a.getMin());
+    ASSERT_EQ(1000U, a.getMax());
+    ASSERT_EQ(1035U, a.getSum());
+
+    HdrHistogram other_layout(1000, 0.1);
+    ASSERT_FALSE(a.merge(other_layout));
+}
+
+TEST(HDR_HISTOGRAM_TEST, SERIALIZE_TEST) {
+    HdrHistogram histogram(60UL * 1000 * 1000, 0.001);
+    for (uint64_t v = 1; v < 10000000; v = v * 5 / 4 + 1) {
+        histogram.record(v, v % 7 + 1);
+    }
+    auto data = histogram.serialize();
+    auto restored = HdrHistogram::deserialize(data);
+    ASSERT_TRUE(restored);
+    ASSERT_EQ(histogram.getPrecision(), restored->getPrecision());
+    ASSERT_EQ(histogram.getBucketCount(), restored->getBucketCount());
+    ASSERT_EQ(histogram.getCount(), restored->getCount());
+    ASSERT_EQ(histogram.getMin(), restored->getMin());
+    ASSERT_EQ(histogram.getMax(), restored->getMax());
+    ASSERT_EQ(histogram.getSum(), restored->getSum());
+    for (double perc : {1.0, 50.0, 90.0, 99.0, 99.99}) {
+        ASSERT_EQ(histogram.getValueAtPercentile(perc), restored->getValueAtPercentile(perc));
+    }
+    ASSERT_EQ(data, restored->serialize());
+
+    ASSERT_FALSE(HdrHistogram::deserialize(""));
+    ASSERT_FALSE(HdrHistogram::deserialize("HDR0"));
+    ASSERT_FALSE(HdrHistogram::deserialize(data.substr(0, data.size() - 1)));
+}
+
+TEST(HDR_HISTOGRAM_TEST, THREAD_LOCAL_TEST) {
+    ThreadLocalHdrHistogram histogram;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&histogram, t] {
+            for (uint64_t v = 1; v <= 10000; ++v) {
+                histogram.record(v * (t + 1));
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    auto snapshot = histogram.snapshot();
+    ASSERT_EQ(40000U, snapshot->getCount());
+    ASSERT_EQ(1U, snapshot->getMin());
+    ASSERT_EQ(40000U, snapshot->getMax());
+}
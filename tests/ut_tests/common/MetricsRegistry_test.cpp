@@ -0,0 +1,84 @@
+/*
+ *  Copyright (c) 2023 Tair
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "common/statistics/HdrHistogram.hpp"
+#include "common/statistics/MetricsRegistry.hpp"
+
+using tair::common::HdrHistogram;
+using tair::common::MetricSet;
+using tair::common::MetricsRegistry;
+
+TEST(METRICS_REGISTRY_TEST, OPEN_METRICS_TEST) {
+    MetricSet metrics;
+    metrics.addCounter("requests", "Requests sent", {{"node", "a"}}, 3);
+    metrics.addGauge("depth", "", {}, 1.5);
+    // Samples of one family stay together whoever adds them
+    metrics.addCounter("requests", "Requests sent", {{"node", "b\"\\\n"}}, 4);
+    // A name can only have one type
+    metrics.addGauge("requests", "", {}, 1);
+    ASSERT_EQ(2U, metrics.getFamilyCount());
+    ASSERT_EQ("# TYPE depth gauge\n"
+              "depth 1.5\n"
+              "# TYPE requests counter\n"
+              "# HELP requests Requests sent\n"
+              "requests_total{node=\"a\"} 3\n"
+              "requests_total{node=\"b\\\"\\\\\\n\"} 4\n"
+              "# EOF\n",
+              metrics.toOpenMetrics());
+}
+
+TEST(METRICS_REGISTRY_TEST, SUMMARY_TEST) {
+    MetricSet metrics;
+    HdrHistogram histogram(1000000, 0.01);
+    for (uint64_t v = 1; v <= 100; ++v) {
+        histogram.record(v * 1000);
+    }
+    metrics.addLatencySummary("latency_seconds", "", {{"node", "a"}}, histogram);
+    std::string text = metrics.toOpenMetrics();
+    ASSERT_NE(std::string::npos, text.find("# TYPE latency_seconds summary\n"));
+    ASSERT_NE(std::string::npos, text.find("latency_seconds{node=\"a\",quantile=\"0.5\"} 0.05"));
+    ASSERT_NE(std::string::npos, text.find("latency_seconds{node=\"a\",quantile=\"0.999\"} 0.1"));
+    ASSERT_NE(std::string::npos, text.find("latency_seconds_sum{node=\"a\"} 5.05\n"));
+    ASSERT_NE(std::string::npos, text.find("latency_seconds_count{node=\"a\"} 100\n"));
+}
+
+TEST(METRICS_REGISTRY_TEST, COLLECTOR_TEST) {
+    MetricsRegistry registry;
+    ASSERT_EQ("# EOF\n", registry.render());
+    int calls = 0;
+    int64_t id = registry.addCollector([&calls](MetricSet &metrics) {
+        metrics.addCounter("scrapes", "", {}, ++calls);
+    });
+    registry.addCollector(MetricsRegistry::collectProcessMetrics);
+    std::string text = registry.render();
+    ASSERT_NE(std::string::npos, text.find("scrapes_total 1\n"));
+    ASSERT_NE(std::string::npos, text.find("tair_memory_rss_bytes "));
+    ASSERT_NE(std::string::npos, text.find("tair_process_cpu_seconds_total{mode=\"user\"} "));
+
+    registry.removeCollector(id);
+    text = registry.render();
+    ASSERT_EQ(std::string::npos, text.find("scrapes_total"));
+    ASSERT_EQ(1, calls);
+}
@@ -0,0 +1,106 @@
+/*
+ *  Copyright (c) 2023 Tair
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+#include "gtest/gtest.h"
+
+#include <array>
+#include <memory>
+#include <string>
+
+#include "common/MoveOnlyFunction.hpp"
+#include "common/RingQueue.hpp"
+
+using tair::common::MoveOnlyFunction;
+using tair::common::RingQueue;
+
+TEST(MOVE_ONLY_FUNCTION_TEST, INLINE_AND_HEAP_TEST) {
+    using Func = MoveOnlyFunction<int(int)>;
+
+    Func empty;
+    ASSERT_FALSE(empty);
+    std::function<int(int)> empty_std;
+    Func from_empty_std(empty_std);
+    ASSERT_FALSE(from_empty_std);
+
+    int base = 10;
+    Func small([base](int x) { return base + x; });
+    ASSERT_TRUE(small);
+    ASSERT_EQ(15, small(5));
+
+    std::array<int64_t, 16> big {};
+    big[15] = 100;
+    static_assert(!Func::storedInline<std::array<int64_t, 16>>());
+    Func large([big](int x) { return (int)big[15] + x; });
+    ASSERT_EQ(101, large(1));
+
+    Func moved(std::move(large));
+    ASSERT_FALSE(large);
+    ASSERT_EQ(102, moved(2));
+
+    moved = std::move(small);
+    ASSERT_EQ(11, moved(1));
+    moved = nullptr;
+    ASSERT_FALSE(moved);
+}
+
+TEST(MOVE_ONLY_FUNCTION_TEST, MOVE_ONLY_CAPTURE_TEST) {
+    auto value = std::make_unique<std::string>("value");
+    MoveOnlyFunction<std::string()> func([value = std::move(value)]() { return *value; });
+    MoveOnlyFunction<std::string()> other = std::move(func);
+    ASSERT_EQ("value", other());
+
+    // The captured object is destroyed with the function
+    std::weak_ptr<int> weak;
+    {
+        auto shared = std::make_shared<int>(1);
+        weak = shared;
+        MoveOnlyFunction<int()> holder([shared]() { return *shared; });
+        shared.reset();
+        ASSERT_FALSE(weak.expired());
+    }
+    ASSERT_TRUE(weak.expired());
+}
+
+TEST(RING_QUEUE_TEST, GROW_AND_WRAP_TEST) {
+    RingQueue<std::unique_ptr<int>> queue(4);
+    ASSERT_EQ(4, queue.capacity());
+    ASSERT_TRUE(queue.empty());
+
+    int next_push = 0, next_pop = 0;
+    for (int round = 0; round < 10; ++round) {
+        for (int i = 0; i < 3; ++i) {
+            queue.emplace_back(std::make_unique<int>(next_push++));
+        }
+        for (int i = 0; i < 2; ++i) {
+            auto value = std::move(queue.front());
+            queue.pop_front();
+            ASSERT_EQ(next_pop++, *value);
+        }
+    }
+    ASSERT_EQ(10, queue.size());
+    ASSERT_EQ(16, queue.capacity());
+    ASSERT_EQ(next_pop, *queue[0]);
+    while (!queue.empty()) {
+        ASSERT_EQ(next_pop++, *queue.front());
+        queue.pop_front();
+    }
+    ASSERT_EQ(next_push, next_pop);
+}
@@ -0,0 +1,76 @@
+/*
+ *  Copyright (c) 2023 Tair
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+#include <map>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "common/statistics/TopKSketch.hpp"
+
+using tair::common::TopKSketch;
+
+TEST(TOP_K_SKETCH_TEST, HEAVY_HITTER_TEST) {
+    TopKSketch sketch(4, 256, 4);
+    std::map<std::string, uint64_t> counts;
+    // A few heavy keys in a long tail far wider than the sketch
+    for (int round = 0; round < 20; ++round) {
+        for (int i = 0; i < 1000; ++i) {
+            std::string key = "tail" + std::to_string(round * 1000 + i);
+            sketch.add(key);
+            counts[key]++;
+        }
+        for (int heavy = 0; heavy < 3; ++heavy) {
+            std::string key = "heavy" + std::to_string(heavy);
+            sketch.add(key, 100 * (heavy + 1));
+            counts[key] += 100 * (heavy + 1);
+        }
+    }
+    for (const auto &[key, count] : counts) {
+        ASSERT_GE(sketch.estimate(key), count);
+    }
+    auto top = sketch.getTopK();
+    ASSERT_EQ(4U, top.size());
+    ASSERT_EQ("heavy2", top[0].first);
+    ASSERT_EQ("heavy1", top[1].first);
+    ASSERT_EQ("heavy0", top[2].first);
+    // Conservative update keeps the heavy estimates close
+    ASSERT_LE(top[0].second, counts["heavy2"] * 11 / 10);
+
+    sketch.clear();
+    ASSERT_TRUE(sketch.getTopK().empty());
+    ASSERT_EQ(0U, sketch.estimate("heavy2"));
+}
+
+TEST(TOP_K_SKETCH_TEST, EVICTION_TEST) {
+    TopKSketch sketch(2);
+    sketch.add("a", 5);
+    sketch.add("b", 3);
+    // Not heavier than the lightest tracked key, stays out
+    sketch.add("c", 3);
+    ASSERT_EQ(2U, sketch.getTopK().size());
+    ASSERT_EQ("b", sketch.getTopK()[1].first);
+    sketch.add("c", 1);
+    auto top = sketch.getTopK();
+    ASSERT_EQ("a", top[0].first);
+    ASSERT_EQ("c", top[1].first);
+    ASSERT_EQ(4U, top[1].second);
+}
@@ -23,9 +23,18 @@
 
 #include <climits>
 
+#include "common/CountDownLatch.hpp"
 #include "network/Buffer.hpp"
+#include "network/BufferPool.hpp"
+#include "network/EventLoopThread.hpp"
+#include "network/NetworkStat.hpp"
 
+using tair::common::CountDownLatch;
 using tair::network::Buffer;
+using tair::network::BufferPool;
+using tair::network::EventLoop;
+using tair::network::EventLoopThread;
+using tair::network::NetworkStat;
 
 TEST(BUFFER_TEST, ONLY_TEST) {
     Buffer buffer(Buffer::GENERAL_BUFFER, 2, 0);
@@ -462,4 +471,38 @@ TEST(BUFFER_TEST, TO_DEBUG_STRING_TEST) {
     ASSERT_EQ("ridx: 2, widx: 9, data: test_data", buf.toDebugString(9));
     ASSERT_EQ("ridx: 2, widx: 9, data: test_data", buf.toDebugString(10));
     ASSERT_EQ("ridx: 2, widx: 9, data: test_data", buf.toDebugString(1024));
-}
\ No newline at end of file
+}
+
+TEST(BUFFER_TEST, TEST_BUFFER_POOL) {
+    ASSERT_EQ(100U, BufferPool::blockSize(100));
+    ASSERT_EQ(BufferPool::kMinClassSize, BufferPool::blockSize(Buffer::kInitialSize + Buffer::kCheapPrependSize));
+    ASSERT_EQ(64U * 1024, BufferPool::blockSize(40 * 1024));
+    ASSERT_EQ(BufferPool::kMaxClassSize + 1, BufferPool::blockSize(BufferPool::kMaxClassSize + 1));
+
+    EventLoopThread thread("buffer-pool");
+    thread.start();
+    CountDownLatch latch;
+    thread.loop()->runInLoop([&](EventLoop *) {
+        {
+            Buffer buf;
+            buf.ensureWritableBytes(100 * 1024);
+            // grow uses the whole pooled block
+            ASSERT_EQ(BufferPool::blockSize(buf.capacity()), buf.capacity());
+        }
+        int64_t cached = NetworkStat::getBufferPoolCachedSize();
+        int64_t hit = NetworkStat::getBufferPoolHit();
+        ASSERT_GT(cached, 0);
+        {
+            Buffer buf;
+            buf.ensureWritableBytes(100 * 1024);
+            buf.append(std::string(100 * 1024, 'x'));
+            buf.retrieve(buf.length());
+            buf.reinit();
+        }
+        ASSERT_GT(NetworkStat::getBufferPoolHit(), hit);
+        latch.countDown();
+    });
+    latch.wait();
+    thread.stop();
+    thread.join();
+}
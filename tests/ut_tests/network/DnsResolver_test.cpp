@@ -21,11 +21,13 @@
  */
 #include "gtest/gtest.h"
 
+#include "network/DnsCache.hpp"
 #include "network/DnsResolver.hpp"
 #include "network/EventLoopThread.hpp"
 
 using tair::network::EventLoop;
 using tair::network::EventLoopThread;
+using tair::network::DnsCache;
 using tair::network::DnsResolver;
 using tair::network::Duration;
 
@@ -55,3 +57,48 @@ TEST(DNS_RESOLVER_TEST, ONLY_TEST) {
     });
     loop_thread.join();
 }
+
+TEST(DNS_RESOLVER_TEST, CACHE_TEST) {
+    EventLoopThread loop_thread;
+    loop_thread.start();
+    EventLoop *loop = loop_thread.loop();
+    ASSERT_TRUE(loop != nullptr);
+
+    auto &cache = DnsCache::instance();
+    cache.clear();
+    uint64_t lookups = cache.getLookupCount();
+    std::atomic_int answered = 0;
+    loop->runInLoop([&](EventLoop *) {
+        // Concurrent misses share one lookup, failures are cached too
+        for (int i = 0; i < 3; ++i) {
+            cache.resolve(loop, "localhost", Duration(100 * Duration::kMillisecond), [&](int errcode, const std::vector<std::string> &addrs) {
+                ASSERT_EQ(0, errcode);
+                ASSERT_EQ("127.0.0.1", addrs[0]);
+                answered++;
+            });
+            cache.resolve(loop, "error.addr", Duration(100 * Duration::kMillisecond), [&](int errcode, const std::vector<std::string> &addrs) {
+                ASSERT_NE(0, errcode);
+                ASSERT_TRUE(addrs.empty());
+                answered++;
+            });
+        }
+    });
+    loop->runAfterTimer(Duration(200 * Duration::kMillisecond), [&](EventLoop *) {
+        ASSERT_EQ(6, answered);
+        ASSERT_EQ(lookups + 2, cache.getLookupCount());
+        // Hits are answered in place without another lookup
+        bool hit = false;
+        cache.resolve(loop, "localhost", Duration(100 * Duration::kMillisecond), [&](int errcode, const std::vector<std::string> &) {
+            hit = errcode == 0;
+        });
+        cache.resolve(loop, "error.addr", Duration(100 * Duration::kMillisecond), [&](int errcode, const std::vector<std::string> &) {
+            ASSERT_NE(0, errcode);
+        });
+        ASSERT_TRUE(hit);
+        ASSERT_EQ(lookups + 2, cache.getLookupCount());
+        ASSERT_EQ(2, cache.size());
+        loop_thread.stop();
+    });
+    loop_thread.join();
+    cache.clear();
+}
@@ -0,0 +1,109 @@
+/*
+ *  Copyright (c) 2023 Tair
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+#include <chrono>
+#include <thread>
+
+#include "common/CountDownLatch.hpp"
+#include "network/EventLoopThreadPool.hpp"
+
+#include "gtest/gtest.h"
+
+using tair::common::CountDownLatch;
+using tair::network::Duration;
+using tair::network::EventLoop;
+using tair::network::EventLoopStats;
+using tair::network::EventLoopThreadPool;
+
+TEST(EVENT_LOOP_TEST, LOOP_STATS_TEST) {
+    EventLoop base_loop("base_loop");
+    EventLoopThreadPool pool(&base_loop, 2, "statsLoopPool");
+    pool.start();
+    EventLoop *loop = pool.getNextLoop();
+
+    // Hold the loop in a task while another one waits behind it
+    CountDownLatch blocked(1), release(1), done(1);
+    loop->queueInLoop([&](EventLoop *) {
+        blocked.countDown();
+        release.wait();
+    });
+    blocked.wait();
+    loop->queueInLoop([&](EventLoop *) {
+        done.countDown();
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EventLoopStats stats = loop->getStats();
+    ASSERT_EQ(1U, stats.loops);
+    ASSERT_EQ(1U, stats.pending_tasks);
+    ASSERT_GE(stats.oldest_task_age_us, 20 * 1000);
+    release.countDown();
+    done.wait();
+
+    CountDownLatch fired(1);
+    loop->runAfterTimer(Duration(10 * Duration::kMillisecond), [&](EventLoop *) {
+        fired.countDown();
+    });
+    fired.wait();
+    // Let the loop go back to sleep so the busy time is counted
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    stats = loop->getStats();
+    ASSERT_EQ(0U, stats.pending_tasks);
+    ASSERT_EQ(0, stats.oldest_task_age_us);
+    ASSERT_GE(stats.tasks, 2U);
+    ASSERT_GE(stats.task_lag_max_us, 20U * 1000);
+    ASSERT_EQ(1U, stats.timers);
+    ASSERT_LT(stats.timer_skew_max_us, 1000U * 1000);
+    ASSERT_GT(stats.iterations, 0U);
+    ASSERT_GE(stats.busy_ns, 20L * 1000 * 1000);
+    ASSERT_GT(stats.idle_ns, 0);
+    ASSERT_GT(stats.utilization, 0);
+    ASSERT_LT(stats.utilization, 1);
+    ASSERT_EQ(stats.utilization, stats.max_utilization);
+
+    EventLoopStats total = pool.getLoopStats();
+    ASSERT_EQ(2U, total.loops);
+    ASSERT_GE(total.iterations, stats.iterations);
+    ASSERT_GE(total.busy_ns, stats.busy_ns);
+    ASSERT_GE(total.task_lag_max_us, stats.task_lag_max_us);
+    ASSERT_GE(total.max_utilization, total.utilization);
+
+    // Per loop snapshots diff into the busy share of the interval between them
+    auto before = pool.getPerLoopStats();
+    ASSERT_EQ(2U, before.size());
+    CountDownLatch busy(1);
+    loop->queueInLoop([&](EventLoop *) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        busy.countDown();
+    });
+    busy.wait();
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    auto after = pool.getPerLoopStats();
+    ASSERT_EQ(2U, after.size());
+    int64_t busy_ns = 0;
+    for (size_t i = 0; i < after.size(); ++i) {
+        ASSERT_GE(after[i].busy_ns, before[i].busy_ns);
+        ASSERT_EQ(1U, after[i].loops);
+        busy_ns = std::max(busy_ns, after[i].busy_ns - before[i].busy_ns);
+    }
+    ASSERT_GE(busy_ns, 50L * 1000 * 1000);
+    pool.stop();
+}
@@ -0,0 +1,95 @@
+/*
+ *  Copyright (c) 2023 Tair
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "common/CountDownLatch.hpp"
+#include "common/statistics/MetricsRegistry.hpp"
+#include "network/EventLoopThread.hpp"
+#include "network/MetricsHttpServer.hpp"
+#include "network/NetworkStat.hpp"
+#include "network/TcpClient.hpp"
+#include "network/TcpConnection.hpp"
+
+using tair::common::CountDownLatch;
+using tair::common::MetricSet;
+using tair::common::MetricsRegistry;
+using tair::network::Buffer;
+using tair::network::EventLoop;
+using tair::network::EventLoopThread;
+using tair::network::MetricsHttpServer;
+using tair::network::NetworkStat;
+using tair::network::TcpClient;
+using tair::network::TcpConnectionPtr;
+
+// Sends request and returns everything read until the server closes the connection
+static std::string httpRequest(EventLoop *loop, const std::string &address, const std::string &request) {
+    std::string response;
+    CountDownLatch closed(1);
+    auto client = TcpClient::create(loop, address);
+    client->setAutoReConnect(false);
+    client->setConnectionCallback([&](const TcpConnectionPtr &conn) {
+        if (conn->isConnected()) {
+            conn->send(request);
+        } else {
+            closed.countDown();
+        }
+    });
+    client->setMessageCallback([&response](const TcpConnectionPtr &, Buffer *buf) {
+        response += buf->nextAllString();
+    });
+    client->connect();
+    closed.wait();
+    return response;
+}
+
+TEST(METRICS_HTTP_SERVER_TEST, SCRAPE_TEST) {
+    EventLoopThread loop_thread;
+    loop_thread.start();
+    MetricsRegistry registry;
+    registry.addCollector(NetworkStat::collectMetrics);
+    registry.addCollector([](MetricSet &metrics) {
+        metrics.addGauge("test_value", "", {}, 42);
+    });
+    MetricsHttpServer server(loop_thread.loop(), "tcp://127.0.0.1:0", registry);
+    ASSERT_TRUE(server.start());
+    std::string address = *server.getRealListenIpPorts().begin();
+
+    std::string response = httpRequest(loop_thread.loop(), address, "GET /metrics?x=1 HTTP/1.1\r\nHost: test\r\n\r\n");
+    ASSERT_EQ(0U, response.find("HTTP/1.1 200 OK\r\n"));
+    ASSERT_NE(std::string::npos, response.find("Content-Type: application/openmetrics-text; version=1.0.0; charset=utf-8\r\n"));
+    std::string body = response.substr(response.find("\r\n\r\n") + 4);
+    ASSERT_NE(std::string::npos, response.find("Content-Length: " + std::to_string(body.size()) + "\r\n"));
+    ASSERT_NE(std::string::npos, body.find("test_value 42\n"));
+    ASSERT_NE(std::string::npos, body.find("# TYPE tair_network_output_bytes counter\n"));
+    ASSERT_EQ(body.size() - 6, body.rfind("# EOF\n"));
+
+    response = httpRequest(loop_thread.loop(), address, "GET / HTTP/1.1\r\n\r\n");
+    ASSERT_EQ(0U, response.find("HTTP/1.1 404 Not Found\r\n"));
+    response = httpRequest(loop_thread.loop(), address, "POST /metrics HTTP/1.1\r\n\r\n");
+    ASSERT_EQ(0U, response.find("HTTP/1.1 405 Method Not Allowed\r\n"));
+    response = httpRequest(loop_thread.loop(), address, "HEAD /metrics HTTP/1.1\r\n\r\n");
+    ASSERT_EQ(0U, response.find("HTTP/1.1 200 OK\r\n"));
+    ASSERT_EQ(response.size(), response.find("\r\n\r\n") + 4);
+    server.stop();
+}
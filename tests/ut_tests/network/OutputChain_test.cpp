@@ -0,0 +1,83 @@
+/*
+ *  Copyright (c) 2023 Tair
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+#include "gtest/gtest.h"
+
+#include "network/OutputChain.hpp"
+
+using tair::network::OutputChain;
+
+TEST(OUTPUT_CHAIN_TEST, APPEND_SKIP_TEST) {
+    OutputChain chain;
+    ASSERT_TRUE(chain.empty());
+    chain.append("*1\r\n", 4);
+    chain.append("$5\r\n", 4);
+    // Copied bytes merge into one owned segment
+    ASSERT_EQ(1U, chain.segmentCount());
+
+    auto value = std::make_shared<std::string>("value");
+    std::weak_ptr<std::string> value_ref = value;
+    chain.appendRef(value->data(), value->size(), value);
+    value.reset();
+    chain.append("\r\n", 2);
+    ASSERT_EQ(3U, chain.segmentCount());
+    ASSERT_EQ(15U, chain.length());
+    ASSERT_EQ("*1\r\n$5\r\nvalue\r\n", chain.toString());
+
+    struct iovec iov[OutputChain::kMaxIovecCount];
+    ASSERT_EQ(3, chain.fillIovec(iov, OutputChain::kMaxIovecCount));
+    ASSERT_EQ(8U, iov[0].iov_len);
+    ASSERT_EQ(5U, iov[1].iov_len);
+    ASSERT_EQ(2, chain.fillIovec(iov, 2));
+
+    chain.skip(10);
+    ASSERT_EQ(2U, chain.segmentCount());
+    ASSERT_EQ("lue\r\n", chain.toString());
+    ASSERT_FALSE(value_ref.expired());
+    chain.skip(3);
+    // The referenced block is released as soon as it is written
+    ASSERT_TRUE(value_ref.expired());
+    ASSERT_EQ("\r\n", chain.toString());
+    chain.skip(2);
+    ASSERT_TRUE(chain.empty());
+    ASSERT_EQ(0U, chain.segmentCount());
+}
+
+TEST(OUTPUT_CHAIN_TEST, MOVE_APPEND_TEST) {
+    OutputChain chain1;
+    chain1.append("abc", 3);
+    OutputChain chain2;
+    auto value = std::make_shared<std::string>("def");
+    chain2.appendRef(value->data(), value->size(), value);
+    chain2.append("ghi", 3);
+
+    chain1.append(std::move(chain2));
+    ASSERT_TRUE(chain2.empty());
+    ASSERT_EQ(9U, chain1.length());
+    ASSERT_EQ("abcdefghi", chain1.toString());
+
+    OutputChain chain3;
+    chain3.append(std::move(chain1));
+    ASSERT_TRUE(chain1.empty());
+    ASSERT_EQ("abcdefghi", chain3.toString());
+    chain3.clear();
+    ASSERT_TRUE(chain3.empty());
+}
@@ -23,6 +23,7 @@
 
 #include "network/EventLoop.hpp"
 #include "network/EventLoopThread.hpp"
+#include "network/OutputChain.hpp"
 #include "network/TcpClient.hpp"
 #include "network/TcpConnection.hpp"
 #include "network/TcpServer.hpp"
@@ -35,6 +36,7 @@ using tair::network::TcpClient;
 using tair::network::TcpClientPtr;
 using tair::network::TcpConnectionPtr;
 using tair::network::Buffer;
+using tair::network::OutputChain;
 
 TEST(SERVER_CLIENT_TEST, CONN_TEST) {
     EventLoop loop;
@@ -326,3 +328,192 @@ TEST(SERVER_CLIENT_TEST, OTHER_IO_SEND_BUFFER_MOVE_TEST) {
 
     loop_thread.join();
 }
+
+TEST(SERVER_CLIENT_TEST, SEND_CHAIN_TEST) {
+    EventLoop loop;
+    TcpServer server(&loop, "tcp://127.0.0.1:0", 2, "echo");
+    auto value = std::make_shared<std::string>(8 * 1024 * 1024, 'v');
+    std::string expected = "head" + *value + "tail!";
+    std::string received;
+    server.setMessageCallback([&](const TcpConnectionPtr &conn, Buffer *buf) {
+        received.append(buf->nextAllString());
+        if (received.size() >= expected.size()) {
+            conn->send("done");
+        }
+    });
+    server.setClosedCallback([&]() {
+        loop.stop();
+    });
+
+    ASSERT_TRUE(server.start());
+    std::string address = *server.getRealListenIpPorts().begin();
+
+    std::weak_ptr<const void> value_ref = value;
+    auto client = TcpClient::create(&loop, address);
+    client->setConnectionCallback([&value](const TcpConnectionPtr &conn) {
+        if (conn->isConnected()) {
+            OutputChain chain;
+            chain.append("head", 4);
+            chain.appendRef(value->data(), value->size(), value);
+            chain.append("tail", 4);
+            value.reset();
+            conn->send(std::move(chain));
+            // Plain sends queue behind the pending chain
+            conn->send("!");
+        }
+    });
+    client->setMessageCallback([&](const TcpConnectionPtr &conn, Buffer *buf) {
+        ASSERT_EQ("done", buf->nextAllString());
+        client->disconnect();
+        server.stop();
+    });
+    client->connect();
+
+    loop.runAfterTimer(Duration(10 * Duration::kSecond), [&](EventLoop *) {
+        client->disconnect();
+        server.stop();
+    });
+
+    loop.run();
+    ASSERT_EQ(expected, received);
+    // The referenced block is released once written
+    ASSERT_TRUE(value_ref.expired());
+}
+
+TEST(SERVER_CLIENT_TEST, SEND_ZEROCOPY_TEST) {
+    EventLoop loop;
+    TcpServer server(&loop, "tcp://127.0.0.1:0", 2, "echo");
+    size_t value_size = 8 * 1024 * 1024;
+    size_t received = 0;
+    server.setMessageCallback([&](const TcpConnectionPtr &conn, Buffer *buf) {
+        received += buf->length();
+        buf->reset();
+    });
+    server.setClosedCallback([&]() {
+        loop.stop();
+    });
+
+    ASSERT_TRUE(server.start());
+    std::string address = *server.getRealListenIpPorts().begin();
+
+    auto value = std::make_shared<std::string>(value_size, 'v');
+    std::weak_ptr<const void> value_ref = value;
+    bool write_completed = false;
+    auto client = TcpClient::create(&loop, address);
+    client->setZeroCopyThreshold(64 * 1024);
+    client->setConnectionCallback([&value](const TcpConnectionPtr &conn) {
+        if (conn->isConnected()) {
+            OutputChain chain;
+            chain.appendRef(value->data(), value->size(), value);
+            value.reset();
+            conn->send(std::move(chain));
+        }
+    });
+    client->setWriteCompleteCallback([&](const TcpConnectionPtr &conn) {
+        // Only reported after the kernel released every zero-copy buffer
+        ASSERT_EQ(0U, conn->getZeroCopyPendingCount());
+        ASSERT_TRUE(value_ref.expired());
+        write_completed = true;
+    });
+    client->connect();
+
+    bool stopped = false;
+    auto stop = [&]() {
+        if (!stopped) {
+            stopped = true;
+            client->disconnect();
+            server.stop();
+        }
+    };
+    loop.runEveryTimer(Duration(10 * Duration::kMillisecond), [&](EventLoop *) {
+        if (write_completed && received == value_size) {
+            stop();
+        }
+    });
+    loop.runAfterTimer(Duration(10 * Duration::kSecond), [&](EventLoop *) {
+        stop();
+    });
+
+    loop.run();
+    ASSERT_TRUE(write_completed);
+    ASSERT_EQ(value_size, received);
+}
+
+TEST(SERVER_CLIENT_TEST, HOSTNAME_CONN_TEST) {
+    EventLoop loop;
+    TcpServer server(&loop, "tcp://127.0.0.1:0", 1, "echo");
+    server.setClosedCallback([&]() {
+        loop.stop();
+    });
+    ASSERT_TRUE(server.start());
+    std::string address = *server.getRealListenIpPorts().begin();
+    std::string port = address.substr(address.rfind(':') + 1);
+
+    // Hosts go through the shared dns cache, later clients reuse the first answer
+    std::atomic_int connected_count = 0;
+    std::vector<TcpClientPtr> clients;
+    for (size_t i = 0; i < 4; ++i) {
+        auto client = TcpClient::create(&loop, "localhost:" + port);
+        client->setConnectingTimeout(Duration(1 * Duration::kSecond));
+        client->setConnectionCallback([&](const TcpConnectionPtr &conn) {
+            if (conn->isConnected()) {
+                ASSERT_EQ("localhost:" + port, conn->getRemoteIpPort());
+                if (++connected_count == 4) {
+                    for (auto &c : clients) {
+                        c->disconnect();
+                    }
+                    server.stop();
+                }
+            }
+        });
+        client->connect();
+        clients.push_back(std::move(client));
+    }
+
+    loop.runAfterTimer(Duration(3 * Duration::kSecond), [&](EventLoop *) {
+        for (auto &client : clients) {
+            client->disconnect();
+        }
+        server.stop();
+    });
+    loop.run();
+    ASSERT_EQ(4, connected_count);
+}
+
+TEST(SERVER_CLIENT_TEST, FAST_OPEN_CONN_TEST) {
+    EventLoop loop;
+    TcpServer server(&loop, "tcp://127.0.0.1:0", 1, "echo");
+    server.setMessageCallback([](const TcpConnectionPtr &conn, Buffer *buf) {
+        conn->send(buf->nextAllString());
+    });
+    server.setClosedCallback([&]() {
+        loop.stop();
+    });
+    ASSERT_TRUE(server.start());
+    std::string address = *server.getRealListenIpPorts().begin();
+
+    // Without a cookie (or kernel support) fast open falls back to a plain handshake, data still flows
+    std::string received;
+    auto client = TcpClient::create(&loop, address);
+    client->setFastOpen(true);
+    client->setConnectionCallback([](const TcpConnectionPtr &conn) {
+        if (conn->isConnected()) {
+            conn->send("hello");
+        }
+    });
+    client->setMessageCallback([&](const TcpConnectionPtr &conn, Buffer *buf) {
+        received += buf->nextAllString();
+        if (received.size() >= 5) {
+            client->disconnect();
+            server.stop();
+        }
+    });
+    client->connect();
+
+    loop.runAfterTimer(Duration(3 * Duration::kSecond), [&](EventLoop *) {
+        client->disconnect();
+        server.stop();
+    });
+    loop.run();
+    ASSERT_EQ("hello", received);
+}
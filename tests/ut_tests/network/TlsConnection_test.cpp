@@ -0,0 +1,170 @@
+/*
+ *  Copyright (c) 2023 Tair
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ */
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <unistd.h>
+
+#include "network/EventLoop.hpp"
+#include "network/TcpClient.hpp"
+#include "network/TcpConnection.hpp"
+#include "network/TcpServer.hpp"
+#include "network/TlsConnection.hpp"
+#include "network/TlsOptions.hpp"
+
+#include <openssl/evp.h>
+#include <openssl/pem.h>
+#include <openssl/rsa.h>
+#include <openssl/x509.h>
+
+using tair::network::Duration;
+using tair::network::EventLoop;
+using tair::network::TcpServer;
+using tair::network::TcpClient;
+using tair::network::TcpClientPtr;
+using tair::network::TcpConnectionPtr;
+using tair::network::TlsConfig;
+using tair::network::TlsConnection;
+using tair::network::TlsClientContext;
+using tair::network::TlsOptions;
+using tair::network::Buffer;
+
+// Writes a self-signed certificate for CN=localhost and its key as PEM files
+static bool writeSelfSignedCert(const std::string &cert_file, const std::string &key_file) {
+    EVP_PKEY *pkey = nullptr;
+    EVP_PKEY_CTX *pctx = EVP_PKEY_CTX_new_id(EVP_PKEY_RSA, nullptr);
+    bool ok = pctx && EVP_PKEY_keygen_init(pctx) > 0 && EVP_PKEY_CTX_set_rsa_keygen_bits(pctx, 2048) > 0 && EVP_PKEY_keygen(pctx, &pkey) > 0;
+    EVP_PKEY_CTX_free(pctx);
+    if (!ok) {
+        return false;
+    }
+    X509 *x509 = X509_new();
+    ASN1_INTEGER_set(X509_get_serialNumber(x509), 1);
+    X509_gmtime_adj(X509_get_notBefore(x509), 0);
+    X509_gmtime_adj(X509_get_notAfter(x509), 24 * 3600);
+    X509_set_pubkey(x509, pkey);
+    X509_NAME *name = X509_get_subject_name(x509);
+    X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC, (const unsigned char *)"localhost", -1, -1, 0);
+    X509_set_issuer_name(x509, name);
+    ok = X509_sign(x509, pkey, EVP_sha256()) > 0;
+
+    FILE *cert_fp = fopen(cert_file.data(), "w");
+    FILE *key_fp = fopen(key_file.data(), "w");
+    ok = ok && cert_fp && key_fp && PEM_write_X509(cert_fp, x509) && PEM_write_PrivateKey(key_fp, pkey, nullptr, nullptr, 0, nullptr, nullptr);
+    if (cert_fp) fclose(cert_fp);
+    if (key_fp) fclose(key_fp);
+    X509_free(x509);
+    EVP_PKEY_free(pkey);
+    return ok;
+}
+
+TEST(TLS_CONNECTION_TEST, ECHO_AND_RESUME_TEST) {
+    auto dir = std::filesystem::temp_directory_path() / ("tair_tls_test_" + std::to_string(getpid()));
+    std::filesystem::create_directories(dir);
+    std::string cert_file = dir / "cert.pem";
+    std::string key_file = dir / "key.pem";
+    ASSERT_TRUE(writeSelfSignedCert(cert_file, key_file));
+
+    TlsConfig server_config{};
+    server_config.tls_cert_file = cert_file;
+    server_config.tls_key_file = key_file;
+    server_config.tls_session_caching = true;
+    server_config.tls_session_cache_size = 128;
+    server_config.tls_session_cache_timeout = 300;
+    ASSERT_TRUE(TlsOptions::instance().configure(server_config));
+
+    TlsConfig client_config{};
+    client_config.tls_ca_file = cert_file;
+    client_config.tls_verify_peer = true;
+    client_config.tls_server_name = "localhost";
+    client_config.tls_session_caching = true;
+    client_config.tls_session_cache_size = 16;
+    client_config.tls_session_cache_timeout = 300;
+    client_config.tls_ktls = true; // falls back to user space when the kernel lacks tls
+    auto client_context = TlsClientContext::create(client_config);
+    ASSERT_TRUE(client_context);
+    auto other_context = TlsClientContext::create(client_config);
+    ASSERT_TRUE(other_context);
+
+    EventLoop loop;
+    TcpServer server(&loop, "tls://127.0.0.1:0", 1, "tls-echo");
+    server.setMessageCallback([](const TcpConnectionPtr &conn, Buffer *buf) {
+        conn->send(buf->nextAllString());
+    });
+    server.setClosedCallback([&]() {
+        loop.stop();
+    });
+    ASSERT_TRUE(server.start());
+    std::string address = "tls://" + *server.getRealListenIpPorts().begin();
+
+    std::string value(256 * 1024, 'v');
+    std::vector<bool> reused;
+    std::vector<TcpClientPtr> clients;
+    std::function<void()> start_client = [&]() {
+        auto client = TcpClient::create(&loop, address);
+        // The last connection belongs to another client, which has no session to resume
+        client->setTlsContext(reused.size() < 2 ? client_context : other_context);
+        auto received = std::make_shared<std::string>();
+        client->setConnectionCallback([&](const TcpConnectionPtr &conn) {
+            if (conn->isConnected()) {
+                conn->send(value);
+            }
+        });
+        client->setMessageCallback([&, received, client = client.get()](const TcpConnectionPtr &conn, Buffer *buf) {
+            received->append(buf->nextAllString());
+            if (received->size() < value.size()) {
+                return;
+            }
+            ASSERT_EQ(value, *received);
+            reused.push_back(std::dynamic_pointer_cast<TlsConnection>(conn)->isSessionReused());
+            client->disconnect();
+            if (reused.size() < 3) {
+                start_client();
+            } else {
+                server.stop();
+            }
+        });
+        client->connect();
+        clients.push_back(std::move(client));
+    };
+    start_client();
+
+    loop.runAfterTimer(Duration(10 * Duration::kSecond), [&](EventLoop *) {
+        for (auto &client : clients) {
+            client->disconnect();
+        }
+        server.stop();
+    });
+    loop.run();
+
+    // The second connection resumes the session cached by the first one
+    ASSERT_EQ(3, reused.size());
+    ASSERT_FALSE(reused[0]);
+    ASSERT_TRUE(reused[1]);
+    ASSERT_FALSE(reused[2]);
+    ASSERT_EQ(1, client_context->getSessionCount());
+    ASSERT_EQ(1, other_context->getSessionCount());
+
+    TlsOptions::instance().clear();
+    std::filesystem::remove_all(dir);
+}
@@ -205,3 +205,47 @@ TEST(BULK_STRING_PACKET_TEST, DECODE3_TEST) {
     ASSERT_EQ("REDISREDIS", bulkString10.getValue());
     ASSERT_EQ(17, bulkString10.getRESP2EncodeSize());
 }
+
+TEST(BULK_STRING_PACKET_TEST, DECODE_TO_SINK_TEST) {
+    std::string received;
+    size_t chunks = 0;
+    BulkStringPacket packet;
+    packet.setDecodeSink([&](const char *data, size_t len) {
+        received.append(data, len);
+        chunks++;
+        return true;
+    });
+
+    Buffer buf;
+    buf.append("$10\r\nhello");
+    ASSERT_EQ(DState::AGAIN, packet.decodeRESP2(&buf));
+    ASSERT_EQ(0U, buf.length());
+    ASSERT_EQ(0U, packet.getDecodeExpectedBytes());
+    buf.append("world\r");
+    ASSERT_EQ(DState::AGAIN, packet.decodeRESP2(&buf));
+    ASSERT_EQ(1U, buf.length());
+    buf.append("\n");
+    ASSERT_EQ(DState::SUCCESS, packet.decodeRESP2(&buf));
+    ASSERT_EQ(0U, buf.length());
+    ASSERT_EQ("helloworld", received);
+    ASSERT_EQ(2U, chunks);
+    ASSERT_EQ(10U, packet.getStreamedLength());
+    ASSERT_TRUE(packet.getValue().empty());
+    ASSERT_FALSE(packet.isSinkAborted());
+
+    // The remaining body is still consumed after the sink gives up
+    BulkStringPacket aborted;
+    aborted.setDecodeSink([](const char *, size_t) { return false; });
+    buf.append("$3\r\nab");
+    ASSERT_EQ(DState::AGAIN, aborted.decodeRESP2(&buf));
+    buf.append("c\r\n+OK\r\n");
+    ASSERT_EQ(DState::SUCCESS, aborted.decodeRESP2(&buf));
+    ASSERT_TRUE(aborted.isSinkAborted());
+    ASSERT_EQ("+OK\r\n", buf.nextAllString());
+
+    BulkStringPacket null_packet;
+    null_packet.setDecodeSink([](const char *, size_t) { return true; });
+    buf.append("$-1\r\n");
+    ASSERT_EQ(DState::SUCCESS, null_packet.decodeRESP2(&buf));
+    ASSERT_EQ(PacketType::TYPE_NULL, null_packet.getType());
+}
@@ -38,6 +38,8 @@ using tair::protocol::ArrayPacket;
 using tair::protocol::BulkStringPacket;
 using tair::protocol::SimpleStringPacket;
 using tair::protocol::MapPacket;
+using tair::protocol::PacketPtr;
+using tair::network::OutputChain;
 
 TEST(RESP2_CODEC_TEST, CODEC_VERSION_TEST) {
     auto codec = CodecFactory::getCodec(CodecType::RESP2);
@@ -387,3 +389,83 @@ TEST(RESP2_CODEC_TEST, MULTI_DECODE_RESP_TEST) {
     ASSERT_EQ("key", argv[1]);
     ASSERT_EQ(value, argv[2]);
 }
+
+TEST(RESP2_CODEC_TEST, EXPECTED_BYTES_TEST) {
+    PacketUniqPtr packet;
+    Buffer buf;
+
+    RESP2Codec codec0;
+    buf.append("$5\r\nva");
+    ASSERT_EQ(DState::AGAIN, codec0.decodeResponse(&buf, packet));
+    ASSERT_EQ(7U, codec0.getExpectedBytes());
+    ASSERT_EQ(2U, buf.length());
+    buf.append("lue\r\n");
+    ASSERT_EQ(DState::SUCCESS, codec0.decodeResponse(&buf, packet));
+    ASSERT_EQ(0U, codec0.getExpectedBytes());
+
+    RESP2Codec codec1;
+    buf.clear();
+    buf.append("*2\r\n$3\r\nkey\r\n$65535\r\n");
+    ASSERT_EQ(DState::AGAIN, codec1.decodeResponse(&buf, packet));
+    ASSERT_EQ(65537U, codec1.getExpectedBytes());
+    buf.append(std::string(65535, 'a'));
+    ASSERT_EQ(DState::AGAIN, codec1.decodeResponse(&buf, packet));
+    ASSERT_EQ(65537U, codec1.getExpectedBytes());
+    buf.append("\r\n");
+    ASSERT_EQ(DState::SUCCESS, codec1.decodeResponse(&buf, packet));
+    ASSERT_EQ(0U, codec1.getExpectedBytes());
+
+    // Length not known yet
+    RESP2Codec codec2;
+    buf.clear();
+    buf.append("*2\r\n$3");
+    ASSERT_EQ(DState::AGAIN, codec2.decodeResponse(&buf, packet));
+    ASSERT_EQ(0U, codec2.getExpectedBytes());
+}
+
+TEST(RESP2_CODEC_TEST, ENCODE_TO_CHAIN_TEST) {
+    RESP2Codec codec;
+    std::string value(1024 * 1024, 'v');
+
+    PacketPtr small = std::make_shared<ArrayPacket>(std::vector<std::string> {"set", "key", "value"});
+    ASSERT_FALSE(codec.hasLargePayload(small.get()));
+
+    PacketPtr large = std::make_shared<ArrayPacket>(std::vector<std::string> {"set", "key", value, "ex", "10"});
+    ASSERT_TRUE(codec.hasLargePayload(large.get()));
+
+    for (auto &packet : {small, large}) {
+        Buffer buf;
+        codec.encodeRequest(&buf, packet.get());
+        OutputChain chain;
+        ASSERT_EQ(DState::SUCCESS, codec.encodeRequestToChain(&chain, packet));
+        ASSERT_EQ(buf.nextAllString(), chain.toString());
+    }
+    // Header, referenced value, trailer
+    OutputChain chain;
+    codec.encodeRequestToChain(&chain, large);
+    ASSERT_EQ(3U, chain.segmentCount());
+}
+
+TEST(RESP2_CODEC_TEST, ENCODE_SHARED_VALUE_TEST) {
+    RESP2Codec codec;
+    auto value = std::make_shared<const std::string>(1024 * 1024, 'v');
+
+    auto array = std::make_shared<ArrayPacket>();
+    array->addReplyBulk("set");
+    array->addReplyBulk("key");
+    array->addReplyBulk(value);
+    ASSERT_EQ(value->data(), array->getPacketArray()[2]->packet_cast<BulkStringPacket>()->getValue().data());
+
+    Buffer buf;
+    codec.encodeRequest(&buf, array.get());
+    ASSERT_EQ(buf.size(), array->getRESP2EncodeSize());
+    OutputChain chain;
+    ASSERT_EQ(DState::SUCCESS, codec.encodeRequestToChain(&chain, array));
+    ASSERT_EQ(buf.nextAllString(), chain.toString());
+
+    // The middle segment points into the caller's value, no copy is made
+    struct iovec iov[3];
+    ASSERT_EQ(3, chain.fillIovec(iov, 3));
+    ASSERT_EQ(value->data(), iov[1].iov_base);
+    ASSERT_EQ(value->size(), iov[1].iov_len);
+}